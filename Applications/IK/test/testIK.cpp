@@ -89,6 +89,27 @@ int main()
         failures.push_back("testInverseKinematicsGait2354");
     }
 
+    try {
+        // Solving blocks of frames on separate threads must reproduce the
+        // sequential solution (written by the test above).
+        InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+        Storage serial(ik.getOutputMotionFileName());
+        ik.setName(ik.getName() + "_parallel");
+        ik.setOutputMotionFileName("subject01_walk1_ik_parallel.mot");
+        ik.setNumThreads(4);
+        ik.run();
+        Storage parallel(ik.getOutputMotionFileName());
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+            std::vector<double>(24, 0.01), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 with multiple threads failed");
+        cout << "testInverseKinematicsGait2354 with multiple threads passed"
+             << endl;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsGait2354_parallel");
+    }
+
     try {
         InverseKinematicsTool ik2("subject01_Setup_InverseKinematics_NoModel.xml");
         Model mdl("subject01_simbody.osim");
@@ -0,0 +1,330 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-cmd_run-batch.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_RUN_BATCH[] =
+R"(Run many tools from XML setup files, several at a time.
+
+Usage:
+  opensim-cmd [options]... run-batch [<setup-xml-file>...]
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -m <file>, --manifest <file>  Read setup files from a manifest.
+  -j <n>, --jobs <n>  Number of setup files to run at a time.
+  -t <n>, --job-threads <n>  Maximum number of threads per job.
+  -d <dir>, --log-dir <dir>  Directory for the output of each job.
+  -r <file>, --report <file>  Write a CSV report of the jobs.
+
+Description:
+  Each setup file is run by its own `opensim-cmd run-tool` process, so any
+  tool supported by run-tool (including tools from plugins loaded with
+  --library) can be run, and a job that fails or crashes does not affect the
+  others. The jobs are started in the order given, and at most --jobs of them
+  run at a time (default: the number of hardware threads).
+
+  The setup files are the <setup-xml-file> arguments followed by the entries
+  of the --manifest. A manifest is a text file with one setup file per line;
+  empty lines and lines starting with '#' are ignored, and relative paths are
+  relative to the directory of the manifest. Each job runs in the current
+  directory, as run-tool would.
+
+  --job-threads sets the environment variable OPENSIM_MAX_THREADS of the
+  jobs, which limits the threads used by the tools that run on multiple
+  threads (e.g., num_threads of InverseKinematicsTool and ForsimEnsembleTool),
+  whatever the setup files request. It also sets OPENSIM_MOCO_PARALLEL,
+  which limits the threads used by MocoCasADiSolver (unless the setup file
+  sets its parallel property).
+
+  The console output of each job is written to
+  <log-dir>/<job number>_<setup file name>.log (default <log-dir>:
+  run-batch_logs). The start, result and duration of each job are reported
+  as the jobs finish, followed by a summary of all jobs. --report also writes
+  this summary to a CSV file. The command succeeds if all jobs succeed.
+
+Examples:
+  opensim-cmd run-batch -j 4 subject01_ik.xml subject02_ik.xml
+  opensim-cmd run-batch --jobs=8 --job-threads=2 --manifest=comak_jobs.txt
+  opensim-cmd -L ../plugins/libosimMyPlugin.so run-batch -m jobs.txt -r jobs.csv
+)";
+
+namespace OpenSim {
+
+struct BatchJob {
+    std::string setupFile;
+    std::string logFile;
+    int exitCode = -1;
+    double wallTime = 0;
+};
+
+// Append the setup files listed in a manifest to the list of jobs.
+inline void readBatchManifest(const std::string& manifest,
+        std::vector<BatchJob>& jobs) {
+    std::ifstream in(manifest);
+    OPENSIM_THROW_IF(!in, Exception,
+            "Could not open manifest '{}'.", manifest);
+    const std::string manifestDir = IO::getParentDirectory(manifest);
+    std::string line;
+    while (std::getline(in, line)) {
+        IO::TrimWhitespace(line);
+        if (line.empty() || line[0] == '#') continue;
+        bool isAbsolute;
+        std::string directory, fileName, extension;
+        SimTK::Pathname::deconstructPathname(
+                line, isAbsolute, directory, fileName, extension);
+        BatchJob job;
+        job.setupFile = isAbsolute ? line : manifestDir + line;
+        jobs.push_back(job);
+    }
+}
+
+// Quote an argument so that the shell used by std::system() passes it to the
+// job unchanged.
+inline std::string quoteBatchArgument(const std::string& argument) {
+#ifdef _WIN32
+    // Backslashes are literal unless they precede a quote, in which case they
+    // (and the quote) must be escaped.
+    std::string quoted = "\"";
+    int numBackslashes = 0;
+    for (const char c : argument) {
+        if (c == '\\') {
+            ++numBackslashes;
+            continue;
+        }
+        if (c == '"') quoted.append(2 * numBackslashes + 1, '\\');
+        else quoted.append(numBackslashes, '\\');
+        numBackslashes = 0;
+        quoted += c;
+    }
+    quoted.append(2 * numBackslashes, '\\');
+    return quoted + "\"";
+#else
+    // Nothing is special within single quotes, so only the single quotes
+    // themselves need escaping.
+    std::string quoted = "'";
+    for (const char c : argument) {
+        if (c == '\'') quoted += "'\\''";
+        else quoted += c;
+    }
+    return quoted + "'";
+#endif
+}
+
+// Parse the value of a count option (e.g., --jobs), which must be a positive
+// integer.
+inline int parseBatchCount(
+        const std::string& option, const std::string& value) {
+    std::size_t numParsed = 0;
+    int count = 0;
+    try {
+        count = std::stoi(value, &numParsed);
+    } catch (const std::exception&) {
+        numParsed = 0;
+    }
+    OPENSIM_THROW_IF(numParsed == 0 || numParsed != value.size() || count < 1,
+            Exception,
+            "Invalid value for {}: '{}'; expected a positive integer.",
+            option, value);
+    return count;
+}
+
+// Quote a field of the CSV report, doubling any quotes within it.
+inline std::string quoteCSVField(const std::string& field) {
+    std::string quoted = "\"";
+    for (const char c : field) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+inline void setBatchEnvironmentVariable(
+        const std::string& name, const std::string& value) {
+#ifdef _WIN32
+    _putenv_s(name.c_str(), value.c_str());
+#else
+    setenv(name.c_str(), value.c_str(), 1);
+#endif
+}
+
+// Run a command with std::system() and return its exit code.
+inline int runBatchCommand(std::string command) {
+#ifdef _WIN32
+    // cmd.exe strips the first and last quote of the command line.
+    command = "\"" + command + "\"";
+    return std::system(command.c_str());
+#else
+    const int status = std::system(command.c_str());
+    if (status != -1 && WIFEXITED(status)) return WEXITSTATUS(status);
+    return status == 0 ? EXIT_FAILURE : status;
+#endif
+}
+
+} // namespace OpenSim
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    // Collect the jobs.
+    // -----------------
+    std::vector<BatchJob> jobs;
+    if (args["<setup-xml-file>"]) {
+        for (const auto& setupFile : args["<setup-xml-file>"].asStringList()) {
+            BatchJob job;
+            job.setupFile = setupFile;
+            jobs.push_back(job);
+        }
+    }
+    if (args["--manifest"]) {
+        readBatchManifest(args["--manifest"].asString(), jobs);
+    }
+    if (jobs.empty()) {
+        log_error("No setup files were provided.");
+        return EXIT_FAILURE;
+    }
+
+    int numWorkers = std::max(1, (int)std::thread::hardware_concurrency());
+    if (args["--jobs"]) {
+        numWorkers = parseBatchCount("--jobs", args["--jobs"].asString());
+    }
+    numWorkers = std::min(numWorkers, (int)jobs.size());
+
+    if (args["--job-threads"]) {
+        const int jobThreads = parseBatchCount(
+                "--job-threads", args["--job-threads"].asString());
+        setBatchEnvironmentVariable(
+                "OPENSIM_MAX_THREADS", std::to_string(jobThreads));
+        // For Moco, 1 means all cores and 0 means in series.
+        setBatchEnvironmentVariable("OPENSIM_MOCO_PARALLEL",
+                jobThreads == 1 ? "0" : std::to_string(jobThreads));
+    }
+
+    std::string logDir = "run-batch_logs";
+    if (args["--log-dir"]) logDir = args["--log-dir"].asString();
+    IO::makeDir(logDir);
+
+    // Each job runs this executable, with the same plugins and log level.
+    std::string prefix = quoteBatchArgument(argv[0]);
+    if (args["--library"]) {
+        for (const auto& plugin : args["--library"].asStringList()) {
+            prefix += " --library=" + quoteBatchArgument(plugin);
+        }
+    }
+    if (args["--log"]) {
+        prefix += " --log=" + quoteBatchArgument(args["--log"].asString());
+    }
+    prefix += " run-tool ";
+
+    const int numJobs = (int)jobs.size();
+    for (int i = 0; i < numJobs; ++i) {
+        bool isAbsolute;
+        std::string directory, fileName, extension;
+        SimTK::Pathname::deconstructPathname(jobs[i].setupFile, isAbsolute,
+                directory, fileName, extension);
+        jobs[i].logFile = logDir + "/" + std::to_string(i + 1) + "_" +
+                fileName + ".log";
+    }
+
+    // Run the jobs.
+    // -------------
+    log_info("Running {} jobs, {} at a time.", numJobs, numWorkers);
+    Stopwatch batchWatch;
+    std::atomic<int> nextJob(0);
+    auto worker = [&]() {
+        for (int i = nextJob++; i < numJobs; i = nextJob++) {
+            BatchJob& job = jobs[i];
+            log_info("[{}/{}] Started '{}'.", i + 1, numJobs, job.setupFile);
+            Stopwatch watch;
+            job.exitCode = runBatchCommand(prefix +
+                    quoteBatchArgument(job.setupFile) + " > " +
+                    quoteBatchArgument(job.logFile) + " 2>&1");
+            job.wallTime = watch.getElapsedTime();
+            if (job.exitCode == EXIT_SUCCESS) {
+                log_info("[{}/{}] Finished '{}' in {}.", i + 1, numJobs,
+                        job.setupFile, watch.getElapsedTimeFormatted());
+            } else {
+                log_error("[{}/{}] '{}' failed with exit code {} after {}; "
+                          "see '{}'.", i + 1, numJobs, job.setupFile,
+                        job.exitCode, watch.getElapsedTimeFormatted(),
+                        job.logFile);
+            }
+        }
+    };
+    std::vector<std::future<void>> workers;
+    for (int w = 0; w < numWorkers; ++w) {
+        workers.push_back(std::async(std::launch::async, worker));
+    }
+    for (auto& w : workers) w.get();
+
+    // Report.
+    // -------
+    int numFailed = 0;
+    log_cout("{:>5}  {:<8} {:>12}  {}", "job", "status", "wall time (s)",
+            "setup file");
+    for (int i = 0; i < numJobs; ++i) {
+        const bool success = jobs[i].exitCode == EXIT_SUCCESS;
+        if (!success) ++numFailed;
+        log_cout("{:>5}  {:<8} {:>12.2f}  {}", i + 1,
+                success ? "success" : "failure", jobs[i].wallTime,
+                jobs[i].setupFile);
+    }
+    log_info("{} of {} jobs succeeded in {}.", numJobs - numFailed, numJobs,
+            batchWatch.getElapsedTimeFormatted());
+
+    if (args["--report"]) {
+        std::ofstream report(args["--report"].asString());
+        report << "job,setup_file,status,exit_code,wall_time,log_file\n";
+        for (int i = 0; i < numJobs; ++i) {
+            report << i + 1 << "," << quoteCSVField(jobs[i].setupFile) << ","
+                   << (jobs[i].exitCode == EXIT_SUCCESS ? "success"
+                                                        : "failure")
+                   << "," << jobs[i].exitCode << "," << jobs[i].wallTime
+                   << "," << quoteCSVField(jobs[i].logFile) << "\n";
+        }
+    }
+
+    return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
@@ -23,9 +23,11 @@
 
 #include <SimTKcommon/Testing.h>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <regex>
+#include <sstream>
 // We do *not* include OpenSim headers, since we are only interacting with
 // OpenSim through its command-line interface. But we do use Simbody's testing
 // macros.
@@ -349,6 +351,72 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run many tools ");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            ContainsSubstring("No setup files were provided."));
+    testCommand("run-batch --manifest=putes.txt", EXIT_FAILURE,
+            ContainsSubstring("Could not open manifest 'putes.txt'."));
+    testCommand("run-batch --jobs=0 x.xml", EXIT_FAILURE,
+            ContainsSubstring("Invalid value for --jobs: '0'; "
+                              "expected a positive integer."));
+    testCommand("run-batch --jobs=two x.xml", EXIT_FAILURE,
+            ContainsSubstring("Invalid value for --jobs: 'two'; "
+                              "expected a positive integer."));
+    testCommand("run-batch --job-threads=2x x.xml", EXIT_FAILURE,
+            ContainsSubstring("Invalid value for --job-threads: '2x'; "
+                              "expected a positive integer."));
+
+    // Jobs that fail are reported, and do not stop the other jobs.
+    // ============================================================
+    testCommand("print-xml Model testrunbatch_Model.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testrunbatch_Model.xml'.\n"));
+    {
+        std::ofstream manifest("testrunbatch_manifest.txt");
+        manifest << "# Not a tool.\n"
+                 << "testrunbatch_Model.xml\n"
+                 << "\n"
+                 << "putes.xml\n";
+    }
+    testCommand("run-batch --jobs=2 --log-dir=testrunbatch_logs "
+                "--manifest=testrunbatch_manifest.txt "
+                "--report=testrunbatch_report.csv",
+            EXIT_FAILURE,
+            std::regex(RE_ANY + "(Running 2 jobs, 2 at a time.)" + RE_ANY +
+                       "(0 of 2 jobs succeeded)" + RE_ANY));
+    {
+        std::ifstream log("testrunbatch_logs/1_testrunbatch_Model.log");
+        std::stringstream contents;
+        contents << log.rdbuf();
+        SimTK_TEST(contents.str().find("does not define an OpenSim Tool") !=
+                   std::string::npos);
+    }
+    {
+        // The file names in the report are quoted.
+        std::ifstream report("testrunbatch_report.csv");
+        std::stringstream contents;
+        contents << report.rdbuf();
+        SimTK_TEST(contents.str().find(
+                "testrunbatch_Model.xml\",failure,") != std::string::npos);
+        SimTK_TEST(contents.str().find(
+                ",\"testrunbatch_logs/1_testrunbatch_Model.log\"") !=
+                   std::string::npos);
+    }
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("run-batch");
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -494,6 +562,7 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
@@ -16,6 +16,7 @@
 #include <OpenSim/JAM/COMAKSettingsSet.h>
 #include <OpenSim/JAM/COMAKTool.h>
 #include <OpenSim/JAM/ForsimTool.h>
+#include <OpenSim/JAM/ForsimEnsembleTool.h>
 
 #include <OpenSim/JAM/JointMechanicsTool.h>
 
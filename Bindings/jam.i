@@ -31,6 +31,7 @@ namespace OpenSim {
 //%include <OpenSim/JAM/COMAKTarget.h>
 %include <OpenSim/JAM/COMAKTool.h>
 %include <OpenSim/JAM/ForsimTool.h>
+%include <OpenSim/JAM/ForsimEnsembleTool.h>
 %include <OpenSim/JAM/JointMechanicsTool.h>
 
 
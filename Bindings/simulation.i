@@ -131,6 +131,7 @@ namespace OpenSim {
 }
 %include <OpenSim/Simulation/Model/Smith2018ContactMesh.h>
 %include <OpenSim/Simulation/Model/Smith2018ArticularContactForce.h>
+%include <OpenSim/Simulation/Model/SmoothMeshContactForce.h>
 
 %include <OpenSim/Simulation/Model/Actuator.h>
 %template(SetActuators) OpenSim::Set<OpenSim::Actuator, OpenSim::Object>;
@@ -87,9 +87,27 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if (m_tabulationTolerance > 0) {
+        m_curve.tabulate(m_tabulationTolerance);
+    }
     setObjectIsUpToDateWithProperties();
 }
 
+void ActiveForceLengthCurve::setTabulationTolerance(double tolerance)
+{
+    // The table, if any, was built with this tolerance.
+    if (tolerance == m_tabulationTolerance) return;
+    m_tabulationTolerance = tolerance;
+    // Otherwise, the table is built with the curve.
+    if (isObjectUpToDateWithProperties()) {
+        if (tolerance > 0) {
+            m_curve.tabulate(tolerance);
+        } else {
+            m_curve.clearTabulation();
+        }
+    }
+}
+
 void ActiveForceLengthCurve::ensureCurveUpToDate()
 {
     if(!isObjectUpToDateWithProperties()) {
@@ -23,6 +23,7 @@
 
 #include "DeGrooteFregly2016Muscle.h"
 
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBatch.h>
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 #include <OpenSim/Common/CommonUtilities.h>
@@ -155,6 +156,19 @@ void DeGrooteFregly2016Muscle::extendFinalizeFromProperties() {
     m_isTendonDynamicsExplicit = get_tendon_compliance_dynamics_mode() == "explicit";
 }
 
+void DeGrooteFregly2016Muscle::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+    // Muscles with a compliant tendon are not part of the batch.
+    m_batch.reset();
+    if (get_ignore_tendon_compliance()) {
+        for (const auto& batch :
+                model.getComponentList<DeGrooteFregly2016MuscleBatch>()) {
+            m_batch.reset(&batch);
+            break;
+        }
+    }
+}
+
 void DeGrooteFregly2016Muscle::extendAddToSystem(
         SimTK::MultibodySystem& system) const {
     Super::extendAddToSystem(system);
@@ -461,6 +475,15 @@ void DeGrooteFregly2016Muscle::calcMusclePotentialEnergyInfoHelper(
 void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
         const SimTK::State& s, MuscleLengthInfo& mli) const {
 
+    if (m_batch) {
+        // The batch computes the info of all of its muscles, including this
+        // one, and stores it in their cache.
+        m_batch->computeMuscleLengthInfo(s);
+        const auto& cached = updMuscleLengthInfo(s);
+        if (&mli != &cached) mli = cached;
+        return;
+    }
+
     const auto& muscleTendonLength = getLength(s);
     SimTK::Real normTendonForce = SimTK::NaN;
     if (!get_ignore_tendon_compliance()) {
@@ -481,6 +504,13 @@ void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
 void DeGrooteFregly2016Muscle::calcFiberVelocityInfo(
         const SimTK::State& s, FiberVelocityInfo& fvi) const {
 
+    if (m_batch) {
+        m_batch->computeFiberVelocityInfo(s);
+        const auto& cached = updFiberVelocityInfo(s);
+        if (&fvi != &cached) fvi = cached;
+        return;
+    }
+
     const auto& mli = getMuscleLengthInfo(s);
     const auto& muscleTendonVelocity = getLengtheningSpeed(s);
     const auto& activation = getActivation(s);
@@ -508,6 +538,13 @@ void DeGrooteFregly2016Muscle::calcFiberVelocityInfo(
 
 void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfo(
         const SimTK::State& s, MuscleDynamicsInfo& mdi) const {
+    if (m_batch) {
+        m_batch->computeMuscleDynamicsInfo(s);
+        const auto& cached = updMuscleDynamicsInfo(s);
+        if (&mdi != &cached) mdi = cached;
+        return;
+    }
+
     const auto& activation = getActivation(s);
     SimTK::Real normTendonForce = SimTK::NaN;
     if (!get_ignore_tendon_compliance()) {
@@ -31,6 +31,8 @@
 
 namespace OpenSim {
 
+class DeGrooteFregly2016MuscleBatch;
+
 // TODO avoid checking ignore_tendon_compliance() in each function;
 //       might be slow.
 // TODO prohibit fiber length from going below 0.2.
@@ -183,6 +185,7 @@ protected:
     /// @name Component interface
     /// @{
     void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendSetPropertiesFromState(const SimTK::State& s) override;
@@ -990,6 +993,9 @@ private:
     // Computed from properties.
     // -------------------------
     bool m_isTendonDynamicsExplicit = true;
+    // The batch that computes the infos of this muscle, if any (see
+    // DeGrooteFregly2016MuscleBatch).
+    SimTK::ReferencePtr<const DeGrooteFregly2016MuscleBatch> m_batch;
 
     // Indices for MuscleDynamicsInfo::userDefinedDynamicsExtras.
     constexpr static int m_mdi_passiveFiberElasticForce = 0;
@@ -998,6 +1004,8 @@ private:
     constexpr static int m_mdi_partialFiberForceAlongTendonPartialFiberLength =
             3;
     constexpr static int m_mdi_partialTendonForcePartialFiberLength = 4;
+
+    friend class DeGrooteFregly2016MuscleBatch;
 };
 
 } // namespace OpenSim
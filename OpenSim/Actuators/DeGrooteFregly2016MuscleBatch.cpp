@@ -0,0 +1,389 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  DeGrooteFregly2016MuscleBatch.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016MuscleBatch.h"
+
+#include "DeGrooteFregly2016Muscle.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+using DGF = DeGrooteFregly2016Muscle;
+
+// Each computation below gathers its inputs from the muscles, evaluates the
+// curves in loops over contiguous arrays (one entry per muscle), and then
+// scatters the results to the cache of each muscle. The expressions are
+// those of the rigid-tendon branches of the helpers in
+// DeGrooteFregly2016Muscle.cpp, and must be kept consistent with them.
+
+void DeGrooteFregly2016MuscleBatch::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    for (const auto& other :
+            model.getComponentList<DeGrooteFregly2016MuscleBatch>()) {
+        OPENSIM_THROW_IF_FRMOBJ(&other != this, Exception,
+                "Expected at most one DeGrooteFregly2016MuscleBatch in the "
+                "model, but also found '{}'.",
+                other.getAbsolutePathString());
+    }
+
+    m_muscles.clear();
+    for (const auto& muscle : model.getComponentList<DGF>()) {
+        if (muscle.get_ignore_tendon_compliance()) {
+            m_muscles.emplace_back(&muscle);
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleBatch::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    Workspace workspace;
+    workspace.resize(getNumMuscles());
+    this->m_workspaceCV = addCacheVariable(
+            "workspace", workspace, SimTK::Stage::Position);
+}
+
+void DeGrooteFregly2016MuscleBatch::Workspace::resize(int n) {
+    if ((int)maxIsometricForce.size() == n) return;
+    for (auto* v : {&maxIsometricForce, &optimalFiberLength,
+                 &tendonSlackLength, &fiberWidth, &maxContractionVelocity,
+                 &activeForceWidthScale, &passiveFiberStrain,
+                 &passiveForceOffset, &passiveForceDenominator,
+                 &passiveForceScale, &fiberDamping,
+                 &lenMuscleTendonLength, &lenFiberLengthAlongTendon,
+                 &lenFiberLength, &lenNormFiberLength, &lenCosPennationAngle,
+                 &lenSinPennationAngle, &lenActiveMultiplier,
+                 &lenPassiveMultiplier,
+                 &velMuscleTendonVelocity, &velFiberLengthAlongTendon,
+                 &velFiberLength, &velCosPennationAngle, &velFiberVelocity,
+                 &velNormFiberVelocity, &velForceVelocityMultiplier,
+                 &velPennationAngularVelocity,
+                 &dynActivation, &dynFiberLength, &dynNormFiberLength,
+                 &dynCosPennationAngle, &dynSinPennationAngle,
+                 &dynActiveMultiplier, &dynPassiveMultiplier,
+                 &dynForceVelocityMultiplier, &dynNormFiberVelocity,
+                 &dynFiberVelocity, &dynActiveFiberForce,
+                 &dynConPassiveFiberForce, &dynNonConPassiveFiberForce,
+                 &dynTotalFiberForce, &dynFiberStiffness,
+                 &dynPartialPennationAnglePartialFiberLength,
+                 &dynPartialFiberForceAlongTendonPartialFiberLength,
+                 &dynFiberStiffnessAlongTendon,
+                 &dynPartialTendonForcePartialFiberLength}) {
+        v->resize(n);
+    }
+}
+
+DeGrooteFregly2016MuscleBatch::Workspace&
+DeGrooteFregly2016MuscleBatch::updWorkspace(const SimTK::State& s) const {
+    const int n = getNumMuscles();
+    Workspace& ws = updCacheVariableValue(s, m_workspaceCV);
+    ws.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i];
+        const double e0 = muscle.get_passive_fiber_strain_at_one_norm_force();
+        const double offset =
+                exp(DGF::kPE * (DGF::m_minNormFiberLength - 1.0) / e0);
+        ws.maxIsometricForce[i] = muscle.get_max_isometric_force();
+        ws.optimalFiberLength[i] = muscle.get_optimal_fiber_length();
+        ws.tendonSlackLength[i] = muscle.get_tendon_slack_length();
+        ws.fiberWidth[i] = muscle.getFiberWidth();
+        ws.maxContractionVelocity[i] =
+                muscle.getMaxContractionVelocityInMetersPerSecond();
+        ws.activeForceWidthScale[i] = muscle.get_active_force_width_scale();
+        ws.passiveFiberStrain[i] = e0;
+        ws.passiveForceOffset[i] = offset;
+        ws.passiveForceDenominator[i] = exp(DGF::kPE) - offset;
+        ws.passiveForceScale[i] =
+                muscle.get_ignore_passive_fiber_force() ? 0.0 : 1.0;
+        ws.fiberDamping[i] = muscle.get_fiber_damping();
+    }
+    return ws;
+}
+
+void DeGrooteFregly2016MuscleBatch::computeMuscleLengthInfo(
+        const SimTK::State& s) const {
+    using SimTK::square;
+    const int n = getNumMuscles();
+
+    Workspace& ws = updWorkspace(s);
+    auto& muscleTendonLength = ws.lenMuscleTendonLength;
+    auto& fiberLengthAlongTendon = ws.lenFiberLengthAlongTendon;
+    auto& fiberLength = ws.lenFiberLength;
+    auto& normFiberLength = ws.lenNormFiberLength;
+    auto& cosPennationAngle = ws.lenCosPennationAngle;
+    auto& sinPennationAngle = ws.lenSinPennationAngle;
+    auto& activeMultiplier = ws.lenActiveMultiplier;
+    auto& passiveMultiplier = ws.lenPassiveMultiplier;
+
+    for (int i = 0; i < n; ++i) {
+        muscleTendonLength[i] = m_muscles[i]->getLength(s);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        // The tendon length is the tendon slack length.
+        fiberLengthAlongTendon[i] =
+                muscleTendonLength[i] - ws.tendonSlackLength[i];
+        fiberLength[i] = sqrt(square(fiberLengthAlongTendon[i]) +
+                              square(ws.fiberWidth[i]));
+        normFiberLength[i] = fiberLength[i] / ws.optimalFiberLength[i];
+        cosPennationAngle[i] = fiberLengthAlongTendon[i] / fiberLength[i];
+        sinPennationAngle[i] = ws.fiberWidth[i] / fiberLength[i];
+
+        const double x =
+                (normFiberLength[i] - 1.0) / ws.activeForceWidthScale[i] + 1.0;
+        activeMultiplier[i] =
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b13, DGF::b23, DGF::b33, DGF::b43);
+        passiveMultiplier[i] =
+                ws.passiveForceScale[i] *
+                (exp(DGF::kPE * (normFiberLength[i] - 1.0) /
+                         ws.passiveFiberStrain[i]) -
+                        ws.passiveForceOffset[i]) /
+                ws.passiveForceDenominator[i];
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i];
+        auto& mli = muscle.updMuscleLengthInfo(s);
+        mli.normTendonLength = 1.0;
+        mli.tendonStrain = 0.0;
+        mli.tendonLength = ws.tendonSlackLength[i];
+        mli.fiberLengthAlongTendon = fiberLengthAlongTendon[i];
+        mli.fiberLength = fiberLength[i];
+        mli.normFiberLength = normFiberLength[i];
+        mli.cosPennationAngle = cosPennationAngle[i];
+        mli.sinPennationAngle = sinPennationAngle[i];
+        mli.pennationAngle = asin(sinPennationAngle[i]);
+        mli.fiberPassiveForceLengthMultiplier = passiveMultiplier[i];
+        mli.fiberActiveForceLengthMultiplier = activeMultiplier[i];
+        muscle.markCacheVariableValid(s, "lengthInfo");
+    }
+}
+
+void DeGrooteFregly2016MuscleBatch::computeFiberVelocityInfo(
+        const SimTK::State& s) const {
+    const int n = getNumMuscles();
+
+    Workspace& ws = updWorkspace(s);
+    auto& muscleTendonVelocity = ws.velMuscleTendonVelocity;
+    auto& fiberLengthAlongTendon = ws.velFiberLengthAlongTendon;
+    auto& fiberLength = ws.velFiberLength;
+    auto& cosPennationAngle = ws.velCosPennationAngle;
+    auto& fiberVelocity = ws.velFiberVelocity;
+    auto& normFiberVelocity = ws.velNormFiberVelocity;
+    auto& forceVelocityMultiplier = ws.velForceVelocityMultiplier;
+    auto& pennationAngularVelocity = ws.velPennationAngularVelocity;
+
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i];
+        const auto& mli = muscle.getMuscleLengthInfo(s);
+        muscleTendonVelocity[i] = muscle.getLengtheningSpeed(s);
+        fiberLengthAlongTendon[i] = mli.fiberLengthAlongTendon;
+        fiberLength[i] = mli.fiberLength;
+        cosPennationAngle[i] = mli.cosPennationAngle;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        // The tendon velocity is zero.
+        fiberVelocity[i] = muscleTendonVelocity[i] * cosPennationAngle[i];
+        normFiberVelocity[i] = fiberVelocity[i] / ws.maxContractionVelocity[i];
+        forceVelocityMultiplier[i] =
+                DGF::calcForceVelocityMultiplier(normFiberVelocity[i]);
+        const double tanPennationAngle =
+                ws.fiberWidth[i] / fiberLengthAlongTendon[i];
+        pennationAngularVelocity[i] =
+                -fiberVelocity[i] / fiberLength[i] * tanPennationAngle;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i];
+        auto& fvi = muscle.updFiberVelocityInfo(s);
+        fvi.normTendonVelocity = 0.0;
+        fvi.tendonVelocity = 0.0;
+        fvi.fiberVelocityAlongTendon = muscleTendonVelocity[i];
+        fvi.fiberVelocity = fiberVelocity[i];
+        fvi.normFiberVelocity = normFiberVelocity[i];
+        fvi.fiberForceVelocityMultiplier = forceVelocityMultiplier[i];
+        fvi.pennationAngularVelocity = pennationAngularVelocity[i];
+        muscle.markCacheVariableValid(s, "velInfo");
+
+        if (fvi.normFiberVelocity < -1.0) {
+            log_info("DeGrooteFregly2016Muscle '{}' is exceeding maximum "
+                     "contraction velocity at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleBatch::computeMuscleDynamicsInfo(
+        const SimTK::State& s) const {
+    using SimTK::square;
+    const int n = getNumMuscles();
+
+    Workspace& ws = updWorkspace(s);
+    auto& activation = ws.dynActivation;
+    auto& fiberLength = ws.dynFiberLength;
+    auto& normFiberLength = ws.dynNormFiberLength;
+    auto& cosPennationAngle = ws.dynCosPennationAngle;
+    auto& sinPennationAngle = ws.dynSinPennationAngle;
+    auto& activeMultiplier = ws.dynActiveMultiplier;
+    auto& passiveMultiplier = ws.dynPassiveMultiplier;
+    auto& forceVelocityMultiplier = ws.dynForceVelocityMultiplier;
+    auto& normFiberVelocity = ws.dynNormFiberVelocity;
+    auto& fiberVelocity = ws.dynFiberVelocity;
+    auto& activeFiberForce = ws.dynActiveFiberForce;
+    auto& conPassiveFiberForce = ws.dynConPassiveFiberForce;
+    auto& nonConPassiveFiberForce = ws.dynNonConPassiveFiberForce;
+    auto& totalFiberForce = ws.dynTotalFiberForce;
+    auto& fiberStiffness = ws.dynFiberStiffness;
+    auto& partialPennationAnglePartialFiberLength =
+            ws.dynPartialPennationAnglePartialFiberLength;
+    auto& partialFiberForceAlongTendonPartialFiberLength =
+            ws.dynPartialFiberForceAlongTendonPartialFiberLength;
+    auto& fiberStiffnessAlongTendon = ws.dynFiberStiffnessAlongTendon;
+    auto& partialTendonForcePartialFiberLength =
+            ws.dynPartialTendonForcePartialFiberLength;
+
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i];
+        const auto& mli = muscle.getMuscleLengthInfo(s);
+        const auto& fvi = muscle.getFiberVelocityInfo(s);
+        activation[i] = muscle.getActivation(s);
+        fiberLength[i] = mli.fiberLength;
+        normFiberLength[i] = mli.normFiberLength;
+        cosPennationAngle[i] = mli.cosPennationAngle;
+        sinPennationAngle[i] = mli.sinPennationAngle;
+        activeMultiplier[i] = mli.fiberActiveForceLengthMultiplier;
+        passiveMultiplier[i] = mli.fiberPassiveForceLengthMultiplier;
+        forceVelocityMultiplier[i] = fvi.fiberForceVelocityMultiplier;
+        normFiberVelocity[i] = fvi.normFiberVelocity;
+        fiberVelocity[i] = fvi.fiberVelocity;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const double maxIsometricForce = ws.maxIsometricForce[i];
+
+        // Forces.
+        // -------
+        activeFiberForce[i] = maxIsometricForce *
+                              (activation[i] * activeMultiplier[i] *
+                                      forceVelocityMultiplier[i]);
+        conPassiveFiberForce[i] = maxIsometricForce * passiveMultiplier[i];
+        nonConPassiveFiberForce[i] =
+                maxIsometricForce * ws.fiberDamping[i] * normFiberVelocity[i];
+        totalFiberForce[i] = activeFiberForce[i] + conPassiveFiberForce[i] +
+                             nonConPassiveFiberForce[i];
+
+        // Stiffness.
+        // ----------
+        const double scale = ws.activeForceWidthScale[i];
+        const double x = (normFiberLength[i] - 1.0) / scale + 1.0;
+        const double activeMultiplierDerivative =
+                (1.0 / scale) *
+                (DGF::calcGaussianLikeCurveDerivative(
+                         x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                        DGF::calcGaussianLikeCurveDerivative(
+                                x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                        DGF::calcGaussianLikeCurveDerivative(
+                                x, DGF::b13, DGF::b23, DGF::b33, DGF::b43));
+        const double e0 = ws.passiveFiberStrain[i];
+        const double passiveMultiplierDerivative =
+                ws.passiveForceScale[i] *
+                (DGF::kPE * exp((DGF::kPE * (normFiberLength[i] - 1)) / e0)) /
+                (e0 * ws.passiveForceDenominator[i]);
+        const double partialNormFiberLengthPartialFiberLength =
+                1.0 / ws.optimalFiberLength[i];
+        fiberStiffness[i] =
+                maxIsometricForce *
+                (activation[i] *
+                                (partialNormFiberLengthPartialFiberLength *
+                                        activeMultiplierDerivative) *
+                                forceVelocityMultiplier[i] +
+                        partialNormFiberLengthPartialFiberLength *
+                                passiveMultiplierDerivative);
+
+        const double fiberWidth = ws.fiberWidth[i];
+        partialPennationAnglePartialFiberLength[i] =
+                (-fiberWidth / square(fiberLength[i])) /
+                sqrt(1.0 - square(fiberWidth / fiberLength[i]));
+        partialFiberForceAlongTendonPartialFiberLength[i] =
+                fiberStiffness[i] * cosPennationAngle[i] +
+                totalFiberForce[i] *
+                        (-sinPennationAngle[i] *
+                                partialPennationAnglePartialFiberLength[i]);
+        const double fiberLengthTerm =
+                fiberLength[i] * sinPennationAngle[i] *
+                partialPennationAnglePartialFiberLength[i];
+        fiberStiffnessAlongTendon[i] =
+                partialFiberForceAlongTendonPartialFiberLength[i] *
+                (1.0 / (cosPennationAngle[i] - fiberLengthTerm));
+        partialTendonForcePartialFiberLength[i] =
+                SimTK::Infinity * (fiberLengthTerm - cosPennationAngle[i]);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const DGF& muscle = *m_muscles[i];
+        auto& mdi = muscle.updMuscleDynamicsInfo(s);
+        mdi.activation = activation[i];
+        mdi.fiberForce = totalFiberForce[i];
+        mdi.activeFiberForce = activeFiberForce[i];
+        mdi.passiveFiberForce =
+                conPassiveFiberForce[i] + nonConPassiveFiberForce[i];
+        mdi.normFiberForce = mdi.fiberForce / ws.maxIsometricForce[i];
+        mdi.fiberForceAlongTendon = mdi.fiberForce * cosPennationAngle[i];
+        mdi.normTendonForce = mdi.normFiberForce * cosPennationAngle[i];
+        mdi.tendonForce = mdi.fiberForceAlongTendon;
+
+        mdi.fiberStiffness = fiberStiffness[i];
+        mdi.fiberStiffnessAlongTendon = fiberStiffnessAlongTendon[i];
+        mdi.tendonStiffness = SimTK::Infinity;
+
+        mdi.fiberActivePower =
+                -(mdi.activeFiberForce + nonConPassiveFiberForce[i]) *
+                fiberVelocity[i];
+        mdi.fiberPassivePower = -conPassiveFiberForce[i] * fiberVelocity[i];
+        // The tendon velocity, and therefore the tendon power, is zero.
+        mdi.tendonPower = 0.0;
+
+        mdi.userDefinedDynamicsExtras.resize(5);
+        mdi.userDefinedDynamicsExtras[DGF::m_mdi_passiveFiberElasticForce] =
+                conPassiveFiberForce[i];
+        mdi.userDefinedDynamicsExtras[DGF::m_mdi_passiveFiberDampingForce] =
+                nonConPassiveFiberForce[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialPennationAnglePartialFiberLength] =
+                partialPennationAnglePartialFiberLength[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialFiberForceAlongTendonPartialFiberLength] =
+                partialFiberForceAlongTendonPartialFiberLength[i];
+        mdi.userDefinedDynamicsExtras
+                [DGF::m_mdi_partialTendonForcePartialFiberLength] =
+                partialTendonForcePartialFiberLength[i];
+        muscle.markCacheVariableValid(s, "dynamicsInfo");
+    }
+}
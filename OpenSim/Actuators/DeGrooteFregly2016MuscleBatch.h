@@ -0,0 +1,168 @@
+#ifndef OPENSIM_DEGROOTEFREGLY2016MUSCLEBATCH_H
+#define OPENSIM_DEGROOTEFREGLY2016MUSCLEBATCH_H
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  DeGrooteFregly2016MuscleBatch.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/osimActuatorsDLL.h>
+#include <OpenSim/Simulation/Model/ModelComponent.h>
+
+namespace OpenSim {
+
+class DeGrooteFregly2016Muscle;
+
+/** Evaluate the rigid-tendon DeGrooteFregly2016Muscle%s of a model together.
+
+By default, each DeGrooteFregly2016Muscle computes its MuscleLengthInfo,
+FiberVelocityInfo and MuscleDynamicsInfo on its own, the first time the info
+is needed for a state. If the model contains a DeGrooteFregly2016MuscleBatch,
+the first request for one of these infos from any DeGrooteFregly2016Muscle
+whose ignore_tendon_compliance property is true computes that info for all
+such muscles at once and stores it in the cache of each muscle; the other
+muscles then find the info in their cache. The lengths, lengthening speeds
+and activations of the muscles are gathered into contiguous arrays, and the
+curves are evaluated in loops over these arrays that the compiler can
+vectorize. This reduces the cost of evaluating models with many muscles in
+problems that evaluate the muscles for many states, such as MocoInverse and
+MocoTrack with a rigid tendon (see ModOpIgnoreTendonCompliance).
+
+The infos computed by the batch are the same as those computed by each
+muscle, to within roundoff. Muscles with a compliant tendon are not part of
+the batch; they compute their infos as usual. A model may contain at most one
+DeGrooteFregly2016MuscleBatch.
+
+@code
+model.addComponent(new DeGrooteFregly2016MuscleBatch());
+@endcode */
+class OSIMACTUATORS_API DeGrooteFregly2016MuscleBatch : public ModelComponent {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            DeGrooteFregly2016MuscleBatch, ModelComponent);
+
+public:
+    DeGrooteFregly2016MuscleBatch() = default;
+
+    /// The number of muscles in the batch. This is available after the batch
+    /// is connected to the model.
+    int getNumMuscles() const { return (int)m_muscles.size(); }
+
+    /// @name Batched evaluation
+    /// These are invoked by the muscles in the batch; you do not need to call
+    /// them yourself.
+    /// @{
+
+    /// Compute the MuscleLengthInfo of all muscles in the batch. The state
+    /// must be realized to SimTK::Stage::Position.
+    void computeMuscleLengthInfo(const SimTK::State& s) const;
+    /// Compute the FiberVelocityInfo of all muscles in the batch. The state
+    /// must be realized to SimTK::Stage::Velocity.
+    void computeFiberVelocityInfo(const SimTK::State& s) const;
+    /// Compute the MuscleDynamicsInfo of all muscles in the batch. The state
+    /// must be realized to SimTK::Stage::Velocity.
+    void computeMuscleDynamicsInfo(const SimTK::State& s) const;
+    /// @}
+
+protected:
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+private:
+    // Parameters of the muscles and scratch arrays for the computations, one
+    // entry per muscle. The parameters are read from the properties of the
+    // muscles on every evaluation, like the muscles do themselves, so that
+    // changes to the properties (e.g., by a MocoParameter) take effect
+    // without reconnecting the model. Each computation has its own scratch
+    // arrays, since computing the velocity and dynamics infos may trigger
+    // the computation of the infos they depend on.
+    struct Workspace {
+        std::vector<double> maxIsometricForce;
+        std::vector<double> optimalFiberLength;
+        std::vector<double> tendonSlackLength;
+        std::vector<double> fiberWidth;
+        std::vector<double> maxContractionVelocity; // In meters per second.
+        std::vector<double> activeForceWidthScale;
+        std::vector<double> passiveFiberStrain;
+        std::vector<double> passiveForceOffset;
+        std::vector<double> passiveForceDenominator;
+        // 0 if ignore_passive_fiber_force is true, 1 otherwise.
+        std::vector<double> passiveForceScale;
+        std::vector<double> fiberDamping;
+
+        // computeMuscleLengthInfo().
+        std::vector<double> lenMuscleTendonLength;
+        std::vector<double> lenFiberLengthAlongTendon;
+        std::vector<double> lenFiberLength;
+        std::vector<double> lenNormFiberLength;
+        std::vector<double> lenCosPennationAngle;
+        std::vector<double> lenSinPennationAngle;
+        std::vector<double> lenActiveMultiplier;
+        std::vector<double> lenPassiveMultiplier;
+
+        // computeFiberVelocityInfo().
+        std::vector<double> velMuscleTendonVelocity;
+        std::vector<double> velFiberLengthAlongTendon;
+        std::vector<double> velFiberLength;
+        std::vector<double> velCosPennationAngle;
+        std::vector<double> velFiberVelocity;
+        std::vector<double> velNormFiberVelocity;
+        std::vector<double> velForceVelocityMultiplier;
+        std::vector<double> velPennationAngularVelocity;
+
+        // computeMuscleDynamicsInfo().
+        std::vector<double> dynActivation;
+        std::vector<double> dynFiberLength;
+        std::vector<double> dynNormFiberLength;
+        std::vector<double> dynCosPennationAngle;
+        std::vector<double> dynSinPennationAngle;
+        std::vector<double> dynActiveMultiplier;
+        std::vector<double> dynPassiveMultiplier;
+        std::vector<double> dynForceVelocityMultiplier;
+        std::vector<double> dynNormFiberVelocity;
+        std::vector<double> dynFiberVelocity;
+        std::vector<double> dynActiveFiberForce;
+        std::vector<double> dynConPassiveFiberForce;
+        std::vector<double> dynNonConPassiveFiberForce;
+        std::vector<double> dynTotalFiberForce;
+        std::vector<double> dynFiberStiffness;
+        std::vector<double> dynPartialPennationAnglePartialFiberLength;
+        std::vector<double> dynPartialFiberForceAlongTendonPartialFiberLength;
+        std::vector<double> dynFiberStiffnessAlongTendon;
+        std::vector<double> dynPartialTendonForcePartialFiberLength;
+
+        void resize(int n);
+        friend std::ostream& operator<<(std::ostream& o, const Workspace&) {
+            o << "DeGrooteFregly2016MuscleBatch::Workspace should not be "
+                 "serialized!" << std::endl;
+            return o;
+        }
+    };
+    // Resize the workspace for the muscles in the batch and read the
+    // parameters of the muscles into it.
+    Workspace& updWorkspace(const SimTK::State& s) const;
+
+    std::vector<SimTK::ReferencePtr<const DeGrooteFregly2016Muscle>>
+            m_muscles;
+
+    mutable CacheVariable<Workspace> m_workspaceCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DEGROOTEFREGLY2016MUSCLEBATCH_H
@@ -93,10 +93,28 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
 
     m_curve = *f;
     delete f;
+    if (m_tabulationTolerance > 0) {
+        m_curve.tabulate(m_tabulationTolerance);
+    }
 
     setObjectIsUpToDateWithProperties();
 }
 
+void FiberForceLengthCurve::setTabulationTolerance(double tolerance)
+{
+    // The table, if any, was built with this tolerance.
+    if (tolerance == m_tabulationTolerance) return;
+    m_tabulationTolerance = tolerance;
+    // Otherwise, the table is built with the curve.
+    if (isObjectUpToDateWithProperties()) {
+        if (tolerance > 0) {
+            m_curve.tabulate(tolerance);
+        } else {
+            m_curve.clearTabulation();
+        }
+    }
+}
+
 void FiberForceLengthCurve::ensureCurveUpToDate()
 {
     if(isObjectUpToDateWithProperties()) {
@@ -89,9 +89,27 @@ void ForceVelocityCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if (m_tabulationTolerance > 0) {
+        m_curve.tabulate(m_tabulationTolerance);
+    }
     setObjectIsUpToDateWithProperties();
 }
 
+void ForceVelocityCurve::setTabulationTolerance(double tolerance)
+{
+    // The table, if any, was built with this tolerance.
+    if (tolerance == m_tabulationTolerance) return;
+    m_tabulationTolerance = tolerance;
+    // Otherwise, the table is built with the curve.
+    if (isObjectUpToDateWithProperties()) {
+        if (tolerance > 0) {
+            m_curve.tabulate(tolerance);
+        } else {
+            m_curve.clearTabulation();
+        }
+    }
+}
+
 void ForceVelocityCurve::ensureCurveUpToDate()
 {
     if(!isObjectUpToDateWithProperties()) {
@@ -269,6 +269,7 @@ void Millard2012EquilibriumMuscle::constructProperties()
     constructProperty_ForceVelocityCurve(ForceVelocityCurve());
     constructProperty_FiberForceLengthCurve(FiberForceLengthCurve());
     constructProperty_TendonForceLengthCurve(TendonForceLengthCurve());
+    constructProperty_curve_tabulation_tolerance(0.0);
 
     setMinControl(get_minimum_activation());
 }
@@ -300,6 +301,19 @@ void Millard2012EquilibriumMuscle::extendFinalizeFromProperties()
     TendonForceLengthCurve& fseCurve = upd_TendonForceLengthCurve();
     fseCurve.setName(namePrefix + "_TendonForceLengthCurve");
 
+    // Evaluate the muscle curves from tables, if requested. A table is only
+    // rebuilt if the tolerance changed, or (in ensureCurveUpToDate() below)
+    // if its curve is out of date with its properties.
+    const double tabulationTolerance = get_curve_tabulation_tolerance();
+    OPENSIM_THROW_IF_FRMOBJ(tabulationTolerance < 0,
+        InvalidPropertyValue,
+        getProperty_curve_tabulation_tolerance().getName(),
+        "The curve tabulation tolerance cannot be negative.");
+    falCurve.setTabulationTolerance(tabulationTolerance);
+    fvCurve.setTabulationTolerance(tabulationTolerance);
+    fpeCurve.setTabulationTolerance(tabulationTolerance);
+    fseCurve.setTabulationTolerance(tabulationTolerance);
+
     // Include fiber damping in the model only if the damping coefficient is
     // larger than MIN_NONZERO_DAMPING_COEFFICIENT. This is done to ensure
     // we remain sufficiently far from the numerical singularity at beta=0.
@@ -226,6 +226,9 @@ public:
         "Passive-force-length curve.");
     OpenSim_DECLARE_UNNAMED_PROPERTY(TendonForceLengthCurve,
         "Tendon-force-length curve.");
+    OpenSim_DECLARE_PROPERTY(curve_tabulation_tolerance, double,
+        "Error tolerance of the tabulated evaluation of the muscle curves, "
+        "or 0 (default) to evaluate the curves exactly.");
 
 //==============================================================================
 // OUTPUTS
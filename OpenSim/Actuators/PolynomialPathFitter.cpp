@@ -1528,6 +1528,8 @@ void PolynomialPathFitter::computeFittingErrors(const Model& modelFitted,
     log_info("------------------------------------------------");
     SimTK::Vector pathLengthRMSErrors((int)pathLengths.getNumColumns());
     SimTK::Vector momentArmRMSErrors((int)momentArms.getNumColumns());
+    SimTK::Vector pathLengthMaxErrors((int)pathLengths.getNumColumns());
+    SimTK::Vector momentArmMaxErrors((int)momentArms.getNumColumns());
     int ip = 0;
     int ima = 0;
     for (const auto& path : modelFitted.getComponentList<FunctionBasedPath>()) {
@@ -1542,8 +1544,11 @@ void PolynomialPathFitter::computeFittingErrors(const Model& modelFitted,
         SimTK::Vector pathLengthError = pathLength - pathLengthFitted;
         double pathLengthRMSError = 100.0 * std::sqrt(
                 pathLengthError.normSqr() / pathLengthError.size());
-        pathLengthRMSErrors[ip++] = pathLengthRMSError;
-        log_info(" - path length RMSE: {:1.3f} cm", pathLengthRMSError);
+        double pathLengthMaxError = 100.0 * pathLengthError.normInf();
+        pathLengthRMSErrors[ip] = pathLengthRMSError;
+        pathLengthMaxErrors[ip++] = pathLengthMaxError;
+        log_info(" - path length RMSE: {:1.3f} cm, max error: {:1.3f} cm",
+                pathLengthRMSError, pathLengthMaxError);
 
         if (pathLengthRMSError > 10.0*pathLengthTolerance) {
             printWarningMessage("path length", pathLengthTolerance);
@@ -1561,9 +1566,12 @@ void PolynomialPathFitter::computeFittingErrors(const Model& modelFitted,
             SimTK::Vector momentArmError = momentArm - momentArmFitted;
             double momentArmRMSError = 100.0 * std::sqrt(
                     momentArmError.normSqr() / momentArmError.size());
-            momentArmRMSErrors[ima++] = momentArmRMSError;
-            log_info(" - '{}' moment arm RMSE: {:1.3f} cm", coordinateName,
-                    momentArmRMSError);
+            double momentArmMaxError = 100.0 * momentArmError.normInf();
+            momentArmRMSErrors[ima] = momentArmRMSError;
+            momentArmMaxErrors[ima++] = momentArmMaxError;
+            log_info(" - '{}' moment arm RMSE: {:1.3f} cm, max error: "
+                    "{:1.3f} cm", coordinateName, momentArmRMSError,
+                    momentArmMaxError);
 
             if (momentArmRMSError > 10.0*momentArmTolerance) {
                 printWarningMessage(
@@ -1589,6 +1597,13 @@ void PolynomialPathFitter::computeFittingErrors(const Model& modelFitted,
     if (averageMomentArmError > momentArmTolerance) {
         printWarningMessage("average moment arm", momentArmTolerance);
     }
+
+    // Print the largest errors over all paths, which bound the error of the
+    // fitted paths over the sampled coordinate values.
+    log_info("Maximum path length error = {:1.3f} cm",
+            pathLengthMaxErrors.normInf());
+    log_info("Maximum moment arm error  = {:1.3f} cm",
+            momentArmMaxErrors.normInf());
 }
 
 void PolynomialPathFitter::constructProperties() {
@@ -165,6 +165,27 @@ private:
  * @note The `evaluateFunctionBasedPaths` method can be used independently from
  *       the rest of this class, and does not require the `FunctionBasedPath`s
  *       in the model to use `MultivariatePolynomialFunction`s.
+ *
+ * # Ligaments
+ * Any `Force` with a `path` property is fitted, including
+ * `Blankevoort1991Ligament`. To fit surrogate paths for the ligaments of a
+ * knee model over its secondary (e.g., tibiofemoral and patellofemoral)
+ * coordinates, provide a reference trajectory that spans the secondary
+ * coordinate space (e.g., results from `COMAKTool` or `ForsimTool`) and use
+ * `ModOpRemoveMuscles` if only the ligament paths should be fitted:
+ * @code{.cpp}
+ * fitter.setModel(ModelProcessor("knee.osim") | ModOpRemoveMuscles());
+ * fitter.setCoordinateValues(TableProcessor("secondary_kinematics.sto"));
+ * fitter.appendCoordinateSamplingBounds(
+ *         "/jointset/knee_r/knee_tx_r", SimTK::Vec2(-0.1, 0.1));
+ * @endcode
+ * Sampling bounds are converted from degrees to radians for all coordinates,
+ * so translational secondary coordinates need bounds much smaller than the
+ * global default (the bounds above sample roughly +/- 1.7 mm). The RMS and maximum absolute errors of
+ * each fitted path length and moment arm are reported in the summary. The
+ * fitted paths can then be used in place of the original paths with
+ * `ModOpReplacePathsWithFunctionBasedPaths`, or by setting the
+ * `function_based_paths_file` property of `COMAKTool` or `ForsimTool`.
  */
 class OSIMACTUATORS_API PolynomialPathFitter : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(PolynomialPathFitter, Object);
@@ -487,8 +508,8 @@ public:
     // HELPER FUNCTIONS
     /**
      * Print out a summary of the path fitting results, including information
-     * about the fitted polynomial functions and root-mean-square (RMS) errors
-     * between the original and fitted paths.
+     * about the fitted polynomial functions and root-mean-square (RMS) and
+     * maximum absolute errors between the original and fitted paths.
      *
      * The `trajectory` argument is a `TableProcessor` object containing the
      * simulation trajectory, specifically the set of coordinate values, used to
@@ -692,9 +713,10 @@ private:
         SimTK::Vector& coefficients) const;
 
     /**
-     * Get the RMS errors between two sets of path lengths and moment arms
-     * computed from a model with FunctionBasedPaths and the original model. The
-     * `modelFitted` argument must be the model with the FunctionBasedPaths.
+     * Get the RMS and maximum absolute errors between two sets of path lengths
+     * and moment arms computed from a model with FunctionBasedPaths and the
+     * original model. The `modelFitted` argument must be the model with the
+     * FunctionBasedPaths.
      */
     static void computeFittingErrors(const Model& modelFitted,
             const TimeSeriesTable& pathLengths,
@@ -335,6 +335,15 @@ public:
     */
     void printMuscleCurveToCSVFile(const std::string& path);
 
+    /** Evaluates the curve and its first two derivatives from a tabulated
+    approximation with the given error tolerance (see
+    SmoothSegmentedFunction::tabulate()), which is faster than the exact
+    evaluation. A tolerance of 0 (the default) selects the exact evaluation.
+    The table is rebuilt with the curve when its properties change, and is
+    kept if the tolerance is set to its current value. */
+    void setTabulationTolerance(double tolerance);
+    double getTabulationTolerance() const { return m_tabulationTolerance; }
+
     void ensureCurveUpToDate();
 //==============================================================================
 // PRIVATE
@@ -373,6 +382,7 @@ private:
     void buildCurve(bool computeIntegral = false);
 
     SmoothSegmentedFunction m_curve;
+    double m_tabulationTolerance = 0;
 
     double m_normForceAtToeEndInUse;
     double m_stiffnessAtOneNormForceInUse;
@@ -0,0 +1,127 @@
+/* -------------------------------------------------------------------------- *
+ *           OpenSim:  benchmarkDeGrooteFregly2016MuscleBatch.cpp             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Benchmark for DeGrooteFregly2016MuscleBatch: the time to evaluate the
+// tendon forces of many rigid-tendon DeGrooteFregly2016Muscles, with and
+// without the batch, for a sequence of states. It does not depend on any
+// data files.
+//
+// Usage:
+//     benchmarkDeGrooteFregly2016MuscleBatch [number_of_muscles]
+//                                            [number_of_states]
+//
+// The default is 80 muscles and 20000 states. The wall time of each variant
+// is printed and written to muscle_batch_benchmark.csv.
+
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBatch.h>
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+
+#include <fstream>
+#include <iostream>
+
+using namespace OpenSim;
+
+namespace {
+
+Model createModel(int numMuscles, bool batched) {
+    Model model;
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    joint->updCoordinate(SliderJoint::Coord::TranslationX).setName("x");
+    model.addComponent(joint);
+    for (int i = 0; i < numMuscles; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_max_isometric_force(500 + 10 * i);
+        muscle->set_optimal_fiber_length(0.1 + 0.001 * i);
+        muscle->set_tendon_slack_length(0.05);
+        muscle->set_pennation_angle_at_optimal(0.005 * i);
+        muscle->set_fiber_damping(0.01);
+        muscle->set_ignore_tendon_compliance(true);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint(
+                "insertion", *body, SimTK::Vec3(0.001 * i, 0, 0));
+        model.addComponent(muscle);
+    }
+    if (batched) {
+        auto* batch = new DeGrooteFregly2016MuscleBatch();
+        batch->setName("batch");
+        model.addComponent(batch);
+    }
+    model.finalizeConnections();
+    return model;
+}
+
+// Sum of the tendon forces over all states, so that the work done is
+// observable and can be compared between the variants.
+double evaluate(Model& model, int numStates) {
+    SimTK::State state = model.initSystem();
+    const auto& coord = model.getCoordinateSet().get("x");
+    const auto& muscles = model.getComponentList<DeGrooteFregly2016Muscle>();
+    for (const auto& muscle : muscles) {
+        muscle.setActivation(state, 0.5);
+    }
+    double sum = 0;
+    for (int k = 0; k < numStates; ++k) {
+        const double phase = 2 * SimTK::Pi * k / numStates;
+        coord.setValue(state, 0.16 + 0.02 * std::sin(phase), false);
+        coord.setSpeedValue(state, 0.3 * std::cos(phase));
+        model.realizeVelocity(state);
+        for (const auto& muscle : muscles) {
+            sum += muscle.getTendonForce(state);
+        }
+    }
+    return sum;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const int numMuscles = argc > 1 ? std::stoi(argv[1]) : 80;
+        const int numStates = argc > 2 ? std::stoi(argv[2]) : 20000;
+
+        std::ofstream csv("muscle_batch_benchmark.csv");
+        csv << "muscles,states,variant,wall_time,checksum\n";
+        log_cout("{} muscles, {} states:", numMuscles, numStates);
+        for (const bool batched : {false, true}) {
+            Model model = createModel(numMuscles, batched);
+            Stopwatch watch;
+            const double sum = evaluate(model, numStates);
+            const double wallTime = watch.getElapsedTime();
+            const std::string variant = batched ? "batched" : "unbatched";
+            csv << numMuscles << "," << numStates << "," << variant << ","
+                << wallTime << "," << sum << "\n";
+            log_cout("  {:<10} {:>10.4f} s (checksum {})", variant, wallTime,
+                    sum);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
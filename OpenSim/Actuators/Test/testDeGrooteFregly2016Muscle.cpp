@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBatch.h>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
@@ -30,6 +31,8 @@
 #include <OpenSim/Tools/CMCTool.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 
+#include <functional>
+
 #include <catch2/catch_all.hpp>
 
 using namespace OpenSim;
@@ -1090,3 +1093,165 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+TEST_CASE("DeGrooteFregly2016MuscleBatch matches the muscles") {
+
+    // Muscles with a variety of properties, spanning a slider joint. The last
+    // muscle has a compliant tendon and is not part of the batch.
+    Model model;
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    joint->updCoordinate(SliderJoint::Coord::TranslationX).setName("x");
+    model.addComponent(joint);
+    const int numMuscles = 5;
+    for (int i = 0; i < numMuscles; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_max_isometric_force(500 + 100 * i);
+        muscle->set_optimal_fiber_length(0.1 + 0.01 * i);
+        muscle->set_tendon_slack_length(0.05);
+        muscle->set_pennation_angle_at_optimal(0.1 * i);
+        muscle->set_fiber_damping(0.01 * i);
+        muscle->set_active_force_width_scale(1.0 + 0.25 * i);
+        muscle->set_passive_fiber_strain_at_one_norm_force(0.5 + 0.1 * i);
+        muscle->set_ignore_passive_fiber_force(i == 2);
+        muscle->set_ignore_tendon_compliance(i < numMuscles - 1);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint(
+                "insertion", *body, SimTK::Vec3(0.01 * i, 0, 0));
+        model.addComponent(muscle);
+    }
+    model.finalizeConnections();
+
+    Model batchedModel(model);
+    auto* batch = new DeGrooteFregly2016MuscleBatch();
+    batch->setName("batch");
+    batchedModel.addComponent(batch);
+
+    auto initState = [](Model& m) -> SimTK::State& {
+        SimTK::State& state = m.initSystem();
+        const auto& coord = m.getCoordinateSet().get("x");
+        coord.setValue(state, 0.16);
+        coord.setSpeedValue(state, -0.3);
+        for (int i = 0; i < numMuscles; ++i) {
+            m.getComponent<DeGrooteFregly2016Muscle>("muscle" +
+                    std::to_string(i)).setActivation(state, 0.2 + 0.15 * i);
+        }
+        m.realizeVelocity(state);
+        return state;
+    };
+    SimTK::State& state = initState(model);
+    SimTK::State& batchedState = initState(batchedModel);
+    CHECK(batch->getNumMuscles() == numMuscles - 1);
+
+    // The first request for a dynamics quantity computes the infos of all
+    // muscles in the batch.
+    const auto& lastBatched = batchedModel.getComponent<
+            DeGrooteFregly2016Muscle>("muscle3");
+    CHECK(lastBatched.getTendonForce(batchedState) ==
+            Approx(model.getComponent<DeGrooteFregly2016Muscle>("muscle3")
+                            .getTendonForce(state)));
+
+    using Getter = std::function<double(
+            const DeGrooteFregly2016Muscle&, const SimTK::State&)>;
+    const std::vector<std::pair<std::string, Getter>> getters = {
+            {"tendon_length", &Muscle::getTendonLength},
+            {"tendon_strain", &Muscle::getTendonStrain},
+            {"fiber_length", &Muscle::getFiberLength},
+            {"normalized_fiber_length", &Muscle::getNormalizedFiberLength},
+            {"fiber_length_along_tendon", &Muscle::getFiberLengthAlongTendon},
+            {"pennation_angle", &Muscle::getPennationAngle},
+            {"cos_pennation_angle", &Muscle::getCosPennationAngle},
+            {"active_force_length_multiplier",
+                    &Muscle::getActiveForceLengthMultiplier},
+            {"passive_force_multiplier", &Muscle::getPassiveForceMultiplier},
+            {"fiber_velocity", &Muscle::getFiberVelocity},
+            {"normalized_fiber_velocity",
+                    &Muscle::getNormalizedFiberVelocity},
+            {"fiber_velocity_along_tendon",
+                    &Muscle::getFiberVelocityAlongTendon},
+            {"tendon_velocity", &Muscle::getTendonVelocity},
+            {"pennation_angular_velocity",
+                    &Muscle::getPennationAngularVelocity},
+            {"force_velocity_multiplier",
+                    &Muscle::getForceVelocityMultiplier},
+            {"fiber_force", &Muscle::getFiberForce},
+            {"fiber_force_along_tendon", &Muscle::getFiberForceAlongTendon},
+            {"active_fiber_force", &Muscle::getActiveFiberForce},
+            {"passive_fiber_force", &Muscle::getPassiveFiberForce},
+            {"passive_fiber_elastic_force",
+                    &DeGrooteFregly2016Muscle::getPassiveFiberElasticForce},
+            {"passive_fiber_damping_force",
+                    &DeGrooteFregly2016Muscle::getPassiveFiberDampingForce},
+            {"tendon_force", &Muscle::getTendonForce},
+            {"fiber_stiffness", &Muscle::getFiberStiffness},
+            {"fiber_stiffness_along_tendon",
+                    &Muscle::getFiberStiffnessAlongTendon},
+            {"muscle_stiffness", &Muscle::getMuscleStiffness},
+            {"fiber_active_power", &Muscle::getFiberActivePower},
+            {"fiber_passive_power", &Muscle::getFiberPassivePower},
+            {"tendon_power", &Muscle::getTendonPower}};
+
+    auto checkMuscles = [&]() {
+        for (int i = 0; i < numMuscles; ++i) {
+            const std::string name = "muscle" + std::to_string(i);
+            const auto& muscle =
+                    model.getComponent<DeGrooteFregly2016Muscle>(name);
+            const auto& batched =
+                    batchedModel.getComponent<DeGrooteFregly2016Muscle>(name);
+            for (const auto& getter : getters) {
+                CAPTURE(name, getter.first);
+                const double expected = getter.second(muscle, state);
+                CHECK(getter.second(batched, batchedState) ==
+                        Approx(expected).epsilon(1e-12).margin(1e-12));
+            }
+            CHECK(batched.getTendonStiffness(batchedState) ==
+                    muscle.getTendonStiffness(state));
+            CHECK(batched.getActivation(batchedState) ==
+                    muscle.getActivation(state));
+        }
+    };
+    checkMuscles();
+
+    SECTION("Properties changed without reconnecting") {
+        // This is what a MocoParameter does when the solver does not call
+        // initSystem() for each set of parameter values.
+        const double tendonForceBefore =
+                lastBatched.getTendonForce(batchedState);
+        for (Model* m : {&model, &batchedModel}) {
+            for (int i = 0; i < numMuscles; ++i) {
+                auto& muscle = m->updComponent<DeGrooteFregly2016Muscle>(
+                        "muscle" + std::to_string(i));
+                muscle.set_max_isometric_force(
+                        1.5 * muscle.get_max_isometric_force());
+                muscle.set_optimal_fiber_length(
+                        0.9 * muscle.get_optimal_fiber_length());
+                muscle.set_tendon_slack_length(0.04);
+                muscle.set_active_force_width_scale(
+                        1.1 * muscle.get_active_force_width_scale());
+                const double e0 =
+                        muscle.get_passive_fiber_strain_at_one_norm_force();
+                muscle.set_passive_fiber_strain_at_one_norm_force(0.8 * e0);
+                muscle.set_fiber_damping(0.05);
+                muscle.set_ignore_passive_fiber_force(i == 1);
+            }
+        }
+        for (auto* s : {&state, &batchedState}) {
+            s->invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+        }
+        model.realizeVelocity(state);
+        batchedModel.realizeVelocity(batchedState);
+
+        CHECK(lastBatched.getTendonForce(batchedState) !=
+                Approx(tendonForceBefore));
+        checkMuscles();
+    }
+
+    SECTION("At most one batch") {
+        auto* otherBatch = new DeGrooteFregly2016MuscleBatch();
+        otherBatch->setName("other_batch");
+        batchedModel.addComponent(otherBatch);
+        CHECK_THROWS_AS(batchedModel.initSystem(), Exception);
+    }
+}
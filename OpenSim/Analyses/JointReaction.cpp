@@ -27,6 +27,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Actuator.h>
+#include <OpenSim/Simulation/Model/Smith2018ArticularContactForce.h>
 #include "JointReaction.h"
 
 using namespace OpenSim;
@@ -64,7 +65,9 @@ JointReaction::JointReaction(Model *aModel) :
     _forcesFileName(_forcesFileNameProp.getValueStr()),
     _jointNames(_jointNamesProp.getValueStrArray()),
     _onBody(_onBodyProp.getValueStrArray()),
-    _inFrame(_inFrameProp.getValueStrArray())
+    _inFrame(_inFrameProp.getValueStrArray()),
+    _contactNames(_contactNamesProp.getValueStrArray()),
+    _contactList(nullptr)
 {
     setNull();
 }
@@ -82,7 +85,9 @@ JointReaction::JointReaction(const std::string &aFileName):
     _forcesFileName(_forcesFileNameProp.getValueStr()),
     _jointNames(_jointNamesProp.getValueStrArray()),
     _onBody(_onBodyProp.getValueStrArray()),
-    _inFrame(_inFrameProp.getValueStrArray())
+    _inFrame(_inFrameProp.getValueStrArray()),
+    _contactNames(_contactNamesProp.getValueStrArray()),
+    _contactList(nullptr)
 {
     setNull();
 
@@ -111,7 +116,9 @@ JointReaction::JointReaction(const JointReaction &aJointReaction):
     _forcesFileName(_forcesFileNameProp.getValueStr()),
     _jointNames(_jointNamesProp.getValueStrArray()),
     _onBody(_onBodyProp.getValueStrArray()),
-    _inFrame(_inFrameProp.getValueStrArray())
+    _inFrame(_inFrameProp.getValueStrArray()),
+    _contactNames(_contactNamesProp.getValueStrArray()),
+    _contactList(nullptr)
 {
     setNull();
     // COPY TYPE AND NAME
@@ -141,6 +148,7 @@ operator=(const JointReaction &aJointReaction)
     _jointNames = aJointReaction._jointNames;
     _onBody = aJointReaction._onBody;
     _inFrame = aJointReaction._inFrame;
+    _contactNames = aJointReaction._contactNames;
     _useForceStorage = aJointReaction._useForceStorage;
     _storeActuation = NULL;
     return(*this);
@@ -166,6 +174,7 @@ setNull()
     _onBody[0]= "child";
     _inFrame.setSize(1);
     _inFrame[0] = "ground";
+    _contactNames.setSize(0);
 
     _storeActuation = NULL;
 
@@ -218,6 +227,15 @@ setupProperties()
         "specified above. If the array has one entry only, "
         "that selection is applied to all chosen joints.");
     _propertySet.append(&_inFrameProp);
+
+    _contactNamesProp.setName("contact_force_names");
+    _contactNamesProp.setComment("Names of Smith2018ArticularContactForce "
+        "components whose resultant loads (force on the casting mesh, center "
+        "of pressure, and moment about the center of pressure, expressed in "
+        "ground) are reported along with the joint reactions. The key word "
+        "'All' indicates all such forces in the model. By default, no "
+        "contact loads are reported.");
+    _propertySet.append(&_contactNamesProp);
 }
 
 //=============================================================================
@@ -341,9 +359,42 @@ void JointReaction::setupReactionList()
         }
     }
 }
-    
 
+//_____________________________________________________________________________
+/**
+ * Setup the list of articular contact forces whose resultant loads are
+ * reported with the joint reactions.
+ */
+void JointReaction::setupContactList()
+{
+    _contactList.setSize(0);
+    if (_contactNames.getSize() == 0) return;
+
+    std::string firstNameEntry = _contactNames.get(0);
+    std::transform(firstNameEntry.begin(), firstNameEntry.end(),
+        firstNameEntry.begin(), ::toupper);
+    if (firstNameEntry == "ALL") {
+        for (const auto& contact :
+                _model->getComponentList<Smith2018ArticularContactForce>()) {
+            _contactList.append(&contact);
+        }
+        return;
+    }
 
+    const ForceSet& forceSet = _model->getForceSet();
+    for (int i = 0; i < _contactNames.getSize(); ++i) {
+        const auto* contact = forceSet.contains(_contactNames[i]) ?
+            dynamic_cast<const Smith2018ArticularContactForce*>(
+                &forceSet.get(_contactNames[i])) : nullptr;
+        if (contact) {
+            _contactList.append(contact);
+        }
+        else {
+            log_warn("'{}' is not a Smith2018ArticularContactForce in the "
+                     "model. Ignoring this entry.", _contactNames[i]);
+        }
+    }
+}
 
 //_____________________________________________________________________________
 /**
@@ -400,6 +451,24 @@ constructColumnLabels()
         labels.append(labelRoot + "_py");
         labels.append(labelRoot + "_pz");
     }
+    //  For each contact force, append the same labels for the load on its
+    //  casting mesh.
+    for(int i=0; i<_contactList.getSize(); ++i) {
+        const Smith2018ArticularContactForce& contact = *_contactList[i];
+        std::string meshName = contact.getConnectee<Smith2018ContactMesh>(
+                "casting_mesh").getName();
+        std::string labelRoot = contact.getName() + "_on_" + meshName +
+                "_in_ground";
+        labels.append(labelRoot + "_fx");
+        labels.append(labelRoot + "_fy");
+        labels.append(labelRoot + "_fz");
+        labels.append(labelRoot + "_mx");
+        labels.append(labelRoot + "_my");
+        labels.append(labelRoot + "_mz");
+        labels.append(labelRoot + "_px");
+        labels.append(labelRoot + "_py");
+        labels.append(labelRoot + "_pz");
+    }
 
     setColumnLabels(labels);
 }
@@ -516,13 +585,14 @@ setModel(Model& aModel)
 
     // UPDATE VARIABLES IN THIS CLASS
     setupReactionList();
+    setupContactList();
     constructDescription();
     constructColumnLabels();
 
     int numJoints = _reactionList.getSize();
     // set size of working array of loads.  Each load has 3 components each
     // for force, moment, and point of application
-    _Loads.setSize(9*numJoints);
+    _Loads.setSize(9*(numJoints + _contactList.getSize()));
 }
 
 
@@ -629,6 +699,39 @@ record(const SimTK::State& s)
             _Loads[I+j+6] = pointsVec[i][j];
         }
     }
+
+    /* resultant loads of the contact forces, from the contact metrics cached
+    *  during the realization above*/
+    for(int i=0; i<_contactList.getSize(); ++i) {
+        const Smith2018ArticularContactForce& contact = *_contactList[i];
+        const PhysicalFrame& meshFrame =
+            contact.getConnectee<Smith2018ContactMesh>("casting_mesh")
+                .getMeshFrame();
+
+        // force and moment (about the mesh frame origin) in the mesh frame
+        Vec3 force = contact.getCastingTotalContactForce(s_analysis);
+        Vec3 moment = contact.getCastingTotalContactMoment(s_analysis);
+        Vec3 point(SimTK::NaN);
+        if(contact.getCastingTotalContactArea(s_analysis) > 0) {
+            // shift the moment to the center of pressure
+            Vec3 centerOfPressure =
+                contact.getCastingTotalCenterOfPressure(s_analysis);
+            moment -= centerOfPressure % force;
+            point = meshFrame.findStationLocationInGround(
+                s_analysis, centerOfPressure);
+        }
+
+        int I = 9*(numOutputJoints + i);
+        Vec3 forceInGround = meshFrame.expressVectorInGround(s_analysis, force);
+        Vec3 momentInGround =
+            meshFrame.expressVectorInGround(s_analysis, moment);
+        for(int j=0;j<3;j++) {
+            _Loads[I+j] = forceInGround[j];
+            _Loads[I+j+3] = momentInGround[j];
+            _Loads[I+j+6] = point[j];
+        }
+    }
+
     /* Write the reaction data to storage*/
     _storeReactionLoads.append(s.getTime(),_Loads.getSize(),&_Loads[0]);
 
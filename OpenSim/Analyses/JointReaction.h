@@ -39,6 +39,7 @@ namespace OpenSim {
 
 class Model;
 class Joint;
+class Smith2018ArticularContactForce;
 
 
 /**
@@ -52,6 +53,14 @@ class Joint;
  * any specified frame. The default behavior is the force on the child 
  * expressed in the ground frame.
  *
+ * The resultant loads of Smith2018ArticularContactForce components (e.g., the
+ * cartilage contact of a knee) can be reported along with the joint
+ * reactions (see contact_force_names). They are computed from the same
+ * realization of the model as the reactions, using the contact metrics the
+ * force already caches, so that no additional analysis is needed to obtain
+ * both. For each contact, the force acting on the casting mesh, its center
+ * of pressure, and the moment about that point are expressed in ground.
+ *
  * @author Matt DeMers, Ajay Seth
  * @version 1.0
  */
@@ -105,6 +114,11 @@ protected:
     PropertyStrArray _inFrameProp;
     Array<std::string> &_inFrame;
 
+    /** String Array containing the names of the articular contact forces
+    *   whose resultant loads are reported*/
+    PropertyStrArray _contactNamesProp;
+    Array<std::string> &_contactNames;
+
     //-----------------------------------------------------------------------
     // STORAGE
     //-----------------------------------------------------------------------
@@ -135,6 +149,9 @@ protected:
     *   desired joints, onBody, and inFrame to be output*/
     Array<JointReactionKey> _reactionList;
 
+    /** Internal work array of the contact forces to be output*/
+    Array<const Smith2018ArticularContactForce*> _contactList;
+
     bool _useForceStorage;
 
 //=============================================================================
@@ -180,6 +197,13 @@ public:
      /** Public accessors for the inFrame property */
     const Array<std::string>& getInFrame() const { return _inFrame; }
     void setInFrame( Array<std::string>& inFrame) { _inFrame = inFrame; }
+    /** Public accessors for the contact_force_names property */
+    const Array<std::string>& getContactForceNames() const {
+        return _contactNames;
+    }
+    void setContactForceNames(Array<std::string>& contactNames) {
+        _contactNames = contactNames;
+    }
 
     //-------------------------------------------------------------------------
     // INTEGRATION
@@ -204,6 +228,7 @@ protected:
     //========================== Internal Methods =============================
     int record(const SimTK::State& s );
     void setupReactionList();
+    void setupContactList();
     void constructDescription();
     void constructColumnLabels();
     void setupStorage();
@@ -28,6 +28,7 @@
 //=============================================================================
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/GeometryPath.h>
 #include "MuscleAnalysis.h"
 
 using namespace OpenSim;
@@ -429,6 +430,7 @@ void MuscleAnalysis::setModel(Model& aModel)
 {
     Super::setModel(aModel);
     allocateStorageObjects();
+    _momentArmSolver.reset();
 }
 //_____________________________________________________________________________
 /**
@@ -623,6 +625,30 @@ int MuscleAnalysis::record(const SimTK::State& s)
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+
+        // Solve for the moment arms of all muscles with a GeometryPath about
+        // all coordinates at once. Other paths compute their own.
+        std::vector<const Coordinate*> coords(nq);
+        for(int i=0; i<nq; i++) {
+            coords[i] = _momentArmStorageArray[i]->q;
+        }
+        std::vector<const GeometryPath*> paths;
+        Array<int> pathIndex(-1,nm);
+        for(int j=0; j<nm; j++) {
+            const GeometryPath* path = dynamic_cast<const GeometryPath*>(
+                    &_muscleArray[j]->getPath());
+            if (path) {
+                pathIndex[j] = (int)paths.size();
+                paths.push_back(path);
+            }
+        }
+        if (!_momentArmSolver) {
+            _momentArmSolver.reset(new MomentArmSolver(*_model));
+        }
+        const SimTK::Matrix pathMomentArms =
+                _momentArmSolver->solve(s, coords, paths);
+
         for(int i=0; i<nq; i++) {
 
             q = _momentArmStorageArray[i]->q;
@@ -631,10 +657,11 @@ int MuscleAnalysis::record(const SimTK::State& s)
            
             // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = (pathIndex[j] >= 0)
+                        ? pathMomentArms(i, pathIndex[j])
+                        : _muscleArray[j]->computeMomentArm(s,*q);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -30,6 +30,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
 #include "osimAnalysesDLL.h"
 
 
@@ -140,6 +141,11 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+#ifndef SWIG
+    /** Solver for the moment arms of all muscles with a GeometryPath. */
+    SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver>> _momentArmSolver;
+#endif
+
 //=============================================================================
 // METHODS
 //=============================================================================
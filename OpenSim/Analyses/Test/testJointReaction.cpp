@@ -0,0 +1,89 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  testJointReaction.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Analyses/JointReaction.h>
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Simulation/Test/ContactMeshesForTesting.h>
+
+#include <catch2/catch_all.hpp>
+
+using namespace OpenSim;
+using Catch::Approx;
+
+TEST_CASE("JointReaction reports articular contact loads") {
+    // A block welded to ground rests on a plate fixed to ground, with the
+    // cartilage of the block slightly penetrating the cartilage of the plate.
+    Model model;
+    const double mass = 2.0;
+    const PlateAndBlock plateAndBlock = addPlateAndBlock(model,
+            "testJointReaction", 10, mass, SimTK::Vec3(0.002, -0.0005, 0));
+    model.addJoint(new WeldJoint("weld", model.getGround(), SimTK::Vec3(0),
+            SimTK::Vec3(0), *plateAndBlock.block, SimTK::Vec3(0),
+            SimTK::Vec3(0)));
+    auto* contact = new Smith2018ArticularContactForce("contact",
+            *plateAndBlock.plate, *plateAndBlock.blockMesh);
+    model.addForce(contact);
+
+    JointReaction reaction;
+    reaction.setName("JointReaction");
+    Array<std::string> joints("weld", 1);
+    reaction.setJointNames(joints);
+    Array<std::string> contacts("All", 1);
+    reaction.setContactForceNames(contacts);
+
+    SimTK::State& state = model.initSystem();
+    reaction.setModel(model);
+    reaction.begin(state);
+    reaction.printResults("testJointReaction");
+
+    Storage loads("testJointReaction_JointReaction_ReactionLoads.sto");
+    const Array<std::string>& labels = loads.getColumnLabels();
+    REQUIRE(labels.getSize() == 1 + 9 + 9);
+    CHECK(labels[10] == "contact_on_block_cartilage_in_ground_fx");
+    const Array<double>& row = loads.getStateVector(0)->getData();
+    const SimTK::Vec3 jointForce(row[0], row[1], row[2]);
+    const SimTK::Vec3 contactForce(row[9], row[10], row[11]);
+    const SimTK::Vec3 contactMoment(row[12], row[13], row[14]);
+    const SimTK::Vec3 centerOfPressure(row[15], row[16], row[17]);
+
+    // The contact pushes the block up, at the center of the block's
+    // cartilage.
+    model.realizeAcceleration(state);
+    REQUIRE(contactForce[1] > 0);
+    CHECK(contactForce[1] == Approx(
+            contact->getCastingTotalContactForce(state)[1]).epsilon(1e-8));
+    CHECK(contactForce[0] == Approx(0).margin(1e-8 * contactForce[1]));
+    CHECK(contactForce[2] == Approx(0).margin(1e-8 * contactForce[1]));
+    CHECK(centerOfPressure[0] == Approx(0.002).margin(1e-6));
+    CHECK(centerOfPressure[1] == Approx(-0.0005).margin(1e-6));
+    CHECK(centerOfPressure[2] == Approx(0).margin(1e-6));
+    // A uniform pressure has no moment about its center.
+    CHECK(contactMoment.norm() == Approx(0).margin(1e-6 * contactForce[1]));
+
+    // The block does not move, so the weld, the contact and gravity are in
+    // equilibrium.
+    const SimTK::Vec3 weight = mass * model.getGravity();
+    for (int i = 0; i < 3; ++i) {
+        CHECK(jointForce[i] + contactForce[i] + weight[i] ==
+                Approx(0).margin(1e-8 * contactForce[1]));
+    }
+}
@@ -26,11 +26,13 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 #include <SimTKcommon/internal/Pathname.h>
 
@@ -69,6 +71,19 @@ std::string OpenSim::getFormattedDateTime(
     return ss.str();
 }
 
+int OpenSim::getMaxNumThreads() {
+    const std::string varName = "OPENSIM_MAX_THREADS";
+    if (SimTK::Pathname::environmentVariableExists(varName)) {
+        const std::string value =
+                SimTK::Pathname::getEnvironmentVariable(varName);
+        const int num = std::atoi(value.c_str());
+        if (num > 0) { return num; }
+        log_warn("OPENSIM_MAX_THREADS environment variable set to incorrect "
+                 "value '{}'; must be an integer >= 1. Ignoring.", value);
+    }
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
 SimTK::Vector OpenSim::createVectorLinspace(
         int length, double start, double end) {
     SimTK::Vector v(length);
@@ -55,6 +55,15 @@ OSIMCOMMON_API std::string getFormattedDateTime(
         bool appendMicroseconds = false,
         std::string format = "%Y-%m-%dT%H%M%S");
 
+/// Get the maximum number of threads that a tool should use: the value of the
+/// OPENSIM_MAX_THREADS environment variable if it is set to a positive
+/// integer, and the number of hardware threads (at least 1) otherwise.
+/// Tools that solve frames or simulations on multiple threads (e.g.,
+/// InverseKinematicsTool, ForsimEnsembleTool) use no more threads than this,
+/// whatever their own settings, as does the parsing of large data files.
+/// @ingroup commonutil
+OSIMCOMMON_API int getMaxNumThreads();
+
 /// When an instance of this class is destructed, it removes (deletes)
 /// the file at the path provided in the constructor. You can also manually
 /// cause removal of the file by invoking `remove()`.
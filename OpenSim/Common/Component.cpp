@@ -128,6 +128,17 @@ Component::Component(SimTK::Xml::Element& element) : Object(element)
     constructProperty_components();
 }
 
+Component::~Component()
+{
+    // The path index of the root may refer to this component.
+    markComponentTreeChanged();
+}
+
+void Component::markComponentTreeChanged()
+{
+    if (_treeVersion) { ++*_treeVersion; }
+}
+
 bool Component::isComponentInOwnershipTree(const Component* subcomponent) const {
     //get to the root Component
     const Component* root = this;
@@ -335,6 +346,71 @@ void Component::finalizeConnections(Component& root)
     // Forming connections changes the Socket which is a property
     // Remark as upToDate.
     setObjectIsUpToDateWithProperties();
+
+    // The tree is now complete, so index it for path lookups.
+    if (&root == this) {
+        buildComponentPathIndex();
+    }
+}
+
+void Component::buildComponentPathIndex()
+{
+    ComponentPathIndex& index = _componentPathIndex;
+    index.components.clear();
+    // The components of this tree share a new version, so that changes to
+    // other trees, or to components that have since left this tree, do not
+    // invalidate the index.
+    const auto version = std::make_shared<unsigned long long>(0);
+    _treeVersion = version;
+    for (const auto& comp : getComponentList<Component>()) {
+        const_cast<Component&>(comp)._treeVersion = version;
+        std::string path = comp.getAbsolutePathString();
+        // Also index the path relative to this (root) component.
+        index.components.emplace(path.substr(1), &comp);
+        index.components.emplace(std::move(path), &comp);
+    }
+    index.treeVersion = *version;
+}
+
+const Component* Component::findIndexedComponent(
+        const std::string& pathname) const
+{
+    if (pathname.empty()) { return nullptr; }
+
+    const Component* indexOwner = this;
+    if (pathname[0] == '/') {
+        indexOwner = &getRoot();
+    } else if (hasOwner()) {
+        return nullptr;
+    }
+
+    const ComponentPathIndex& index = indexOwner->_componentPathIndex;
+    const std::shared_ptr<unsigned long long>& version =
+            indexOwner->_treeVersion;
+    if (!version || index.treeVersion != *version) { return nullptr; }
+    const auto it = index.components.find(pathname);
+    if (it == index.components.end()) { return nullptr; }
+
+    // Ignore the entry if the component or any of its owners has been
+    // renamed since: the names from the component up to the root must still
+    // spell out the path.
+    const Component* comp = it->second;
+    const Component* c = comp;
+    size_t end = pathname.size();
+    for (; c->hasOwner(); c = &c->getOwner()) {
+        const std::string& name = c->getName();
+        if (end < name.size() ||
+                pathname.compare(end - name.size(), name.size(), name) != 0) {
+            return nullptr;
+        }
+        end -= name.size();
+        if (end > 0) {
+            if (pathname[end - 1] != '/') { return nullptr; }
+            --end;
+        }
+    }
+    if (c != indexOwner || end != 0) { return nullptr; }
+    return comp;
 }
 
 // invoke connect on all (sub)components of this component
@@ -1360,6 +1436,7 @@ void Component::markPropertiesAsSubcomponents()
     // or the properties have been modified. In the latter case
     // we must make sure that pointers to old properties are cleared
     _propertySubcomponents.clear();
+    markComponentTreeChanged();
 
     // Now mark properties that are Components as subcomponents
     //loop over all its properties
@@ -1415,6 +1492,7 @@ void Component::markAsPropertySubcomponent(const Component* component)
         // otherwise it will copy and reset the Component pointer to null.
         _propertySubcomponents.push_back(
             SimTK::ReferencePtr<Component>(const_cast<Component*>(component)));
+        markComponentTreeChanged();
     }
     else{
         auto compPath = component->getAbsolutePathString();
@@ -1449,6 +1527,7 @@ void Component::adoptSubcomponent(Component* subcomponent)
 
     subcomponent->setOwner(*this);
     _adoptedSubcomponents.push_back(SimTK::ClonePtr<Component>(subcomponent));
+    markComponentTreeChanged();
 }
 
 std::vector<SimTK::ReferencePtr<const Component>>
@@ -2098,6 +2177,7 @@ void Component::reset()
     _propertySubcomponents.clear();
     _adoptedSubcomponents.clear();
     resetSubcomponentOrder();
+    markComponentTreeChanged();
 }
 
 void Component::warnBeforePrint() const {
@@ -497,7 +497,7 @@ public:
     Component& operator=(const Component&) = default;
 
     /** Destructor is virtual to allow concrete Component to cleanup. **/
-    virtual ~Component() = default;
+    virtual ~Component();
 
     /** @name Component Structural Interface
     The structural interface ensures that deserialization, resolution of
@@ -796,6 +796,9 @@ public:
     bool hasComponent(const std::string& pathname) const {
         static_assert(std::is_base_of<Component, C>::value,
             "Template parameter 'C' must be derived from Component.");
+        if (dynamic_cast<const C*>(findIndexedComponent(pathname))) {
+            return true;
+        }
         const C* comp = this->template traversePathToComponent<C>({pathname});
         return comp != nullptr;
     }
@@ -822,6 +825,10 @@ public:
      */
     template <class C = Component>
     const C& getComponent(const std::string& pathname) const {
+        if (const C* comp =
+                dynamic_cast<const C*>(findIndexedComponent(pathname))) {
+            return *comp;
+        }
         return getComponent<C>(ComponentPath(pathname));
     }
     template <class C = Component>
@@ -873,7 +880,8 @@ public:
     */
     template <class C = Component>
     C& updComponent(const std::string& name) {
-        return updComponent<C>(ComponentPath(name));
+        clearObjectIsUpToDateWithProperties();
+        return *const_cast<C*>(&(this->template getComponent<C>(name)));
     }
     template <class C = Component>
     C& updComponent(const ComponentPath& name) {
@@ -3561,6 +3569,15 @@ protected:
 
     const Component* traversePathToComponent(const ComponentPath&) const;
 
+    /** Look up a subcomponent in the path index that the root component
+    builds at the end of finalizeConnections(). Absolute paths are looked up
+    in the root's index, and relative paths only if this is the root. Returns
+    nullptr if the path is not indexed or if a component of the tree has
+    been restructured (e.g., finalizeFromProperties()) since the index was
+    built;
+    callers then fall back to traversePathToComponent(). */
+    const Component* findIndexedComponent(const std::string& pathname) const;
+
     template<class C>
     const C* traversePathToComponent(const ComponentPath& path) const
     {
@@ -3833,6 +3850,13 @@ private:
     //also mark it by calling markAsPropertySubcomponent() with that component.
     void markPropertiesAsSubcomponents();
 
+    // Populate _componentPathIndex with all of this Component's subcomponents.
+    void buildComponentPathIndex();
+
+    // Invalidate the path index of the root of the tree that this Component
+    // belonged to when the index was built.
+    void markComponentTreeChanged();
+
     // Internal use: mark as a subcomponent, a component that is owned by this
     // Component by virtue of being one of its properties.
     void markAsPropertySubcomponent(const Component* subcomponent);
@@ -4058,6 +4082,20 @@ private:
     // list of subcomponents that are contained in this Component's properties
     SimTK::ResetOnCopy<SimTK::Array_<SimTK::ReferencePtr<Component>>>
         _propertySubcomponents;
+
+    // Index of all subcomponents by absolute path ("/a/b") and by path
+    // relative to this component ("a/b"). Only the root component populates
+    // it, at the end of finalizeConnections(). `treeVersion` records the
+    // version of the tree at that time; the index is ignored once a
+    // component in the tree has been restructured or destroyed.
+    struct ComponentPathIndex {
+        std::unordered_map<std::string, const Component*> components;
+        unsigned long long treeVersion = 0;
+    };
+    SimTK::ResetOnCopy<ComponentPathIndex> _componentPathIndex;
+    // The version of the structure of the tree whose root last indexed this
+    // Component, shared by all components of that tree.
+    SimTK::ResetOnCopy<std::shared_ptr<unsigned long long>> _treeVersion;
     // Keep fixed list of data member Components upon construction
     SimTK::Array_<SimTK::ClonePtr<Component> > _memberSubcomponents;
     // Hold onto adopted components
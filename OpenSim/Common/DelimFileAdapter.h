@@ -144,6 +144,25 @@ private:
     template<int M>
     static inline std::string dataTypeName_impl(SimTK::Vec<M>);
 
+    /** Following overloads read the data rows that follow the column labels
+    into timeVec and matrix. Tables of double are parsed with
+    FileAdapter::parseRows(); other element types are read line by line.     */
+    template<typename U>
+    void readRows_impl(std::istream& in_stream,
+                       const std::string& fileName,
+                       size_t& line_num,
+                       size_t numColumns,
+                       std::vector<double>& timeVec,
+                       SimTK::Matrix_<T>& matrix,
+                       U) const;
+    void readRows_impl(std::istream& in_stream,
+                       const std::string& fileName,
+                       size_t& line_num,
+                       size_t numColumns,
+                       std::vector<double>& timeVec,
+                       SimTK::Matrix_<T>& matrix,
+                       double) const;
+
     /** Following overloads implement readElems().                            */
     inline SimTK::RowVector_<double>
     readElems_impl(const std::vector<std::string>& tokens,
@@ -409,15 +428,47 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
 
+    // Read the data rows.
+    std::vector<double> timeVec;
+    SimTK::Matrix_<T> matrix;
+    readRows_impl(in_stream, fileName, line_num, column_labels.size(),
+            timeVec, matrix, T{});
+
+    // Create the table and update other metadata from above
+    auto table = 
+        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
+    table->updTableMetaData() = keyValuePairs;
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+
+    return output_tables;
+}
+
+template<typename T>
+template<typename U>
+void
+DelimFileAdapter<T>::readRows_impl(std::istream& in_stream,
+                                   const std::string& fileName,
+                                   size_t& line_num,
+                                   size_t numColumns,
+                                   std::vector<double>& timeVec,
+                                   SimTK::Matrix_<T>& matrix,
+                                   U) const {
+    // Callable to get the next line in form of vector of tokens.
+    auto nextLine = [&] {
+        return getNextLine(in_stream, _delimitersRead);
+    };
+
     // Read the rows one at a time and fill up the time column container and
     // the data container. Start with a reasonable initial capacity for
     // tradeoff between a small file and larger files. 100 worked well for
     // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
+    timeVec.clear();
     int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
+    int ncol = static_cast<int>(numColumns);
     timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
+    matrix.resize(initCapacity, ncol);
     
     // Initialize current row and capacity
     int curCapacity = initCapacity;
@@ -442,11 +493,11 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
 
         auto row_vector = readElems(row);
 
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
+        OPENSIM_THROW_IF(row_vector.size() != ncol,
             RowLengthMismatch,
             fileName,
             line_num,
-            column_labels.size(),
+            numColumns,
             static_cast<size_t>(row_vector.size()));
         
         matrix.updRow(curRow) = std::move(row_vector);
@@ -458,16 +509,31 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     // Resize the matrix down to the correct number of rows.
     // This is necessary until Simbody issue #401 is addressed.
     matrix.resizeKeep(curRow, ncol);
+}
 
-    // Create the table and update other metadata from above
-    auto table = 
-        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
-    table->updTableMetaData() = keyValuePairs;
-
-    OutputTables output_tables{};
-    output_tables.emplace(tableString(), table);
-
-    return output_tables;
+template<typename T>
+void
+DelimFileAdapter<T>::readRows_impl(std::istream& in_stream,
+                                   const std::string& fileName,
+                                   size_t& line_num,
+                                   size_t numColumns,
+                                   std::vector<double>& timeVec,
+                                   SimTK::Matrix_<T>& matrix,
+                                   double) const {
+    // Read the rest of the file at once and parse it (concurrently, for
+    // large files) rather than tokenizing one line at a time.
+    std::vector<double> values;
+    parseRows(readRemaining(in_stream), 0, _delimitersRead, numColumns,
+            fileName, line_num + 1, timeVec, values);
+    line_num += timeVec.size();
+
+    const int nrow = static_cast<int>(timeVec.size());
+    const int ncol = static_cast<int>(numColumns);
+    matrix.resize(nrow, ncol);
+    for (int r = 0; r < nrow; ++r) {
+        const double* row = values.data() + r * numColumns;
+        for (int c = 0; c < ncol; ++c) { matrix(r, c) = row[c]; }
+    }
 }
 
 template<typename T>
@@ -23,7 +23,7 @@
 
 #include "ExpressionBasedFunction.h"
 
-#include <lepton/ExpressionProgram.h>
+#include <lepton/CompiledExpression.h>
 #include <lepton/ParsedExpression.h>
 #include <lepton/Parser.h>
 #include <lepton/Exception.h>
@@ -46,48 +46,48 @@ public:
             }
         }
 
-        // Create the expression programs for the value and its derivatives.
+        // Compile the expressions for the value and its derivatives.
         Lepton::ParsedExpression parsedExpression = 
                 Lepton::Parser::parse(m_expression).optimize();
-        m_valueProgram = parsedExpression.createProgram();
+        m_valueExpression = parsedExpression.createCompiledExpression();
 
         for (int i = 0; i < static_cast<int>(m_variables.size()); ++i) {
             Lepton::ParsedExpression diffExpression = 
                     parsedExpression.differentiate(m_variables[i]).optimize();
-            m_derivativePrograms.push_back(diffExpression.createProgram());
+            m_derivativeExpressions.push_back(
+                    diffExpression.createCompiledExpression());
         }
 
-        try {
-            std::map<std::string, double> vars;
-            for (int i = 0; i < static_cast<int>(m_variables.size()); ++i) {
-                vars[m_variables[i]] = 0;
-            }
-            m_valueProgram.evaluate(vars);
-
-            for (int i = 0; i < static_cast<int>(m_variables.size()); ++i) {
-                m_derivativePrograms[i].evaluate(vars);
-            }
-        } catch (Lepton::Exception& ex) {
-            std::string msg = ex.what();
-            if (msg.compare(0, 30, "No value specified for variable")) { 
-                std::string undefinedVar = msg.substr(32, msg.size() - 32);
+        for (const auto& variable : m_valueExpression.getVariables()) {
+            if (!uniqueVariables.count(variable)) {
                 OPENSIM_THROW(Exception, 
                         fmt::format("Variable '{}' is not defined. Use "
                         "setVariables() to explicitly define this variable. "
-                        "Or, remove it from the expression.", undefinedVar));
-            } else {
-                OPENSIM_THROW(Exception, "Lepton parsing error: {}", msg);
+                        "Or, remove it from the expression.", variable));
             }
         }
+
+        bindVariables();
+    }
+
+    // The variable references point into the workspace of the compiled
+    // expressions they were taken from, so copies must rebind them.
+    SimTKExpressionBasedFunction(const SimTKExpressionBasedFunction& other) :
+            SimTK::Function(other),
+            m_expression(other.m_expression),
+            m_variables(other.m_variables),
+            m_valueExpression(other.m_valueExpression),
+            m_derivativeExpressions(other.m_derivativeExpressions) {
+        bindVariables();
     }
 
+    SimTKExpressionBasedFunction& operator=(
+            const SimTKExpressionBasedFunction&) = delete;
+
     SimTK::Real calcValue(const SimTK::Vector& x) const override {
         OPENSIM_ASSERT(x.size() == static_cast<int>(m_variables.size()));
-        std::map<std::string, double> vars;
-        for (int i = 0; i < static_cast<int>(m_variables.size()); ++i) {
-            vars[m_variables[i]] = x[i];
-        }
-        return m_valueProgram.evaluate(vars);
+        setVariables(m_valueRefs, x);
+        return m_valueExpression.evaluate();
     }
 
     SimTK::Real calcDerivative(const SimTK::Array_<int>& derivComponents, 
@@ -95,11 +95,8 @@ public:
         OPENSIM_ASSERT(x.size() == static_cast<int>(m_variables.size()));
         OPENSIM_ASSERT(derivComponents.size() == 1);
         if (derivComponents[0] < static_cast<int>(m_variables.size())) {
-            std::map<std::string, double> vars;
-            for (int i = 0; i < static_cast<int>(m_variables.size()); ++i) {
-                vars[m_variables[i]] = x[i];
-            }
-            return m_derivativePrograms[derivComponents[0]].evaluate(vars);
+            setVariables(m_derivativeRefs[derivComponents[0]], x);
+            return m_derivativeExpressions[derivComponents[0]].evaluate();
         }
         return 0.0;
     }
@@ -113,10 +110,43 @@ public:
     }
 
 private:
+    // For each variable, the slot in the compiled expression that holds its
+    // value, or nullptr if the expression does not depend on the variable.
+    using VariableRefs = std::vector<double*>;
+
+    static VariableRefs bindVariables(Lepton::CompiledExpression& expression,
+            const std::vector<std::string>& variables) {
+        VariableRefs refs(variables.size(), nullptr);
+        const auto& used = expression.getVariables();
+        for (int i = 0; i < static_cast<int>(variables.size()); ++i) {
+            if (used.count(variables[i])) {
+                refs[i] = &expression.getVariableReference(variables[i]);
+            }
+        }
+        return refs;
+    }
+
+    void bindVariables() {
+        m_valueRefs = bindVariables(m_valueExpression, m_variables);
+        m_derivativeRefs.clear();
+        for (auto& expression : m_derivativeExpressions) {
+            m_derivativeRefs.push_back(bindVariables(expression, m_variables));
+        }
+    }
+
+    static void setVariables(const VariableRefs& refs, 
+            const SimTK::Vector& x) {
+        for (int i = 0; i < static_cast<int>(refs.size()); ++i) {
+            if (refs[i]) *refs[i] = x[i];
+        }
+    }
+
     std::string m_expression;
     std::vector<std::string> m_variables;
-    Lepton::ExpressionProgram m_valueProgram;
-    std::vector<Lepton::ExpressionProgram> m_derivativePrograms;
+    Lepton::CompiledExpression m_valueExpression;
+    std::vector<Lepton::CompiledExpression> m_derivativeExpressions;
+    VariableRefs m_valueRefs;
+    std::vector<VariableRefs> m_derivativeRefs;
 };
 
 SimTK::Function* ExpressionBasedFunction::createSimTKFunction() const {
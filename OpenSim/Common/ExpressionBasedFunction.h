@@ -46,6 +46,10 @@ namespace OpenSim {
  * sqrt, exp, log, sin, cos, sec, csc, tan, cot, asin, acos, atan, sinh, cosh, 
  * tanh, erf, erfc, step, delta, square, cube, recip, min, max, abs, +, -, *, /, 
  * and ^. 
+ *
+ * @note The expression is compiled when createSimTKFunction() is called. The 
+ * returned SimTK::Function must not be evaluated from multiple threads at the 
+ * same time; give each thread its own copy instead.
  */
 class OSIMCOMMON_API ExpressionBasedFunction : public Function {
     OpenSim_DECLARE_CONCRETE_OBJECT(ExpressionBasedFunction, Function);
@@ -1,6 +1,13 @@
 #include "FileAdapter.h"
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
+#include "CommonUtilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <future>
+#include <sstream>
 
 namespace OpenSim {
 
@@ -80,6 +87,175 @@ FileAdapter::getNextLine(std::istream& stream,
     return {};
 }
 
+std::string
+FileAdapter::readRemaining(std::istream& stream) {
+    std::ostringstream buffer;
+    if (stream.peek() != std::istream::traits_type::eof())
+        buffer << stream.rdbuf();
+    return buffer.str();
+}
+
+namespace {
+// Inputs smaller than this are parsed on the calling thread.
+constexpr size_t minCharsForConcurrentParsing = 1 << 20;
+
+// Number of blocks to split `numItems` items into, given that each block
+// should contain at least `minItemsPerBlock` items.
+size_t getNumBlocks(size_t numChars, size_t numItems, size_t minItemsPerBlock) {
+    if (numChars < minCharsForConcurrentParsing) return 1;
+    const size_t numThreads = static_cast<size_t>(getMaxNumThreads());
+    return std::max<size_t>(1,
+            std::min(numThreads, numItems / minItemsPerBlock));
+}
+}
+
+void
+FileAdapter::parseRows(const std::string& text, size_t offset,
+                       const std::string& delims, size_t numColumns,
+                       const std::string& fileName, size_t firstLineNumber,
+                       std::vector<double>& times,
+                       std::vector<double>& values) {
+    // Find the lines, up to the first empty one.
+    std::vector<std::pair<size_t, size_t>> lines;
+    size_t pos = offset;
+    while (pos < text.size()) {
+        const size_t newline = text.find('\n', pos);
+        size_t end = newline == std::string::npos ? text.size() : newline;
+        // Get rid of the extra \r if parsing a file with CRLF line endings.
+        if (end > pos && text[end - 1] == '\r') --end;
+        if (end == pos) break;
+        lines.emplace_back(pos, end);
+        if (newline == std::string::npos) break;
+        pos = newline + 1;
+    }
+
+    std::array<bool, 256> isDelim{};
+    for (const char c : delims) isDelim[static_cast<unsigned char>(c)] = true;
+
+    times.resize(lines.size());
+    values.resize(lines.size() * numColumns);
+
+    // Split each line into fields the same way tokenize() does.
+    const auto parseBlock = [&](size_t beginLine, size_t endLine) {
+        for (size_t i = beginLine; i < endLine; ++i) {
+            const char* first = text.data() + lines[i].first;
+            const char* last = text.data() + lines[i].second;
+            double* rowValues = values.data() + i * numColumns;
+            size_t numFields = 0;
+            const auto addField = [&](const char* begin, const char* end) {
+                if (numFields == 0)
+                    times[i] = IO::stod(begin, end);
+                else if (numFields <= numColumns)
+                    rowValues[numFields - 1] = IO::stod(begin, end);
+                ++numFields;
+            };
+            const char* fieldBegin = first;
+            for (const char* c = first; c != last; ++c) {
+                if (isDelim[static_cast<unsigned char>(*c)]) {
+                    addField(fieldBegin, c);
+                    fieldBegin = c + 1;
+                }
+            }
+            if (fieldBegin != last) addField(fieldBegin, last);
+
+            OPENSIM_THROW_IF(numFields != numColumns + 1,
+                             RowLengthMismatch,
+                             fileName,
+                             firstLineNumber + i,
+                             numColumns,
+                             numFields - 1);
+        }
+    };
+
+    const size_t numBlocks = getNumBlocks(text.size() - offset, lines.size(),
+            /* minItemsPerBlock */ 256);
+    if (numBlocks == 1) {
+        parseBlock(0, lines.size());
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t b = 0; b < numBlocks; ++b) {
+        futures.push_back(std::async(std::launch::async, parseBlock,
+                b * lines.size() / numBlocks,
+                (b + 1) * lines.size() / numBlocks));
+    }
+    // Rethrow the error (if any) from the earliest block.
+    for (auto& future : futures) future.get();
+}
+
+size_t
+FileAdapter::parseNumbers(const std::string& text, size_t offset,
+                          size_t count, std::vector<double>& values) {
+    struct Block {
+        std::vector<double> values;
+        size_t numValid = std::string::npos;
+    };
+    const auto isSpace = [](char c) {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    };
+    // Parse all the numbers in [begin, end), stopping after `maxValues`.
+    const auto parseBlock = [&](size_t begin, size_t end, size_t maxValues) {
+        Block block;
+        const char* c = text.data() + begin;
+        const char* last = text.data() + end;
+        while (block.values.size() < maxValues) {
+            while (c != last && isSpace(*c)) ++c;
+            if (c == last) break;
+            const char* token = c;
+            while (c != last && !isSpace(*c)) ++c;
+            double value;
+            if (!IO::TryParseDouble(token, c, value) &&
+                    block.numValid == std::string::npos)
+                block.numValid = block.values.size();
+            block.values.push_back(value);
+        }
+        if (block.numValid == std::string::npos)
+            block.numValid = block.values.size();
+        return block;
+    };
+
+    // Split the text at whitespace into blocks of roughly equal size.
+    const size_t numBlocks = getNumBlocks(text.size() - offset,
+            text.size() - offset, minCharsForConcurrentParsing / 4);
+    std::vector<size_t> bounds{offset};
+    for (size_t b = 1; b < numBlocks; ++b) {
+        size_t bound = std::max(bounds.back(),
+                offset + b * (text.size() - offset) / numBlocks);
+        while (bound < text.size() && !isSpace(text[bound])) ++bound;
+        bounds.push_back(bound);
+    }
+    bounds.push_back(text.size());
+
+    std::vector<Block> blocks;
+    if (numBlocks == 1) {
+        blocks.push_back(parseBlock(offset, text.size(), count));
+    } else {
+        std::vector<std::future<Block>> futures;
+        for (size_t b = 0; b < numBlocks; ++b) {
+            futures.push_back(std::async(std::launch::async, parseBlock,
+                    bounds[b], bounds[b + 1], count));
+        }
+        for (auto& future : futures) blocks.push_back(future.get());
+    }
+
+    // Concatenate the blocks, keeping track of the first failure.
+    values.assign(count, SimTK::NaN);
+    size_t numValues = 0;
+    size_t numValid = std::string::npos;
+    for (const auto& block : blocks) {
+        if (numValid == std::string::npos &&
+                block.numValid < block.values.size())
+            numValid = numValues + block.numValid;
+        const size_t n = std::min(block.values.size(), count - numValues);
+        std::copy_n(block.values.begin(), n, values.begin() + numValues);
+        numValues += n;
+        if (numValues == count) break;
+    }
+    if (numValid == std::string::npos || numValid > numValues)
+        numValid = numValues;
+    return numValid;
+}
+
 std::shared_ptr<DataAdapter>
 FileAdapter::createAdapterFromExtension(const std::string& fileName) {
     auto extension = FileAdapter::findExtension(fileName);
@@ -213,6 +213,34 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+    /** Read the rest of the stream into a string.                            */
+    static std::string readRemaining(std::istream& stream);
+
+    /** Parse rows of numbers, one row per line, from `text` starting at
+    character `offset`. Each row is a time followed by `numColumns` values,
+    separated by any of the characters in `delims` (as in tokenize()). The
+    rows end at the first empty line or at the end of the text. The times are
+    returned in `times` and the values, row by row, in `values`. Fields are
+    converted with IO::stod(), and large inputs are split into blocks of lines
+    that are parsed concurrently. `firstLineNumber` is the line number of the
+    first row in the file, used in error messages.
+
+    \throws RowLengthMismatch If a row does not have numColumns values.      */
+    static void parseRows(const std::string& text, size_t offset,
+            const std::string& delims, size_t numColumns,
+            const std::string& fileName, size_t firstLineNumber,
+            std::vector<double>& times, std::vector<double>& values);
+
+    /** Parse `count` numbers separated by whitespace (including newlines)
+    from `text` starting at character `offset`, into `values`. Large inputs
+    are parsed concurrently. Fields that are not numbers, and values missing
+    because the text ends early, are NaN. Nothing is logged.
+
+    \returns The number of values that were read successfully before the
+             first failure.                                                   */
+    static size_t parseNumbers(const std::string& text, size_t offset,
+            size_t count, std::vector<double>& values);
     /** Create a concerte FileAdapter based on the extension of the passed in file and return it.
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
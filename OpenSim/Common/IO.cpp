@@ -30,6 +30,8 @@
 #include "IO.h"
 
 #include "Logger.h"
+#include <cctype>
+#include <cfloat>
 #include <climits>
 #include <limits>
 #include <math.h>
@@ -496,7 +498,113 @@ OpenOutputFile(const string &aFileName,ios_base::openmode mode)
 double IO::
 stod(const std::string& __str, std::size_t* __idx)
 { 
-    std::istringstream iss(__str);
+    return stod(__str.data(), __str.data() + __str.size());
+}
+
+double IO::
+stod(const char* first, const char* last)
+{
+    double result;
+    if (!TryParseDouble(first, last, result)) {
+        log_warn("Encountered non-numeric string value: {} ; parsed value:{}",
+                std::string(first, last), result);
+    }
+    return result;
+}
+
+namespace {
+// Convert a plain decimal number that spans all of [first, last) exactly,
+// using the fact that integers up to 2^53 and powers of ten up to 1e22 are
+// exactly representable as doubles, so a single multiplication or division
+// rounds correctly (Clinger's fast path). Returns false for anything else
+// (e.g., too many digits, large exponents, "nan", trailing characters), which
+// the caller then hands to a stream.
+bool tryParsePlainDecimal(const char* first, const char* last,
+        double& result) {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    // Extended-precision intermediates would round twice.
+    return false;
+#else
+    static const double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+            1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+            1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    unsigned long long mantissa = 0;
+    int numSignificantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+        anyDigits = true;
+        if (mantissa == 0 && *p == '0') continue;
+        if (++numSignificantDigits > 19) return false;
+        mantissa = 10 * mantissa + (*p - '0');
+    }
+    if (p != last && *p == '.') {
+        ++p;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+            anyDigits = true;
+            --exponent;
+            if (mantissa == 0 && *p == '0') continue;
+            if (++numSignificantDigits > 19) return false;
+            mantissa = 10 * mantissa + (*p - '0');
+        }
+    }
+    if (!anyDigits) return false;
+
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p != last && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (p == last) return false;
+        int explicitExponent = 0;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+            if (explicitExponent > 1000) return false;
+            explicitExponent = 10 * explicitExponent + (*p - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (p != last) return false;
+
+    if (mantissa == 0) {
+        result = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (mantissa > (1ULL << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0) value /= powersOfTen[-exponent];
+    else value *= powersOfTen[exponent];
+    result = negative ? -value : value;
+    return true;
+#endif
+}
+}
+
+bool IO::
+TryParseDouble(const char* first, const char* last, double& result)
+{
+    // Skip the surrounding whitespace that a stream would skip (leading) or
+    // ignore (trailing).
+    while (first != last && std::isspace(static_cast<unsigned char>(*first)))
+        ++first;
+    const char* end = last;
+    while (end != first &&
+            std::isspace(static_cast<unsigned char>(*(end - 1))))
+        --end;
+    if (tryParsePlainDecimal(first, end, result)) return true;
+
+    std::istringstream iss(std::string(first, last));
 
     // Always parse numbers with "C" locale, which uses a period character
     // for the decimal place. Otherwise, Finns, Dutch, and other locales
@@ -504,13 +612,12 @@ stod(const std::string& __str, std::size_t* __idx)
     // issues (#3943, #3924).
     iss.imbue(std::locale::classic());
 
-    double result;
     iss >> result;
     if (iss.fail()) {
         result = std::numeric_limits<double>::quiet_NaN();
-        log_warn("Encountered non-numeric string value: {} ; parsed value:{}",__str, result);
+        return false;
     }
-    return result;
+    return true;
 }
 //_____________________________________________________________________________
 /**
@@ -90,6 +90,15 @@ public:
     static std::ifstream* OpenInputFile(const std::string &aFileName,std::ios_base::openmode mode=std::ios_base::in);
     static std::ofstream* OpenOutputFile(const std::string &aFileName,std::ios_base::openmode mode=std::ios_base::out);
     static double stod(const std::string& __str, std::size_t* __idx = 0);
+    /// Same as stod(const std::string&) for the characters [first, last).
+    static double stod(const char* first, const char* last);
+    /// Parse the number at the start of the characters [first, last) using
+    /// the "C" locale, as stod() does, but without logging a warning. If the
+    /// characters do not start with a number, `result` is set to NaN and
+    /// false is returned. Plain decimal numbers (e.g., "-1.25e-3") with up to
+    /// 19 significant digits are converted without a stream.
+    static bool TryParseDouble(const char* first, const char* last,
+            double& result);
 #endif
     // Directory management
     static int makeDir(const std::string &aDirName);
@@ -0,0 +1,367 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  STBFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "STBFileAdapter.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace OpenSim {
+
+const std::string STBFileAdapter::_table{"table"};
+
+namespace {
+    const char magic[8] = {'O', 'S', 'I', 'M', 'S', 'T', 'B', '\0'};
+    const std::uint32_t formatVersion = 1;
+    const std::uint32_t byteOrderMark = 0x01020304;
+    // Size of the fixed part of the header (magic through data offset).
+    const std::uint64_t fixedHeaderSize = 40;
+    // The data block starts at a multiple of this many bytes.
+    const std::uint64_t dataAlignment = 64;
+
+    // Reads the variable-length part of the header, checking every access
+    // against the end of the header.
+    class HeaderReader {
+    public:
+        HeaderReader(const std::string& fileName, const char* begin,
+                const char* end) :
+                _fileName(fileName), _pos(begin), _end(end) {}
+
+        std::uint64_t readUInt64() {
+            std::uint64_t value;
+            std::memcpy(&value, take(sizeof(value)), sizeof(value));
+            return value;
+        }
+        std::string readString() {
+            const std::uint64_t length = readUInt64();
+            OPENSIM_THROW_IF(length > std::uint64_t(_end - _pos), IOError,
+                    "STB file '" + _fileName + "' has a truncated header.");
+            return std::string(take(length), length);
+        }
+
+    private:
+        const char* take(std::uint64_t numBytes) {
+            OPENSIM_THROW_IF(numBytes > std::uint64_t(_end - _pos), IOError,
+                    "STB file '" + _fileName + "' has a truncated header.");
+            const char* data = _pos;
+            _pos += numBytes;
+            return data;
+        }
+
+        const std::string& _fileName;
+        const char* _pos;
+        const char* _end;
+    };
+
+    void writeUInt64(std::string& buffer, std::uint64_t value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    void writeString(std::string& buffer, const std::string& value) {
+        writeUInt64(buffer, value.size());
+        buffer.append(value);
+    }
+}
+
+//=============================================================================
+// STBFileView
+//=============================================================================
+// Read-only mapping of an entire file into memory.
+class STBFileView::Mapping {
+public:
+    explicit Mapping(const std::string& fileName) {
+#ifdef _WIN32
+        _file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OPENSIM_THROW_IF(_file == INVALID_HANDLE_VALUE, FileDoesNotExist,
+                fileName);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size)) {
+            CloseHandle(_file);
+            OPENSIM_THROW(IOError, "Could not get the size of '" + fileName +
+                                           "'.");
+        }
+        _size = static_cast<size_t>(size.QuadPart);
+        if (_size == 0) return;
+        _mapping = CreateFileMappingA(
+                _file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping != nullptr) {
+            _data = static_cast<const char*>(
+                    MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (_data == nullptr) {
+            if (_mapping != nullptr) CloseHandle(_mapping);
+            CloseHandle(_file);
+            OPENSIM_THROW(IOError, "Could not map '" + fileName +
+                                           "' into memory.");
+        }
+#else
+        const int fd = open(fileName.c_str(), O_RDONLY);
+        OPENSIM_THROW_IF(fd < 0, FileDoesNotExist, fileName);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            OPENSIM_THROW(IOError, "Could not get the size of '" + fileName +
+                                           "'.");
+        }
+        _size = static_cast<size_t>(info.st_size);
+        if (_size > 0) {
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                OPENSIM_THROW(IOError, "Could not map '" + fileName +
+                                               "' into memory.");
+            }
+            _data = static_cast<const char*>(data);
+        }
+        // The mapping keeps its own reference to the file.
+        close(fd);
+#endif
+    }
+
+    ~Mapping() {
+#ifdef _WIN32
+        if (_data != nullptr) UnmapViewOfFile(_data);
+        if (_mapping != nullptr) CloseHandle(_mapping);
+        CloseHandle(_file);
+#else
+        if (_data != nullptr) munmap(const_cast<char*>(_data), _size);
+#endif
+    }
+
+    const char* getData() const { return _data; }
+    size_t getSize() const { return _size; }
+
+private:
+    const char* _data{nullptr};
+    size_t _size{0};
+#ifdef _WIN32
+    HANDLE _file{INVALID_HANDLE_VALUE};
+    HANDLE _mapping{nullptr};
+#endif
+};
+
+STBFileView::STBFileView(const std::string& fileName) {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    _mapping.reset(new Mapping(fileName));
+    const char* data = _mapping->getData();
+    const size_t size = _mapping->getSize();
+
+    OPENSIM_THROW_IF(size < fixedHeaderSize ||
+                             std::memcmp(data, magic, sizeof(magic)) != 0,
+            IOError, "'" + fileName + "' is not an STB file.");
+
+    std::uint32_t version, byteOrder;
+    std::memcpy(&version, data + 8, sizeof(version));
+    std::memcpy(&byteOrder, data + 12, sizeof(byteOrder));
+    OPENSIM_THROW_IF(byteOrder != byteOrderMark, IOError,
+            "STB file '" + fileName + "' was written on a machine with a "
+            "different byte order.");
+    OPENSIM_THROW_IF(version != formatVersion, IOError,
+            "STB file '" + fileName + "' has format version " +
+                    std::to_string(version) + " but only version " +
+                    std::to_string(formatVersion) + " is supported.");
+
+    std::uint64_t numRows, numColumns, dataOffset;
+    std::memcpy(&numRows, data + 16, sizeof(numRows));
+    std::memcpy(&numColumns, data + 24, sizeof(numColumns));
+    std::memcpy(&dataOffset, data + 32, sizeof(dataOffset));
+    OPENSIM_THROW_IF(dataOffset < fixedHeaderSize || dataOffset > size ||
+                             dataOffset % dataAlignment != 0,
+            IOError, "STB file '" + fileName + "' has an invalid header.");
+    // Guard against overflow before checking the size of the data block.
+    const std::uint64_t maxValues = (size - dataOffset) / sizeof(double);
+    OPENSIM_THROW_IF(numColumns + 1 == 0 ||
+                             (numRows != 0 &&
+                                     numColumns + 1 > maxValues / numRows),
+            IOError,
+            "STB file '" + fileName + "' is shorter than its header "
+            "describes.");
+
+    HeaderReader reader(fileName, data + fixedHeaderSize, data + dataOffset);
+    const std::uint64_t numMetaData = reader.readUInt64();
+    for (std::uint64_t i = 0; i < numMetaData; ++i) {
+        std::string key = reader.readString();
+        std::string value = reader.readString();
+        _metaData.emplace_back(std::move(key), std::move(value));
+    }
+    _columnLabels.reserve(numColumns);
+    for (std::uint64_t i = 0; i < numColumns; ++i) {
+        _columnLabels.push_back(reader.readString());
+    }
+
+    _numRows = static_cast<size_t>(numRows);
+    // The data block is 64-byte aligned within a page-aligned mapping.
+    _columns = reinterpret_cast<const double*>(data + dataOffset);
+}
+
+STBFileView::STBFileView(STBFileView&&) = default;
+STBFileView& STBFileView::operator=(STBFileView&&) = default;
+STBFileView::~STBFileView() = default;
+
+size_t STBFileView::getColumnIndex(const std::string& label) const {
+    for (size_t i = 0; i < _columnLabels.size(); ++i) {
+        if (_columnLabels[i] == label) return i;
+    }
+    OPENSIM_THROW(KeyNotFound, label);
+}
+
+const double* STBFileView::getDependentColumnAtIndex(size_t index) const {
+    OPENSIM_THROW_IF(index >= getNumColumns(), IndexOutOfRange, index, 0,
+            getNumColumns() - 1);
+    return _columns + (index + 1) * _numRows;
+}
+
+TimeSeriesTable STBFileView::toTimeSeriesTable() const {
+    const int nrow = static_cast<int>(_numRows);
+    const int ncol = static_cast<int>(getNumColumns());
+
+    std::vector<double> time(_columns, _columns + _numRows);
+    SimTK::Matrix matrix(nrow, ncol);
+    for (int c = 0; c < ncol; ++c) {
+        const double* column = getDependentColumnAtIndex(c);
+        for (int r = 0; r < nrow; ++r) { matrix(r, c) = column[r]; }
+    }
+
+    TimeSeriesTable table(time, matrix, _columnLabels);
+    for (const auto& keyValue : _metaData) {
+        table.addTableMetaData(keyValue.first, keyValue.second);
+    }
+    return table;
+}
+
+//=============================================================================
+// STBFileAdapter
+//=============================================================================
+STBFileAdapter*
+STBFileAdapter::clone() const {
+    return new STBFileAdapter{*this};
+}
+
+void
+STBFileAdapter::write(const TimeSeriesTable& table,
+                      const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(_table, &table);
+    STBFileAdapter{}.extendWrite(tables, fileName);
+}
+
+STBFileAdapter::OutputTables
+STBFileAdapter::extendRead(const std::string& fileName) const {
+    const STBFileView view(fileName);
+    OutputTables output_tables{};
+    output_tables.emplace(_table,
+            std::make_shared<TimeSeriesTable>(view.toTimeSeriesTable()));
+    return output_tables;
+}
+
+void
+STBFileAdapter::extendWrite(const InputTables& absTables,
+                            const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(), NoTableFound);
+
+    const TimeSeriesTable* table{};
+    try {
+        auto abs_table = absTables.at(_table);
+        table = &dynamic_cast<const TimeSeriesTable&>(*abs_table);
+    } catch(std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing,
+                      _table);
+    } catch(std::bad_cast&) {
+        OPENSIM_THROW(IncorrectTableType);
+    }
+
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    // Variable-length part of the header.
+    std::string header;
+    std::vector<std::pair<std::string, std::string>> metaData;
+    for (const auto& key : table->getTableMetaDataKeys()) {
+        try {
+            metaData.emplace_back(
+                    key, table->getTableMetaData<std::string>(key));
+        } catch(const InvalidTemplateArgument&) {}
+    }
+    writeUInt64(header, metaData.size());
+    for (const auto& keyValue : metaData) {
+        writeString(header, keyValue.first);
+        writeString(header, keyValue.second);
+    }
+    for (const auto& label : table->getColumnLabels()) {
+        writeString(header, label);
+    }
+    const std::uint64_t dataOffset =
+            (fixedHeaderSize + header.size() + dataAlignment - 1) /
+            dataAlignment * dataAlignment;
+    header.resize(dataOffset - fixedHeaderSize, '\0');
+
+    const std::uint64_t numRows = table->getNumRows();
+    const std::uint64_t numColumns = table->getNumColumns();
+
+    std::ofstream out_stream{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!out_stream, IOError,
+            "Could not open '" + fileName + "' for writing.");
+    out_stream.write(magic, sizeof(magic));
+    out_stream.write(reinterpret_cast<const char*>(&formatVersion),
+            sizeof(formatVersion));
+    out_stream.write(reinterpret_cast<const char*>(&byteOrderMark),
+            sizeof(byteOrderMark));
+    out_stream.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+    out_stream.write(reinterpret_cast<const char*>(&numColumns),
+            sizeof(numColumns));
+    out_stream.write(reinterpret_cast<const char*>(&dataOffset),
+            sizeof(dataOffset));
+    out_stream.write(header.data(), header.size());
+
+    const auto& time = table->getIndependentColumn();
+    out_stream.write(reinterpret_cast<const char*>(time.data()),
+            numRows * sizeof(double));
+    // The table's matrix is not necessarily stored column by column, so copy
+    // each column into a contiguous buffer.
+    std::vector<double> column(numRows);
+    for (std::uint64_t c = 0; numRows > 0 && c < numColumns; ++c) {
+        const auto& values = table->getDependentColumnAtIndex(c);
+        for (std::uint64_t r = 0; r < numRows; ++r) {
+            column[r] = values[static_cast<int>(r)];
+        }
+        out_stream.write(reinterpret_cast<const char*>(column.data()),
+                numRows * sizeof(double));
+    }
+    OPENSIM_THROW_IF(!out_stream, IOError,
+            "Could not write STB file '" + fileName + "'.");
+}
+
+} // namespace OpenSim
@@ -0,0 +1,166 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  STBFileAdapter.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_STB_FILE_ADAPTER_H_
+#define OPENSIM_STB_FILE_ADAPTER_H_
+
+/** @file
+* STBFileAdapter is a concrete FileAdapter for reading and writing STB files, a
+binary, column-major counterpart of the STO format for TimeSeriesTable (of
+double). All integers and values are stored in the byte order of the machine
+that wrote the file, which is checked when the file is opened. The layout is:
+
+\code
+offset  size        contents
+0       8           magic "OSIMSTB" followed by '\0'
+8       4           format version (uint32)
+12      4           byte order mark 0x01020304 (uint32)
+16      8           number of rows (uint64)
+24      8           number of dependent columns (uint64)
+32      8           offset of the data block from the start of the file
+                    (uint64, a multiple of 64)
+40      ...         number of metadata entries (uint64), then for each entry
+                    its key and value, then the label of each dependent column.
+                    Every string is stored as its length (uint64) followed by
+                    its characters (no terminating '\0').
+data    8 * nrow    independent (time) column (float64)
+        8 * nrow    dependent column 0 (float64)
+        ...
+        8 * nrow    dependent column ncol-1 (float64)
+\endcode
+
+Only table metadata with string values is stored, as for STO files.
+
+Since every column is contiguous on disk, an STB file can be memory-mapped
+and its columns used in place, without parsing or copying; see
+STBFileView.                                                                  */
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+#include <memory>
+
+namespace OpenSim {
+
+/** STBFileView maps an STB file into memory (read-only) and gives access to
+its columns in place. Opening a view only validates the header and reads the
+column labels and metadata, so its cost does not depend on the number of rows.
+The pointers returned by the accessors remain valid for the lifetime of the
+view.
+
+\code
+STBFileView view("states.stb");
+const double* time = view.getIndependentColumn();
+const double* knee = view.getDependentColumn("/jointset/knee/knee_flex/value");
+for (size_t i = 0; i < view.getNumRows(); ++i) {
+    // ... use time[i] and knee[i]
+}
+\endcode                                                                      */
+class OSIMCOMMON_API STBFileView {
+public:
+    /** Map the given STB file.
+
+    \throws FileDoesNotExist If the file cannot be opened.
+    \throws IOError If the file is not a valid STB file.                      */
+    explicit STBFileView(const std::string& fileName);
+    STBFileView(const STBFileView&)            = delete;
+    STBFileView& operator=(const STBFileView&) = delete;
+    STBFileView(STBFileView&&);
+    STBFileView& operator=(STBFileView&&);
+    ~STBFileView();
+
+    /** Number of rows (time points).                                         */
+    size_t getNumRows() const { return _numRows; }
+    /** Number of dependent columns (not counting time).                      */
+    size_t getNumColumns() const { return _columnLabels.size(); }
+    const std::vector<std::string>& getColumnLabels() const {
+        return _columnLabels;
+    }
+    /** Index of the dependent column with the given label.
+
+    \throws KeyNotFound If no column has this label.                          */
+    size_t getColumnIndex(const std::string& label) const;
+    /** Table metadata (key/value pairs) stored in the file.                  */
+    const std::vector<std::pair<std::string, std::string>>&
+    getMetaData() const {
+        return _metaData;
+    }
+
+    /** Pointer to getNumRows() contiguous time values.                       */
+    const double* getIndependentColumn() const { return _columns; }
+    /** Pointer to getNumRows() contiguous values of a dependent column.      */
+    const double* getDependentColumnAtIndex(size_t index) const;
+    /** Pointer to getNumRows() contiguous values of a dependent column.
+
+    \throws KeyNotFound If no column has this label.                          */
+    const double* getDependentColumn(const std::string& label) const {
+        return getDependentColumnAtIndex(getColumnIndex(label));
+    }
+
+    /** Copy the contents of the file into a TimeSeriesTable.                */
+    TimeSeriesTable toTimeSeriesTable() const;
+
+private:
+    class Mapping;
+    std::unique_ptr<Mapping> _mapping;
+    size_t _numRows{0};
+    std::vector<std::string> _columnLabels;
+    std::vector<std::pair<std::string, std::string>> _metaData;
+    const double* _columns{nullptr};
+};
+
+/** STBFileAdapter is a FileAdapter that reads and writes STB files (see the
+file documentation above). It accepts (when writing) and returns (when
+reading) a TimeSeriesTable under the key "table", so STB files can be used
+wherever STO files are read through FileAdapter, including
+TimeSeriesTable(fileName) and Storage(fileName).                              */
+class OSIMCOMMON_API STBFileAdapter : public FileAdapter {
+public:
+    STBFileAdapter()                                 = default;
+    STBFileAdapter(const STBFileAdapter&)            = default;
+    STBFileAdapter(STBFileAdapter&&)                 = default;
+    STBFileAdapter& operator=(const STBFileAdapter&) = default;
+    STBFileAdapter& operator=(STBFileAdapter&&)      = default;
+    ~STBFileAdapter()                                = default;
+
+    STBFileAdapter* clone() const override;
+
+    /** Write a table to an STB file. The filename provided need not contain
+    ".stb".                                                                   */
+    static
+    void write(const TimeSeriesTable& table, const std::string& fileName);
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string _table;
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STB_FILE_ADAPTER_H_
@@ -37,11 +37,100 @@
 #include "simmath/internal/Spline.h"
 #include "simmath/internal/SplineFitter.h"
 
+#include <algorithm>
+#include <future>
 #include <vector>
 
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+// Coefficients of the 3rd order lowpass Butterworth filter of LowpassIIR().
+void computeLowpassIIRCoefficients(double T, double fc, double a[4],
+        double b[4]) {
+    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
+    double fs = 1 / T;
+    if (fc >= 0.5 * fs) {
+        fc = 0.49 * fs;
+        log_warn("Cutoff frequency should be less than half sample frequency. "
+                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
+                 "cutoff = {}", fc);
+    }
+
+    // CALCULATE THE FREQUENCY WARPING
+    double wc = 2*SimTK_PI*fc;
+    double wa = tan(wc*T/2.0);
+    double wa2 = wa*wa;
+    double wa3 = wa*wa*wa;
+
+    // GET COEFFICIENTS FOR THE FILTER
+    double denom = (wa+1) * (wa*wa + wa + 1.0);
+    a[0] = wa3 / denom;
+    a[1] = 3*wa3 / denom;
+    a[2] = 3*wa3 / denom;
+    a[3] = wa3 / denom;
+    b[0] = 1;
+    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom;
+    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom;
+    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+}
+
+// Number of signals that the filter bank of LowpassIIR() filters together.
+constexpr int iirBlockSize = 8;
+
+// Filter the signals [begin, end) (at most iirBlockSize of them) forward and
+// backward. The samples of the signals are interleaved in x and y (sample i
+// of signal c is at i*iirBlockSize + c), so the loops over the signals are
+// contiguous and have a fixed length. The operations on each signal are those
+// of the single-signal LowpassIIR().
+void lowpassIIRBlock(const double a[4], const double b[4], int N, int begin,
+        int end, const double* sig, double* sigf, double* x, double* y) {
+    const int B = iirBlockSize;
+    for (int c = 0; c < B; ++c) {
+        if (begin + c < end) {
+            const double* column = sig + (size_t)(begin + c) * N;
+            for (int i = 0; i < N; ++i) x[(size_t)i*B + c] = column[i];
+        } else {
+            // Unused signals of the last block.
+            for (int i = 0; i < N; ++i) x[(size_t)i*B + c] = 0;
+        }
+    }
+
+    // FORWARD
+    for (int i = 0; i < 3; ++i) {
+        for (int c = 0; c < B; ++c) y[i*B + c] = x[i*B + c];
+    }
+    for (int i = 3; i < N; ++i) {
+        const double* xi = x + (size_t)i*B;
+        double* yi = y + (size_t)i*B;
+        for (int c = 0; c < B; ++c) {
+            yi[c] = a[0]*xi[c] + a[1]*xi[c-B] + a[2]*xi[c-2*B] +
+                    a[3]*xi[c-3*B] - b[1]*yi[c-B] - b[2]*yi[c-2*B] -
+                    b[3]*yi[c-3*B];
+        }
+    }
+
+    // BACKWARD (in place of the reversed copies of the single-signal filter)
+    for (int i = N - 3; i < N; ++i) {
+        for (int c = 0; c < B; ++c) x[(size_t)i*B + c] = y[(size_t)i*B + c];
+    }
+    for (int i = N - 4; i >= 0; --i) {
+        const double* yi = y + (size_t)i*B;
+        double* xi = x + (size_t)i*B;
+        for (int c = 0; c < B; ++c) {
+            xi[c] = a[0]*yi[c] + a[1]*yi[c+B] + a[2]*yi[c+2*B] +
+                    a[3]*yi[c+3*B] - b[1]*xi[c+B] - b[2]*xi[c+2*B] -
+                    b[3]*xi[c+3*B];
+        }
+    }
+
+    for (int c = 0; c < end - begin; ++c) {
+        double* column = sigf + (size_t)(begin + c) * N;
+        for (int i = 0; i < N; ++i) column[i] = x[(size_t)i*B + c];
+    }
+}
+} // anonymous namespace
+
 //=============================================================================
 // FILTERS
 //=============================================================================
@@ -163,8 +252,7 @@ int Signal::
 LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
 {
 int i,j;
-double fs/*,ws*/,wc,wa,wa2,wa3;
-double a[4],b[4],denom;
+double a[4],b[4];
 double *sigr;
 
     // ERROR CHECK
@@ -173,34 +261,8 @@ double *sigr;
     if(sig==NULL) return(-1);
     if(sigf==NULL) return(-1);
 
-    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
-    fs = 1 / T;
-    if (fc >= 0.5 * fs) {
-        fc = 0.49 * fs;
-        log_warn("Cutoff frequency should be less than half sample frequency. "
-                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
-                 "cutoff = {}", fc);
-    }
-
-    // INITIALIZE SOME VARIABLES
-    //ws = 2*SimTK_PI*fs;
-    wc = 2*SimTK_PI*fc;
-
-    // CALCULATE THE FREQUENCY WARPING
-    wa = tan(wc*T/2.0);
-    wa2 = wa*wa;
-    wa3 = wa*wa*wa;
-
     // GET COEFFICIENTS FOR THE FILTER
-    denom = (wa+1) * (wa*wa + wa + 1.0);
-    a[0] = wa3 / denom;
-    a[1] = 3*wa3 / denom;
-    a[2] = 3*wa3 / denom;
-    a[3] = wa3 / denom;
-    b[0] = 1;
-    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
-    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
-    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+    computeLowpassIIRCoefficients(T, fc, a, b);
 
     // ALLOCATE MEMORY FOR sigr[]
     sigr = new double[N];
@@ -242,6 +304,71 @@ double *sigr;
 
   return(0);
 }
+//_____________________________________________________________________________
+/**
+ * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER BANK
+ *
+ * Filter several signals of the same length with the filter of
+ * LowpassIIR(). The signals are stored one after the other: sample i of
+ * signal k is sig[k*N + i]. The signals are filtered in blocks of 8, with the
+ * samples of a block interleaved so that the filter can be applied to all
+ * signals of the block with vector instructions, and the blocks are divided
+ * among numThreads threads. The result is the same as that of filtering each
+ * signal with LowpassIIR().
+ *
+ * It is permissible for sig and sigf to be the same array.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in each signal (at least 4).
+ *  @param numSignals Number of signals.
+ *  @param sig The sampled signals.
+ *  @param sigf The filtered signals.
+ *  @param numThreads Number of threads used to filter the signals.
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,int numSignals,const double *sig,
+        double *sigf,int numThreads)
+{
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+    if(numSignals<0 || numThreads<1) return(-1);
+    if(numSignals==0) return(0);
+    if(sig==NULL) return(-1);
+    if(sigf==NULL) return(-1);
+
+    double a[4],b[4];
+    computeLowpassIIRCoefficients(T, fc, a, b);
+
+    const int numBlocks = (numSignals + iirBlockSize - 1) / iirBlockSize;
+    numThreads = std::min(numThreads, numBlocks);
+    auto filterBlocks = [&](int thread) {
+        std::vector<double> x((size_t)N*iirBlockSize);
+        std::vector<double> y((size_t)N*iirBlockSize);
+        for (int block = thread; block < numBlocks; block += numThreads) {
+            const int begin = block * iirBlockSize;
+            const int end = std::min(begin + iirBlockSize, numSignals);
+            lowpassIIRBlock(a, b, N, begin, end, sig, sigf, x.data(),
+                    y.data());
+        }
+    };
+
+    if (numThreads == 1) {
+        filterBlocks(0);
+    } else {
+        std::vector<std::future<void>> futures;
+        for (int thread = 0; thread < numThreads; ++thread) {
+            futures.push_back(
+                    std::async(std::launch::async, filterBlocks, thread));
+        }
+        for (auto& future : futures) future.get();
+    }
+
+  return(0);
+}
 
 //-----------------------------------------------------------------------------
 // FIR
@@ -64,6 +64,14 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,const double *aSignal,double *rFilteredSignal);
+    /// Filter aNumSignals signals of aN data points each, stored one after
+    /// the other, with the filter of LowpassIIR(). The signals are filtered
+    /// together in blocks, optionally with several threads; the result is
+    /// the same as filtering each signal on its own.
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals,int aNumThreads=1);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
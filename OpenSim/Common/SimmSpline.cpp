@@ -29,6 +29,8 @@
 #include "XYFunctionInterface.h"
 #include "FunctionAdapter.h"
 
+#include <algorithm>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -670,6 +672,86 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
       return (2.0*_c[k] + 6.0*dx*_d[k]);
 }
 
+void SimmSpline::calcValuesAndDerivatives(int aN, const double *aX,
+    double *rValues, double *rFirstDerivatives, double *rSecondDerivatives) const
+{
+    int n = _x.getSize();
+
+    // NOT A NUMBER
+    if (n < 2 || _y.getSize() < n || _b.getSize() < n)
+    {
+        for (int i=0; i<aN; i++)
+        {
+            if (rValues) rValues[i] = SimTK::NaN;
+            if (rFirstDerivatives) rFirstDerivatives[i] = SimTK::NaN;
+            if (rSecondDerivatives) rSecondDerivatives[i] = SimTK::NaN;
+        }
+        return;
+    }
+
+    const double *x = &_x[0];
+    const double *y = &_y[0];
+    const double *b = &_b[0];
+    const double *c = &_c[0];
+    const double *d = &_d[0];
+
+    int k = 0;
+    for (int i=0; i<aN; i++)
+    {
+        double aXi = aX[i];
+        double value, first, second;
+
+        /* Out of range and end points: same as calcValue() and
+         * calcDerivative().
+         */
+        if (aXi < x[0])
+        {
+            value = y[0] + (aXi - x[0])*b[0];
+            first = b[0];
+            second = 0.0;
+        }
+        else if (aXi > x[n-1])
+        {
+            value = y[n-1] + (aXi - x[n-1])*b[n-1];
+            first = b[n-1];
+            second = 0.0;
+        }
+        else if (EQUAL_WITHIN_ERROR(aXi,x[0]))
+        {
+            value = y[0];
+            first = b[0];
+            second = 2.0*c[0];
+        }
+        else if (EQUAL_WITHIN_ERROR(aXi,x[n-1]))
+        {
+            value = y[n-1];
+            first = b[n-1];
+            second = 2.0*c[n-1];
+        }
+        else
+        {
+            /* Find the last knot at or before the abscissa, walking forward
+             * from the previous interval (or searching again if the
+             * abscissae are not sorted).
+             */
+            if (aXi < x[k])
+                k = (int)(std::upper_bound(x, x+n, aXi) - x) - 1;
+            else
+                while (k < n-2 && x[k+1] <= aXi) k++;
+            if (k > n-2) k = n-2;
+
+            double dx = aXi - x[k];
+            value = y[k] + dx*(b[k] + dx*(c[k] + dx*d[k]));
+            first = b[k] + dx*(2.0*c[k] + 3.0*dx*d[k]);
+            second = 2.0*c[k] + 6.0*dx*d[k];
+        }
+
+        if (rValues) rValues[i] = value;
+        if (rFirstDerivatives) rFirstDerivatives[i] = first;
+        if (rSecondDerivatives) rSecondDerivatives[i] = second;
+    }
+}
+
 int SimmSpline::getArgumentSize() const
 {
     return 1;
@@ -120,6 +120,19 @@ public:
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    /**
+     * Evaluate the spline and its first and second derivatives at each of
+     * the aN abscissae in aX. Each of rValues, rFirstDerivatives and
+     * rSecondDerivatives must hold aN values, or be NULL if not needed.
+     *
+     * The results are those of calcValue() and calcDerivative() (up to
+     * roundoff at interior knots), but the interval containing each abscissa
+     * is found by walking forward from the previous one. Evaluating the
+     * spline over a sorted grid (e.g., the times of a motion) therefore costs
+     * O(aN + number of knots), with no allocation per point.
+     */
+    void calcValuesAndDerivatives(int aN, const double *aX, double *rValues,
+        double *rFirstDerivatives, double *rSecondDerivatives) const;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
@@ -31,6 +32,7 @@
 #include <mutex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <cmath>
 
 //=============================================================================
@@ -322,6 +324,124 @@ std::shared_ptr<const OpenSim::SmoothSegmentedFunctionData>
 
 } // namespace
 
+//=============================================================================
+// TABULATED APPROXIMATION
+//=============================================================================
+
+namespace OpenSim {
+struct SmoothSegmentedFunctionTable
+{
+    /**Piecewise quintic polynomial approximation of one Bezier section, on
+    equal intervals in x. The polynomial of interval i is
+    sum_k coefs[6*i+k]*t^k, with t = (x - xBegin)/step - i in [0, 1].*/
+    struct Section
+    {
+        double xBegin;
+        double xEnd;
+        double step;
+        int numIntervals;
+        std::vector<double> coefs;
+    };
+
+    std::vector<Section> _sections;
+};
+} // namespace OpenSim
+
+namespace {
+
+// Exact value, slope and curvature of section s of the curve at x.
+std::array<double, 3> calcSectionDerivatives(
+    const SmoothSegmentedFunctionData& data, int s, double x)
+{
+    const double u = SegmentedQuinticBezierToolkit::calcU(
+        x, data._ctrlPtsX[s], data._arraySplineUX[s], UTOL, MAXITER);
+    std::array<double, 3> y;
+    for (int i = 0; i < 3; ++i) {
+        y[i] = SegmentedQuinticBezierToolkit::calcQuinticBezierCurveDerivDYDX(
+            u, data._ctrlPtsX[s], data._ctrlPtsY[s], i);
+    }
+    return y;
+}
+
+// Value, slope and curvature of interval i of a tabulated section at x.
+std::array<double, 3> calcTabulatedDerivatives(
+    const SmoothSegmentedFunctionTable::Section& section, double x)
+{
+    double t = (x - section.xBegin) / section.step;
+    const int i = std::min(std::max(static_cast<int>(t), 0),
+                           section.numIntervals - 1);
+    t -= i;
+    const double* a = &section.coefs[6 * i];
+    const double y = a[0] + t*(a[1] + t*(a[2] + t*(a[3] + t*(a[4] + t*a[5]))));
+    const double dydt =
+        a[1] + t*(2*a[2] + t*(3*a[3] + t*(4*a[4] + t*5*a[5])));
+    const double d2ydt2 = 2*a[2] + t*(6*a[3] + t*(12*a[4] + t*20*a[5]));
+    return {y, dydt / section.step, d2ydt2 / (section.step * section.step)};
+}
+
+// Fit section s of the curve with numIntervals quintic Hermite polynomials,
+// which match the value, slope and curvature of the curve at the knots.
+SmoothSegmentedFunctionTable::Section fitSection(
+    const SmoothSegmentedFunctionData& data, int s, int numIntervals)
+{
+    SmoothSegmentedFunctionTable::Section section;
+    section.xBegin = data._ctrlPtsX[s](0);
+    section.xEnd = data._ctrlPtsX[s](5);
+    section.numIntervals = numIntervals;
+    const double h = (section.xEnd - section.xBegin) / numIntervals;
+    section.step = h;
+    section.coefs.resize(6 * numIntervals);
+
+    std::array<double, 3> left =
+        calcSectionDerivatives(data, s, section.xBegin);
+    for (int i = 0; i < numIntervals; ++i) {
+        const double xRight = (i == numIntervals - 1)
+                            ? section.xEnd : section.xBegin + (i + 1)*h;
+        const std::array<double, 3> right =
+            calcSectionDerivatives(data, s, xRight);
+        // Derivatives with respect to t = (x - x_i)/h.
+        const double y0 = left[0],      y1 = right[0];
+        const double d0 = left[1]*h,    d1 = right[1]*h;
+        const double c0 = left[2]*h*h,  c1 = right[2]*h*h;
+        double* a = &section.coefs[6 * i];
+        a[0] = y0;
+        a[1] = d0;
+        a[2] = 0.5*c0;
+        a[3] =  10*(y1 - y0) - 6*d0 - 4*d1 - 1.5*c0 + 0.5*c1;
+        a[4] = -15*(y1 - y0) + 8*d0 + 7*d1 + 1.5*c0 -     c1;
+        a[5] =   6*(y1 - y0) - 3*d0 - 3*d1 - 0.5*c0 + 0.5*c1;
+        left = right;
+    }
+    return section;
+}
+
+// Check the value and slope of a tabulated section against the curve at the
+// quarter points of each interval.
+bool isSectionWithinTolerance(const SmoothSegmentedFunctionData& data, int s,
+    const SmoothSegmentedFunctionTable::Section& section, double tolerance)
+{
+    for (int i = 0; i < section.numIntervals; ++i) {
+        for (double t : {0.25, 0.5, 0.75}) {
+            const double x = section.xBegin + (i + t)*section.step;
+            const std::array<double, 3> exact =
+                calcSectionDerivatives(data, s, x);
+            const std::array<double, 3> approx =
+                calcTabulatedDerivatives(section, x);
+            if (std::abs(approx[0] - exact[0]) >
+                    tolerance*(1 + std::abs(exact[0])) ||
+                std::abs(approx[1] - exact[1]) >
+                    tolerance*(1 + std::abs(exact[1]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static constexpr int MAX_TABULATION_INTERVALS = 16384;
+
+} // namespace
+
 //=============================================================================
 // RULE OF FIVE
 //=============================================================================
@@ -654,10 +774,25 @@ DerivativeValues calcSelectedDerivatives(
     return y;
 }
 
+// Find the tabulated section that contains x, if x is in the curve domain.
+const SmoothSegmentedFunctionTable::Section* findTabulatedSection(
+    const SmoothSegmentedFunctionTable& table, double x)
+{
+    for (const auto& section : table._sections) {
+        if (x >= section.xBegin && x <= section.xEnd) return &section;
+    }
+    return nullptr;
+}
+
 } // namespace
 
 double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 {
+    if (_table && order <= 2) {
+        if (const auto* section = findTabulatedSection(*_table, x)) {
+            return calcTabulatedDerivatives(*section, x)[order];
+        }
+    }
     SelectedDerivativeOrders orders{};
     orders.at(order) = true;
     return calcSelectedDerivatives(x, orders, _smoothData).at(order);
@@ -666,6 +801,13 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 SmoothSegmentedFunction::ValueAndDerivative SmoothSegmentedFunction::
     calcValueAndFirstDerivative(double x) const
 {
+    if (_table) {
+        if (const auto* section = findTabulatedSection(*_table, x)) {
+            const std::array<double, 3> y =
+                calcTabulatedDerivatives(*section, x);
+            return {y[0], y[1]};
+        }
+    }
     const SelectedDerivativeOrders orders{true, true};
     const DerivativeValues y =
         calcSelectedDerivatives(x, orders, _smoothData);
@@ -818,6 +960,42 @@ SimTK::Vec2 SmoothSegmentedFunction::getCurveDomain() const
     return xrange;
 }
 
+void SmoothSegmentedFunction::tabulate(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS(tolerance > 0,
+        "SmoothSegmentedFunction::tabulate",
+        "%s: The tolerance must be positive, but it is %f.",
+        _name.c_str(), tolerance);
+
+    const SmoothSegmentedFunctionData& data = *_smoothData;
+    auto table = std::make_shared<SmoothSegmentedFunctionTable>();
+    for (int s = 0; s < data._numBezierSections; ++s) {
+        int numIntervals = 4;
+        SmoothSegmentedFunctionTable::Section section =
+            fitSection(data, s, numIntervals);
+        while (!isSectionWithinTolerance(data, s, section, tolerance)) {
+            numIntervals *= 2;
+            SimTK_ERRCHK3_ALWAYS(numIntervals <= MAX_TABULATION_INTERVALS,
+                "SmoothSegmentedFunction::tabulate",
+                "%s: Could not meet the tolerance %g in Bezier section %i.",
+                _name.c_str(), tolerance, s);
+            section = fitSection(data, s, numIntervals);
+        }
+        table->_sections.push_back(std::move(section));
+    }
+    _table = table;
+}
+
+void SmoothSegmentedFunction::clearTabulation()
+{
+    _table = nullptr;
+}
+
+bool SmoothSegmentedFunction::isTabulated() const
+{
+    return _table != nullptr;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Utility functions
 ///////////////////////////////////////////////////////////////////////////////
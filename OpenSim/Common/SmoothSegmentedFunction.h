@@ -33,6 +33,12 @@ namespace OpenSim {
     */
     struct SmoothSegmentedFunctionData;
 
+    /**
+    Struct containing the piecewise polynomial approximation of a
+    SmoothSegmentedFunction (see SmoothSegmentedFunction::tabulate()).
+    */
+    struct SmoothSegmentedFunctionTable;
+
     /**
     This class contains the quintic Bezier curves, x(u) and y(u), that have been
     created by SmoothSegmentedFunctionFactory to follow a physiologically meaningful 
@@ -288,8 +294,46 @@ namespace OpenSim {
        void printMuscleCurveToCSVFile(const std::string& path,
                                       double domainMin,
                                       double domainMax) const;
-       
-///@cond       
+
+       /**
+       Replaces the evaluation of the curve and of its first and second
+       derivatives within the curve domain by a piecewise quintic Hermite
+       interpolant in x, which avoids the iterative inversion of the Bezier
+       parameter u(x) in every call.
+
+       Each Bezier section is divided into equal intervals in x, and the exact
+       value, slope and curvature of the curve are stored at the knots. The
+       number of intervals of a section is doubled until, at the quarter
+       points of every interval, the errors of the value and of the first
+       derivative are smaller than tolerance*(1 + |y|) and
+       tolerance*(1 + |dy/dx|), respectively. The interpolant is C2 within a
+       section and matches the curve exactly at the section boundaries, so the
+       tabulated curve has the same continuity as the original. Derivatives
+       above the second order and the linear extrapolation outside of the
+       curve domain are always evaluated exactly.
+
+       The table is shared by copies of this object.
+
+       @param tolerance The error tolerance (see above); must be positive.
+       @throws SimTK::Exception
+        -If tolerance is not positive
+        -If the tolerance cannot be met with 16384 intervals per section
+
+       <B>Computational Costs</B>
+       \verbatim
+            x in curve domain  : ~40 flops (value), ~60 flops (derivatives)
+       \endverbatim
+       */
+       void tabulate(double tolerance);
+
+       /** Returns to the exact evaluation of the curve. */
+       void clearTabulation();
+
+       /** @returns true if the curve is evaluated from its table (see
+       tabulate()). */
+       bool isTabulated() const;
+
+       ///@cond       
        /**
        THIS FUNCTION IS PUBLIC FOR TESTING ONLY 
                    DO NOT USE THIS!
@@ -337,6 +381,9 @@ namespace OpenSim {
         /**Data required for performing the calculations. **/
         std::shared_ptr<const SmoothSegmentedFunctionData> _smoothData = nullptr;
 
+        /**Tabulated approximation of the curve, if any (see tabulate()).**/
+        std::shared_ptr<const SmoothSegmentedFunctionTable> _table = nullptr;
+
         /**The name of the function**/
         std::string _name;
             
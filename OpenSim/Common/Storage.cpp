@@ -35,6 +35,7 @@
 #include "GCVSplineSet.h"
 #include "IO.h"
 #include "Logger.h"
+#include "STBFileAdapter.h"
 #include "STOFileAdapter.h"
 #include "Signal.h"
 #include "SimTKcommon.h"
@@ -42,6 +43,7 @@
 #include "StateVector.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace OpenSim;
@@ -186,8 +188,16 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
 
     bool isMotFile = SimTK::String::toLower(fileName).rfind(".mot") != string::npos;
     bool isStoFile = SimTK::String::toLower(fileName).rfind(".sto") != string::npos;
+    bool isStbFile = SimTK::String::toLower(fileName).rfind(".stb") != string::npos;
     bool useFileAdpater = true;
 
+    if (isStbFile) {
+        // Binary files are read directly from their memory-mapped columns
+        // rather than through an intermediate TimeSeriesTable.
+        readStbFile(fileName, readHeadersOnly);
+        return;
+    }
+
     int nr = 0, nc = 0;
 
     if (isMotFile || isStoFile) {
@@ -273,30 +283,31 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
 
 
     // DATA
+    // Read the rest of the file at once and parse all nr*nc numbers
+    // (concurrently, for large files).
+    std::vector<double> data;
+    const size_t numExpected = (size_t)std::max(nr, 0) * std::max(nc, 0);
+    const size_t numRead = FileAdapter::parseNumbers(
+            FileAdapter::readRemaining(*fp), 0, numExpected, data);
+    if (numRead < numExpected) {
+        log_warn("Storage: could only read {} of the {} values expected in "
+                 "file {}. The remaining values are set to NaN.",
+                numRead, numExpected, fileName);
+    }
     if(indexTime != -1 || indexRange != -1){ //MM edit
         int ny = nc-1;
-        double time;
-        double *y = new double[ny];
         for(int r=0;r<nr;r++) {
-                (*fp)>>time;
-                for(int i=0;i<ny;i++)
-                    (*fp)>>y[i];
-                append(time,ny,y);
+                const double* row = data.data() + (size_t)r*nc;
+                append(row[0],ny,row+1);
         }
-        delete[] y;
     }else{  //MM the modifications below are to make the Storage class
             //well behaved when it is given data that does not contain a
             //time or a range column
         int ny = nc;
-        double time;
-        double *y = new double[ny];
         for(int r=0;r<nr;r++) {
-                time=(double)r;
-                for(int i=0;i<ny;i++)
-                    (*fp)>>y[i];
-                append(time,ny,y);
+                const double* row = data.data() + (size_t)r*nc;
+                append((double)r,ny,row);
         }
-        delete[] y;
     }
     // If what we read was really a sIMM motion file, adjust the data
     // to account for different assumptions between SIMM.mot OpenSim.sto
@@ -1133,11 +1144,11 @@ getDataColumn(int aStateIndex,double *&rData) const
     }
 
     // ASSIGNMENT
-    int i,nData;
-    for(i=nData=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        if(vec->getDataValue(aStateIndex,rData[nData])) nData++;
+    int nData = 0;
+    if(aStateIndex<0) return(nData);
+    for(int i=0;i<n;i++) {
+        const Array<double>& y = _storage[i].getData();
+        if(aStateIndex<y.getSize()) rData[nData++] = y[aStateIndex];
     }
 
     return(nData);
@@ -1151,11 +1162,12 @@ getDataColumn(int aStateIndex,Array<double> &rData) const
     rData.setSize(n);
 
     // ASSIGNMENT
-    int i,nData;
-    for(i=nData=0;i<n;i++) {
-        StateVector *vec = getStateVector(i);
-        if(vec==NULL) continue;
-        if(vec->getDataValue(aStateIndex,rData[nData])) nData++;
+    int nData = 0;
+    if(aStateIndex>=0) {
+        for(int i=0;i<n;i++) {
+            const Array<double>& y = _storage[i].getData();
+            if(aStateIndex<y.getSize()) rData[nData++] = y[aStateIndex];
+        }
     }
 
     rData.setSize(nData);
@@ -2299,25 +2311,27 @@ pad(int aPadSize)
 
     // PAD EACH COLUMN
     int nc = getSmallestNumberOfStates();
+    std::vector<double> columns;
+    getColumnMajorData(nc,columns);
+    std::vector<double> paddedColumns((size_t)nc*newSize);
     Array<double> paddedSignal(0.0,size);
-    StateVector *vecs = new StateVector[newSize];
-    for(int j=0;j<newSize;j++) {
-        vecs[j].getData().setSize(nc);
-        vecs[j].setTime(paddedTime[j]);
-    }
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,paddedSignal);
+        paddedSignal.setSize(size);
+        std::copy_n(columns.begin()+(size_t)i*size,size,&paddedSignal[0]);
         Signal::Pad(aPadSize,paddedSignal);
-        for(int j=0;j<newSize;j++)
-            vecs[j].setDataValue(i,paddedSignal[j]);
+        std::copy_n(&paddedSignal[0],newSize,
+                paddedColumns.begin()+(size_t)i*newSize);
     }
 
-    // APPEND THE STATEVECTORS
+    // REPLACE THE STATEVECTORS
     _storage.setSize(0);
-    for(int i=0;i<newSize;i++) _storage.append(vecs[i]);
-
-    // CLEANUP
-    delete[] vecs;
+    _storage.ensureCapacity(newSize);
+    _storage.setSize(newSize);
+    for(int j=0;j<newSize;j++) {
+        _storage[j].setTime(paddedTime[j]);
+        _storage[j].getData().setSize(nc);
+    }
+    setColumnMajorData(nc,paddedColumns);
 }
 
 void Storage::
@@ -2346,18 +2360,17 @@ smoothSpline(int aOrder,double aCutoffFrequency)
     // LOOP OVER COLUMNS
     double *times=NULL;
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
+    std::vector<double> signals, filtered((size_t)nc*size);
+    getColumnMajorData(nc,signals);
     getTimeColumn(times,0);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
+        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,
+                &signals[(size_t)i*size],&filtered[(size_t)i*size]);
     }
+    setColumnMajorData(nc,filtered);
 
     // CLEANUP
     delete[] times;
-    delete[] signal;
 }
 
 void Storage::
@@ -2383,18 +2396,13 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // FILTER ALL COLUMNS TOGETHER
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    std::vector<double> signals;
+    getColumnMajorData(nc,signals);
+    Signal::LowpassIIR(dtmin,aCutoffFrequency,size,nc,
+            signals.data(),signals.data());
+    setColumnMajorData(nc,signals);
 }
 
 void Storage::
@@ -2422,16 +2430,13 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
 
     // LOOP OVER COLUMNS
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
+    std::vector<double> signals, filtered((size_t)nc*size);
+    getColumnMajorData(nc,signals);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,
+                &signals[(size_t)i*size],&filtered[(size_t)i*size]);
     }
-
-    // CLEANUP
-    delete[] signal;
+    setColumnMajorData(nc,filtered);
 }
 
 
@@ -2577,23 +2582,50 @@ resampleLinear(double aDT)
     double tf = getLastTime();
     int nr = IO::ComputeNumberOfSteps(ti,tf,aDT);
 
-    Storage *newStorage = new Storage(nr);
-
-    // LOOP THROUGH THE DATA
-    int ny=0;
-    double *y=NULL;
-    StateVector vec;
-    for(int i=0; i<nr; i++) {
-        double t = ti+aDT*(double)i;
-        // INTERPOLATE THE STATES
-        ny = getDataAtTime(t,ny,&y);
-        newStorage->append(t,ny,y);
+    // INTERPOLATE THE STATES
+    // This is getDataAtTime() for increasing times, sweeping once through
+    // the rows and writing the new rows in place.
+    Array<StateVector> resampled(StateVector(),nr);
+    int ny = -1;
+    int i = 0;
+    for(int k=0; k<nr; k++) {
+        double t = ti+aDT*(double)k;
+        while(i<numDataRows && !(t<_storage[i].getTime())) i++;
+        int i1 = std::max(i-1,0), i2 = i1+1;
+        if(i2==numDataRows) {
+            i1 = std::max(i1-1,0);
+            i2 = std::max(i2-1,0);
+        }
+        const StateVector& vec1 = _storage[i1];
+        const StateVector& vec2 = _storage[i2];
+        int ns = std::min(vec1.getSize(),vec2.getSize());
+        if(ny>=0 && ny<ns) ns = ny;
+        ny = ns;
+
+        double den = vec2.getTime()-vec1.getTime();
+        double pct = (den<SimTK::Eps) ? 0.0 : (t-vec1.getTime())/den;
+
+        const Array<double>& y1 = vec1.getData();
+        const Array<double>& y2 = vec2.getData();
+        StateVector& vec = resampled[k];
+        vec.setTime(t);
+        Array<double>& y = vec.getData();
+        y.setSize(ns);
+        for(int j=0;j<ns;j++) {
+            if(pct==0.0) {
+                y[j] = y1[j];
+            } else {
+                y[j] = y1[j] + pct*(y2[j]-y1[j]);
+            }
+        }
     }
+    _lastI = 0;
 
-    copyData(*newStorage);
-
-    delete newStorage;
-    delete[] y;
+    _storage = std::move(resampled);
+    // As when this was implemented with copyData() from a new Storage, the
+    // units and angle convention are reset.
+    _units = Units();
+    setInDegrees(false);
 
     return aDT;
 }
@@ -3083,6 +3115,79 @@ bool Storage::isSimmReservedToken(const std::string& aToken)
     return false;
 }
 //_____________________________________________________________________________
+/**
+ * Copy the first aNumColumns columns of every row into rData, one column
+ * after the other (column j starts at rData[j*getSize()]), so that columns
+ * can be processed contiguously. Every row must have at least aNumColumns
+ * values (e.g., aNumColumns = getSmallestNumberOfStates()).
+ */
+void Storage::
+getColumnMajorData(int aNumColumns, std::vector<double>& rData) const
+{
+    const int n = _storage.getSize();
+    rData.resize((size_t)n*aNumColumns);
+    for(int r=0;r<n;r++) {
+        const Array<double>& y = _storage[r].getData();
+        for(int j=0;j<aNumColumns;j++) rData[(size_t)j*n+r] = y[j];
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Inverse of getColumnMajorData(): set the first aNumColumns columns of every
+ * row from column-major aData.
+ */
+void Storage::
+setColumnMajorData(int aNumColumns, const std::vector<double>& aData)
+{
+    const int n = _storage.getSize();
+    for(int r=0;r<n;r++) {
+        Array<double>& y = _storage[r].getData();
+        for(int j=0;j<aNumColumns;j++) y[j] = aData[(size_t)j*n+r];
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Read a binary STB file (see STBFileAdapter) into this Storage. The rows are
+ * assembled directly from the memory-mapped columns of the file.
+ */
+void Storage::readStbFile(const std::string& fileName, bool readHeadersOnly)
+{
+    const STBFileView view(fileName);
+
+    for (const auto& keyValue : view.getMetaData()) {
+        if (keyValue.first == "inDegrees") {
+            string lower = IO::Lowercase(keyValue.second);
+            setInDegrees(lower=="yes" || lower=="y");
+        }
+    }
+
+    const int nc = (int)view.getNumColumns();
+    OpenSim::Array<std::string> labels("", nc + 1);
+    labels[0] = "time";
+    for (int i = 0; i < nc; ++i) {
+        labels[i + 1] = view.getColumnLabels()[i];
+    }
+    setColumnLabels(labels);
+
+    if (readHeadersOnly) return;
+
+    const int nr = (int)view.getNumRows();
+    log_info("Storage: read data file = {} (nr={} nc={})", fileName, nr, nc);
+
+    std::vector<const double*> columns(nc);
+    for (int i = 0; i < nc; ++i) {
+        columns[i] = view.getDependentColumnAtIndex(i);
+    }
+    const double* times = view.getIndependentColumn();
+
+    _storage.ensureCapacity(nr);
+    std::vector<double> row(nc);
+    for (int r = 0; r < nr; ++r) {
+        for (int i = 0; i < nc; ++i) { row[i] = columns[i][r]; }
+        append(times[r], nc, row.data());
+    }
+}
+//_____________________________________________________________________________
 /**
  * parse headers of OpenSim::Storage file or SIMM motion file into a Storage object
  * and populate rNumRows, rNumColumns
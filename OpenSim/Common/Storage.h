@@ -32,6 +32,8 @@
 #include "StorageInterface.h"
 #include "TimeSeriesTable.h"
 
+#include <vector>
+
 const int Storage_DEFAULT_CAPACITY = 256;
 //=============================================================================
 //=============================================================================
@@ -156,6 +158,9 @@ private:
     void copyData(const Storage &aStorage);
     void parseColumnLabels(const char *aLabels);
     bool parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColumns);
+    void readStbFile(const std::string& fileName, bool readHeadersOnly);
+    void getColumnMajorData(int aNumColumns, std::vector<double>& rData) const;
+    void setColumnMajorData(int aNumColumns, const std::vector<double>& aData);
     bool isSimmReservedToken(const std::string& aToken);
     void postProcessSIMMMotion();
     void exchangeTimeColumnWith(int aColumnIndex);
@@ -119,8 +119,8 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
     return -1;
 }
 
-void TableUtilities::filterLowpass(
-        TimeSeriesTable& table, double cutoffFreq, bool padData) {
+void TableUtilities::filterLowpass(TimeSeriesTable& table, double cutoffFreq,
+        bool padData, int numThreads) {
     OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
             "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
 
@@ -147,13 +147,35 @@ void TableUtilities::filterLowpass(
         table = resampleWithInterval(table, dtMin);
     }
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
+    // Resampling may have changed the number of rows.
+    const int numFilterRows = (int)table.getNumRows();
+    const int numColumns = (int)table.getNumColumns();
+    if (numColumns == 0) return;
+
+    // Filter all columns together. The matrix of the table stores its
+    // columns one after the other, as Signal::LowpassIIR() expects, so the
+    // columns are filtered in place; otherwise, a copy is filtered.
+    SimTK::Matrix& matrix = table._depData;
+    if (matrix.hasContiguousData() &&
+            (numColumns == 1 ||
+                    &matrix(0, 1) == &matrix(0, 0) + numFilterRows)) {
+        double* data = matrix.updContiguousScalarData();
+        Signal::LowpassIIR(dtMin, cutoffFreq, numFilterRows, numColumns,
+                data, data, numThreads);
+    } else {
+        std::vector<double> data((size_t)numFilterRows * numColumns);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            for (int irow = 0; irow < numFilterRows; ++irow) {
+                data[(size_t)icol * numFilterRows + irow] = matrix(irow, icol);
+            }
+        }
+        Signal::LowpassIIR(dtMin, cutoffFreq, numFilterRows, numColumns,
+                data.data(), data.data(), numThreads);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            for (int irow = 0; irow < numFilterRows; ++irow) {
+                matrix(irow, icol) = data[(size_t)icol * numFilterRows + irow];
+            }
+        }
     }
 }
 
@@ -63,9 +63,10 @@ public:
     /// Lowpass filter the data in a TimeSeriesTable at a provided cutoff
     /// frequency. If padData is true, then the data is first padded with pad()
     /// using numRowsToPrependAndAppend = table.getNumRows() / 2.
-    /// The filtering is performed with Signal::LowpassIIR()
+    /// The filtering is performed with Signal::LowpassIIR(), which filters
+    /// all columns together, using numThreads threads.
     static void filterLowpass(TimeSeriesTable& table,
-            double cutoffFreq, bool padData = false);
+            double cutoffFreq, bool padData = false, int numThreads = 1);
 
     /// Pad each column by the number of rows specified. The padded data is
     /// obtained by reflecting and negating the data in the table.
@@ -0,0 +1,153 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  benchmarkStorage.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Benchmark for the column operations of Storage (column extraction,
+// resampling, padding and filtering) on a large, synthetic data set. It does
+// not depend on any data files.
+//
+// Usage:
+//     benchmarkStorage [number_of_rows] [number_of_columns]
+//
+// The default is 100000 rows of 50 columns sampled at 1 kHz. Every operation
+// is applied to a fresh copy of the same Storage, and the wall time of each
+// is printed and written to storage_benchmark.csv.
+
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Common/Storage.h>
+
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+using namespace OpenSim;
+
+namespace {
+
+struct OperationResult {
+    std::string operation;
+    double wallTime;
+    double checksum;
+};
+
+Storage createStorage(int numRows, int numColumns) {
+    Storage storage(numRows);
+    Array<std::string> labels("", numColumns + 1);
+    labels[0] = "time";
+    for (int c = 0; c < numColumns; ++c) {
+        labels[c + 1] = "column" + std::to_string(c);
+    }
+    storage.setColumnLabels(labels);
+
+    std::vector<double> row(numColumns);
+    for (int r = 0; r < numRows; ++r) {
+        const double time = 0.001 * r;
+        for (int c = 0; c < numColumns; ++c) {
+            row[c] = std::sin(2 * SimTK::Pi * (1.0 + 0.1 * c) * time) +
+                     0.05 * std::sin(2 * SimTK::Pi * 90.0 * time + c);
+        }
+        storage.append(time, numColumns, row.data(), false);
+    }
+    return storage;
+}
+
+// Sum of the last row, so that the work done by an operation is observable.
+double checksum(const Storage& storage) {
+    const StateVector* last = storage.getLastStateVector();
+    if (!last) { return 0; }
+    double sum = 0;
+    for (int c = 0; c < last->getSize(); ++c) {
+        sum += last->getData()[c];
+    }
+    return sum;
+}
+
+void timeOperation(std::vector<OperationResult>& results,
+        const Storage& original, const std::string& operation,
+        const std::function<double(Storage&)>& run) {
+    Storage storage(original);
+    Stopwatch watch;
+    const double sum = run(storage);
+    results.push_back({operation, watch.getElapsedTime(), sum});
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const int numRows = argc > 1 ? std::stoi(argv[1]) : 100000;
+        const int numColumns = argc > 2 ? std::stoi(argv[2]) : 50;
+
+        Stopwatch watch;
+        const Storage original = createStorage(numRows, numColumns);
+        std::vector<OperationResult> results;
+        results.push_back({"create", watch.getElapsedTime(), 0});
+
+        timeOperation(results, original, "getDataColumn", [&](Storage& s) {
+            double sum = 0;
+            Array<double> column;
+            for (int c = 0; c < numColumns; ++c) {
+                s.getDataColumn(c, column);
+                sum += column.getLast();
+            }
+            return sum;
+        });
+        timeOperation(results, original, "resampleLinear", [](Storage& s) {
+            s.resampleLinear(0.0005);
+            return checksum(s);
+        });
+        timeOperation(results, original, "pad", [](Storage& s) {
+            s.pad(s.getSize() / 2);
+            return checksum(s);
+        });
+        timeOperation(results, original, "lowpassIIR", [](Storage& s) {
+            s.lowpassIIR(6.0);
+            return checksum(s);
+        });
+        timeOperation(results, original, "lowpassFIR", [](Storage& s) {
+            s.lowpassFIR(50, 6.0);
+            return checksum(s);
+        });
+        timeOperation(results, original, "smoothSpline", [](Storage& s) {
+            s.smoothSpline(3, 6.0);
+            return checksum(s);
+        });
+        timeOperation(results, original, "exportToTable", [](Storage& s) {
+            const TimeSeriesTable table = s.exportToTable();
+            return SimTK::sum(table.getRowAtIndex(table.getNumRows() - 1));
+        });
+
+        std::ofstream csv("storage_benchmark.csv");
+        csv << "rows,columns,operation,wall_time,checksum\n";
+        log_cout("Storage with {} rows and {} columns:", numRows, numColumns);
+        for (const auto& r : results) {
+            csv << numRows << "," << numColumns << "," << r.operation << ","
+                << r.wallTime << "," << r.checksum << "\n";
+            log_cout("  {:<16} {:>10.4f} s", r.operation, r.wallTime);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
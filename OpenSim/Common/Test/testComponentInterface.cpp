@@ -3133,6 +3133,55 @@ TEST_CASE("Component Interface Get Absolute Path String Speed")
     cout << "getName avgTime = " << avgTime / numTrials << "s" << endl;
 }
 
+TEST_CASE("Component Interface Path Index Lookups")
+{
+    TheWorld A;
+    A.setName("A");
+    TheWorld* B = new TheWorld();
+    B->setName("B");
+    TheWorld* C = new TheWorld();
+    C->setName("C");
+    A.add(B);
+    B->add(C);
+
+    // finalizeConnections() on the root indexes the whole tree.
+    A.connect();
+    CHECK(&A.getComponent("/B/C") == C);
+    CHECK(&A.getComponent("B/C") == C);
+    CHECK(&A.getComponent<Sub>("B/internalSub") ==
+            &B->getComponent<Sub>("internalSub"));
+    CHECK(&B->getComponent("/B/C") == C);
+    CHECK(&B->getComponent("C") == C);
+    CHECK(&C->getComponent("../C") == C);
+    CHECK(A.hasComponent<TheWorld>("/B/C"));
+    CHECK_FALSE(A.hasComponent<Sub>("/B/C"));
+    CHECK_FALSE(A.hasComponent("/B/Nonexistent"));
+    CHECK_THROWS_AS(A.getComponent<Sub>("/B/C"),
+            ComponentNotFoundOnSpecifiedPath);
+
+    // A renamed component is no longer found at its old path.
+    C->setName("D");
+    CHECK_FALSE(A.hasComponent("/B/C"));
+    CHECK(&A.getComponent("/B/D") == C);
+
+    // Adding a component invalidates the index until it is rebuilt.
+    TheWorld* E = new TheWorld();
+    E->setName("E");
+    B->add(E);
+    CHECK(&A.getComponent("/B/E") == E);
+    A.connect();
+    CHECK(&A.getComponent("/B/E") == E);
+    CHECK(&A.updComponent<TheWorld>("B/D") == C);
+
+    // Renaming an owner moves all of its subcomponents to new paths.
+    B->setName("F");
+    CHECK_FALSE(A.hasComponent("/B/D"));
+    CHECK_FALSE(A.hasComponent("B/D"));
+    CHECK_THROWS_AS(A.getComponent("/B/D"), ComponentNotFoundOnSpecifiedPath);
+    CHECK(&A.getComponent("/F/D") == C);
+    CHECK(&A.getComponent("F/D") == C);
+}
+
 TEST_CASE("Component Interface Formatted DateTime Works as Expected")
 {
     std::string withMicroseconds = getFormattedDateTime(true, "%Y");
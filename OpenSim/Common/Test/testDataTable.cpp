@@ -29,6 +29,7 @@
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
 using namespace SimTK;
@@ -976,6 +977,46 @@ TEST_CASE("TableUtilities::filterLowpass") {
     }
 }
 
+TEST_CASE("TableUtilities::filterLowpass multiple columns") {
+    const int numRows = 500;
+    const int numColumns = 21;
+
+    // The sampling interval is exact, so that the table is not resampled.
+    const double dt = 1.0 / 1024.0;
+    std::vector<double> time(numRows);
+    for (int irow = 0; irow < numRows; ++irow) time[irow] = irow * dt;
+    TimeSeriesTable table(time);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        table.appendColumn("c" + std::to_string(icol),
+                SimTK::Test::randVector(numRows));
+    }
+
+    // Each column filtered on its own.
+    SimTK::Matrix expected(numRows, numColumns);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        SimTK::Vector column = table.getDependentColumnAtIndex(icol);
+        SimTK::Vector filtered(numRows);
+        Signal::LowpassIIR(dt, 20.0, numRows,
+                column.getContiguousScalarData(),
+                filtered.updContiguousScalarData());
+        expected.updCol(icol) = filtered;
+    }
+
+    for (int numThreads : {1, 3}) {
+        CAPTURE(numThreads);
+        TimeSeriesTable filteredTable = table;
+        TableUtilities::filterLowpass(filteredTable, 20.0, false, numThreads);
+        REQUIRE(filteredTable.getNumRows() == numRows);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            const auto& column = filteredTable.getDependentColumnAtIndex(icol);
+            for (int irow = 0; irow < numRows; ++irow) {
+                CHECK(column[irow] ==
+                        Approx(expected(irow, icol)).margin(1e-12));
+            }
+        }
+    }
+}
+
 TEST_CASE("TableUtilities::pad") {
     Storage sto("test.sto");
     TimeSeriesTable paddedTable = sto.exportToTable();
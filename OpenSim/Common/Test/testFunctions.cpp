@@ -27,6 +27,7 @@
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/SignalGenerator.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/Sine.h>
 #include <OpenSim/Common/ExpressionBasedFunction.h>
 
@@ -349,4 +350,41 @@ TEST_CASE("ExpressionBasedFunction") {
         REQUIRE_THAT(f.calcDerivative({2}, createVector({x, y, z})), 
                 Catch::Matchers::WithinAbs(-y*std::sin(z), 1e-10));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("SimmSpline batch evaluation") {
+    const int numKnots = 50;
+    std::vector<double> x(numKnots), y(numKnots);
+    for (int i = 0; i < numKnots; ++i) {
+        x[i] = 0.01 * i + 0.002 * std::sin(i);
+        y[i] = std::sin(3 * x[i]);
+    }
+    SimmSpline spline(numKnots, x.data(), y.data());
+
+    // The knots themselves, points between the knots, points outside the
+    // range of the spline, and an unsorted tail.
+    std::vector<double> points = x;
+    for (int i = -5; i < 10 * numKnots; ++i) {
+        points.push_back(0.001 * i);
+    }
+    points.push_back(0.25);
+    points.push_back(0.02);
+    const int n = (int)points.size();
+
+    std::vector<double> values(n), first(n), second(n);
+    spline.calcValuesAndDerivatives(
+            n, points.data(), values.data(), first.data(), second.data());
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Vector point(1, points[i]);
+        CHECK(values[i] == Approx(spline.calcValue(point)).margin(1e-12));
+        CHECK(first[i] ==
+                Approx(spline.calcDerivative({0}, point)).margin(1e-9));
+        CHECK(second[i] ==
+                Approx(spline.calcDerivative({0, 0}, point)).margin(1e-6));
+    }
+
+    // Outputs that are not needed may be omitted.
+    std::vector<double> firstOnly(n);
+    spline.calcValuesAndDerivatives(
+            n, points.data(), nullptr, firstOnly.data(), nullptr);
+    CHECK(firstOnly == first);
+}
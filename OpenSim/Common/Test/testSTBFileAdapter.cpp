@@ -0,0 +1,127 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  testSTBFileAdapter.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/Storage.h"
+#include <fstream>
+
+#include <catch2/catch_all.hpp>
+
+using namespace OpenSim;
+
+namespace {
+    TimeSeriesTable createTable(int numRows, int numColumns) {
+        std::vector<double> time(numRows);
+        SimTK::Matrix data(numRows, numColumns);
+        std::vector<std::string> labels;
+        for (int c = 0; c < numColumns; ++c) {
+            labels.push_back("column" + std::to_string(c));
+        }
+        for (int r = 0; r < numRows; ++r) {
+            time[r] = 0.01 * r;
+            for (int c = 0; c < numColumns; ++c) {
+                data(r, c) = std::sin(0.1 * r + c) + 1e-12 * c;
+            }
+        }
+        TimeSeriesTable table(time, data, labels);
+        table.addTableMetaData<std::string>("inDegrees", "yes");
+        table.addTableMetaData<std::string>("header", "line one\nline two");
+        return table;
+    }
+}
+
+TEST_CASE("STBFileAdapter round trip") {
+    const TimeSeriesTable table = createTable(257, 7);
+    STBFileAdapter::write(table, "testSTBFileAdapter.stb");
+
+    SECTION("TimeSeriesTable") {
+        TimeSeriesTable copy("testSTBFileAdapter.stb");
+        REQUIRE(copy.getColumnLabels() == table.getColumnLabels());
+        REQUIRE(copy.getIndependentColumn() == table.getIndependentColumn());
+        // Values are stored in binary, so they are reproduced exactly.
+        CHECK(SimTK::max(SimTK::abs(copy.getMatrix() - table.getMatrix()))
+                == 0);
+        CHECK(copy.getTableMetaData<std::string>("inDegrees") == "yes");
+        CHECK(copy.getTableMetaData<std::string>("header") ==
+                "line one\nline two");
+    }
+
+    SECTION("STBFileView") {
+        STBFileView view("testSTBFileAdapter.stb");
+        REQUIRE(view.getNumRows() == table.getNumRows());
+        REQUIRE(view.getNumColumns() == table.getNumColumns());
+        CHECK(view.getColumnIndex("column3") == 3);
+        CHECK_THROWS_AS(view.getColumnIndex("missing"), KeyNotFound);
+        const double* column = view.getDependentColumn("column3");
+        for (int r = 0; r < (int)table.getNumRows(); ++r) {
+            CHECK(view.getIndependentColumn()[r] ==
+                    table.getIndependentColumn()[r]);
+            CHECK(column[r] == table.getMatrix()(r, 3));
+        }
+    }
+
+    SECTION("Storage") {
+        Storage storage("testSTBFileAdapter.stb");
+        CHECK(storage.isInDegrees());
+        REQUIRE(storage.getSize() == (int)table.getNumRows());
+        REQUIRE(storage.getColumnLabels().getSize() ==
+                (int)table.getNumColumns() + 1);
+        CHECK(storage.getColumnLabels()[0] == "time");
+        CHECK(storage.getColumnLabels()[2] == "column1");
+        double value;
+        storage.getDataAtTime(table.getIndependentColumn()[10], 1, &value);
+        CHECK(value == table.getMatrix()(10, 0));
+    }
+}
+
+TEST_CASE("STBFileAdapter writes and reads an empty table") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    STBFileAdapter::write(table, "testSTBFileAdapterEmpty.stb");
+    TimeSeriesTable copy("testSTBFileAdapterEmpty.stb");
+    CHECK(copy.getNumRows() == 0);
+    CHECK(copy.getColumnLabels() == table.getColumnLabels());
+}
+
+TEST_CASE("STBFileAdapter rejects invalid files") {
+    {
+        std::ofstream out("testSTBFileAdapterInvalid.stb");
+        out << "time\tcolumn0\n0\t1\n";
+    }
+    CHECK_THROWS_AS(STBFileView("testSTBFileAdapterInvalid.stb"), IOError);
+    CHECK_THROWS_AS(STBFileView("testSTBFileAdapterMissing.stb"),
+            FileDoesNotExist);
+
+    // Truncate the data block of a valid file.
+    STBFileAdapter::write(createTable(100, 3), "testSTBFileAdapter.stb");
+    std::string contents;
+    {
+        std::ifstream in("testSTBFileAdapter.stb", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out("testSTBFileAdapterTruncated.stb", std::ios::binary);
+        out.write(contents.data(), contents.size() - sizeof(double));
+    }
+    CHECK_THROWS_AS(STBFileView("testSTBFileAdapterTruncated.stb"), IOError);
+}
@@ -23,8 +23,12 @@
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
 #include "OpenSim/Common/IO.h"
+#include "OpenSim/Common/Storage.h"
+#include <cmath>
 #include <cstdio>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <unordered_set>
 
 #include <catch2/catch_all.hpp>
@@ -353,3 +357,123 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+TEST_CASE("IO::TryParseDouble matches stream parsing") {
+    const std::vector<std::string> tokens{"0", "-0", "1", "-1.5", "+2.25",
+            "0.1", "3.141592653589793", "-0.0000123456789", "1e-7", "2.5E+10",
+            "123456789012345678", "1234567890123456789012", "9007199254740993",
+            "1e22", "1e23", "1e-300", "4.9406564584124654e-324", ".5", "5.",
+            "  7.25\t", "1.5abc", "", "nan", "abc", "-", "1e"};
+    for (const auto& token : tokens) {
+        CAPTURE(token);
+        std::istringstream stream(token);
+        stream.imbue(std::locale::classic());
+        double expected;
+        stream >> expected;
+        const bool expectedOk = !stream.fail();
+
+        double parsed;
+        const bool ok = IO::TryParseDouble(
+                token.data(), token.data() + token.size(), parsed);
+        CHECK(ok == expectedOk);
+        if (ok) {
+            CHECK(parsed == expected);
+            CHECK(std::signbit(parsed) == std::signbit(expected));
+        } else {
+            CHECK(SimTK::isNaN(parsed));
+        }
+    }
+
+    SimTK::Random::Uniform random(-1e6, 1e6);
+    random.setSeed(0);
+    for (int i = 0; i < 10000; ++i) {
+        std::ostringstream out;
+        out << std::setprecision(1 + i % 17) << random.getValue();
+        const std::string token = out.str();
+        CAPTURE(token);
+        double parsed;
+        REQUIRE(IO::TryParseDouble(
+                token.data(), token.data() + token.size(), parsed));
+        CHECK(parsed == std::stod(token));
+    }
+}
+
+TEST_CASE("Large STO files are parsed consistently") {
+    // Large enough for the rows to be parsed concurrently.
+    const int numRows = 4000;
+    const int numColumns = 60;
+    std::vector<double> time(numRows);
+    SimTK::Matrix data(numRows, numColumns);
+    std::vector<std::string> labels;
+    for (int c = 0; c < numColumns; ++c) {
+        labels.push_back("column" + std::to_string(c));
+    }
+    for (int r = 0; r < numRows; ++r) {
+        time[r] = 0.001 * r;
+        for (int c = 0; c < numColumns; ++c) {
+            data(r, c) = std::sin(0.01 * r + 0.1 * c) * std::pow(10.0, c % 7);
+        }
+    }
+    const std::string filename = "testing_large_file.sto";
+    STOFileAdapter::write(TimeSeriesTable(time, data, labels), filename);
+
+    // Reference values, parsed with a stream.
+    SimTK::Matrix expected(numRows, numColumns);
+    {
+        std::ifstream in(filename);
+        std::string line;
+        while (std::getline(in, line) && line != "endheader") {}
+        std::getline(in, line);
+        for (int r = 0; r < numRows; ++r) {
+            double t;
+            in >> t;
+            for (int c = 0; c < numColumns; ++c) in >> expected(r, c);
+        }
+    }
+
+    TimeSeriesTable table(filename);
+    REQUIRE(table.getNumRows() == numRows);
+    REQUIRE(table.getNumColumns() == numColumns);
+    CHECK(SimTK::max(SimTK::abs(table.getMatrix() - expected)) == 0);
+
+    Storage storage(filename);
+    REQUIRE(storage.getSize() == numRows);
+    SimTK::Vector row(numColumns);
+    storage.getDataAtTime(table.getIndependentColumn()[1234], numColumns,
+            row);
+    for (int c = 0; c < numColumns; ++c) CHECK(row[c] == expected(1234, c));
+
+    // Version 1 files, as written by Storage, are read by Storage itself.
+    const std::string filenameV1 = "testing_large_file_v1.sto";
+    storage.print(filenameV1);
+    SimTK::Matrix expectedV1(numRows, numColumns);
+    {
+        std::ifstream in(filenameV1);
+        std::string line;
+        while (std::getline(in, line) && line != "endheader") {}
+        std::getline(in, line);
+        for (int r = 0; r < numRows; ++r) {
+            double t;
+            in >> t;
+            for (int c = 0; c < numColumns; ++c) in >> expectedV1(r, c);
+        }
+    }
+    Storage storageV1(filenameV1);
+    REQUIRE(storageV1.getSize() == numRows);
+    storageV1.getDataAtTime(table.getIndependentColumn()[1234], numColumns,
+            row);
+    for (int c = 0; c < numColumns; ++c) CHECK(row[c] == expectedV1(1234, c));
+
+    // A row with a missing value reports its line number.
+    {
+        std::ifstream in(filename);
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                std::istreambuf_iterator<char>());
+        const size_t lastTab = contents.rfind('\t');
+        contents.erase(lastTab, contents.find('\n', lastTab) - lastTab);
+        std::ofstream out("testing_large_file_bad_row.sto");
+        out << contents;
+    }
+    CHECK_THROWS_AS(TimeSeriesTable("testing_large_file_bad_row.sto"),
+            RowLengthMismatch);
+}
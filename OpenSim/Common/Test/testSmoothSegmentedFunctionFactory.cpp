@@ -41,10 +41,13 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <stdio.h>
+#include <vector>
 
 
 using namespace std;
@@ -1914,3 +1917,66 @@ TEST_CASE("SmoothSegmentedFunctionFactory")
         cout << "    passed"<<endl;
 }
 
+
+TEST_CASE("SmoothSegmentedFunction tabulation")
+{
+    std::vector<std::unique_ptr<SmoothSegmentedFunction>> curves;
+    curves.emplace_back(SmoothSegmentedFunctionFactory::
+        createTendonForceLengthCurve(0.04, 1.5/0.04, 1.0/3.0, 0.5, false,
+            "test_tendonCurve"));
+    curves.emplace_back(SmoothSegmentedFunctionFactory::
+        createFiberForceVelocityCurve(1.8, 0.1, 0.15, 5, 0.1, 0.1001, 0.1,
+            0.75, false, "test_fiberForceVelocityCurve"));
+    curves.emplace_back(SmoothSegmentedFunctionFactory::
+        createFiberActiveForceLengthCurve(0.4, 0.75, 1, 1.6, 0.05, 0.75,
+            0.75, false, "test_fiberActiveForceLengthCurve"));
+
+    const double tol = 1e-8;
+    for (const auto& curve : curves) {
+        CAPTURE(curve->getName());
+        SmoothSegmentedFunction tabulated(*curve);
+        CHECK_FALSE(tabulated.isTabulated());
+        tabulated.tabulate(tol);
+        CHECK(tabulated.isTabulated());
+        CHECK_FALSE(curve->isTabulated());
+
+        // Sample the curve densely, including the linear extrapolation on
+        // either side of the curve domain.
+        const SimTK::Vec2 domain = curve->getCurveDomain();
+        const double width = domain(1) - domain(0);
+        const int n = 2000;
+        double maxCurvature = 0;
+        for (int i = 0; i <= n; ++i) {
+            const double x = domain(0) - 0.1*width + 1.2*width*i/n;
+            maxCurvature =
+                std::max(maxCurvature, std::abs(curve->calcDerivative(x, 2)));
+        }
+        for (int i = 0; i <= n; ++i) {
+            const double x = domain(0) - 0.1*width + 1.2*width*i/n;
+            const double y = curve->calcValue(x);
+            const double dydx = curve->calcDerivative(x, 1);
+            CHECK(std::abs(tabulated.calcValue(x) - y) <=
+                    10*tol*(1 + std::abs(y)));
+            CHECK(std::abs(tabulated.calcDerivative(x, 1) - dydx) <=
+                    10*tol*(1 + std::abs(dydx)));
+            CHECK(std::abs(tabulated.calcDerivative(x, 2) -
+                           curve->calcDerivative(x, 2)) <=
+                    1e-3*(1 + maxCurvature));
+            const auto valueAndDerivative =
+                tabulated.calcValueAndFirstDerivative(x);
+            CHECK(valueAndDerivative.value == tabulated.calcValue(x));
+            CHECK(valueAndDerivative.derivative ==
+                    tabulated.calcDerivative(x, 1));
+            // Higher derivatives are not tabulated.
+            CHECK(tabulated.calcDerivative(x, 3) ==
+                    curve->calcDerivative(x, 3));
+        }
+
+        tabulated.clearTabulation();
+        CHECK_FALSE(tabulated.isTabulated());
+        CHECK(tabulated.calcValue(domain(0) + 0.3*width) ==
+                curve->calcValue(domain(0) + 0.3*width));
+    }
+
+    CHECK_THROWS(curves[0]->tabulate(0));
+}
@@ -29,6 +29,7 @@
 
 
 #include <OpenSim/Common/Adapters.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/SimmSpline.h>
 #include "OpenSim/Common/Constant.h"
 #include <OpenSim/Common/PolynomialFunction.h>
@@ -38,6 +39,7 @@
 #include <OpenSim/Common/GCVSplineSet.h>
 
 #include <OpenSim/Tools/IKCoordinateTask.h>
+#include <OpenSim/Tools/ParallelInverseKinematics.h>
 #include <OpenSim/Analyses/Kinematics.h>
 
 #include "OpenSim/Simulation/Model/Smith2018ArticularContactForce.h"
@@ -103,6 +105,7 @@ void COMAKInverseKinematicsTool::constructProperties()
     constructProperty_output_motion_file("");
     constructProperty_ik_constraint_weight(SimTK::Infinity);
     constructProperty_ik_accuracy(1e-5);
+    constructProperty_ik_num_threads(1);
     Array<double> range{SimTK::Infinity, 2};
     range[0] = -SimTK::Infinity; 
     constructProperty_time_range(range);
@@ -1071,23 +1074,9 @@ void COMAKInverseKinematicsTool::runInverseKinematics(Model& model) {
             coordinateReferences, get_ik_constraint_weight());
         ikSolver.setAccuracy(get_ik_accuracy());
         s.updTime() = times[start_ix];
-
-        for (int i = 0; i < 7; ++i) {
-            try {
-                ikSolver.assemble(s);
-                break;
-            }
-            catch (std::exception const&){
-                try {
-                    ikSolver.track(s);
-                    break;
-                }
-                catch (std::exception const&) {
-                    log_error("Assembly failed... " 
-                        "retrying with new initial conditions.");
-                }
-            }
-        }
+        // The blocks of frames solved in parallel are assembled the same way.
+        const int maxAssemblyAttempts = 7;
+        assembleInverseKinematicsFrame(ikSolver, s, maxAssemblyAttempts);
 
         kinematicsReporter->begin(s);
 
@@ -1107,9 +1096,32 @@ void COMAKInverseKinematicsTool::runInverseKinematics(Model& model) {
 
         Stopwatch watch;
 
+        // With multiple threads, solve all frames first, then report them in
+        // order as if they had been solved here.
+        OPENSIM_THROW_IF_FRMOBJ(get_ik_num_threads() < 1, Exception,
+                "Expected 'ik_num_threads' to be at least 1, but got {}.",
+                get_ik_num_threads());
+        const int numThreads =
+                std::min(get_ik_num_threads(), getMaxNumThreads());
+        const bool parallel = numThreads > 1;
+        InverseKinematicsFrames frames;
+        if (parallel) {
+            frames = solveInverseKinematicsFrames(model, markersReference,
+                    coordinateReferences, get_ik_constraint_weight(),
+                    get_ik_accuracy(), start_ix, final_ix,
+                    numThreads, get_report_errors(),
+                    get_report_marker_locations(), false,
+                    maxAssemblyAttempts);
+        }
+
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
-            ikSolver.track(s);
+            if (parallel) {
+                s.updQ() = ~frames.q[i - start_ix];
+                model.realizePosition(s);
+            } else {
+                ikSolver.track(s);
+            }
             // show progress line every 1000 frames so users see progress
             if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
                 std::cout << "Solved " << i - start_ix << " frames..." << std::endl;
@@ -1119,7 +1131,14 @@ void COMAKInverseKinematicsTool::runInverseKinematics(Model& model) {
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+                if (parallel) {
+                    for (int j = 0; j < nm; ++j)
+                        squaredMarkerErrors[j] =
+                                frames.squaredMarkerErrors(i - start_ix, j);
+                } else {
+                    ikSolver.computeCurrentSquaredMarkerErrors(
+                            squaredMarkerErrors);
+                }
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -1142,11 +1161,14 @@ void COMAKInverseKinematicsTool::runInverseKinematics(Model& model) {
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
+                if (!parallel)
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
-                        locations.set(3*j+k, markerLocations[j][k]);
+                        locations.set(3*j+k, parallel ?
+                                frames.markerLocations(i - start_ix, 3*j+k) :
+                                markerLocations[j][k]);
                 }
 
                 modelMarkerLocations->append(s.getTime(), 3*nm, &locations[0]);
@@ -186,6 +186,15 @@ public:
         "Default is 1e-5. It determines the number of significant digits to "
         "which the solution can be trusted.");
 
+    OpenSim_DECLARE_PROPERTY(ik_num_threads, int,
+        "Number of threads used to solve the inverse kinematics frames. With "
+        "1 (the default), the frames are solved in sequence, each one "
+        "starting from the solution of the previous frame. With more "
+        "threads, the trial is split into contiguous blocks of frames that "
+        "are solved concurrently, each block starting from an assembly of "
+        "its first frame. The number of threads is limited by the "
+        "OPENSIM_MAX_THREADS environment variable, if set.");
+
     OpenSim_DECLARE_UNNAMED_PROPERTY(IKTaskSet, 
         "Markers and coordinates to be considered (tasks) and their weightings. "
         "The sum of weighted-squared task errors composes the cost function."); 
@@ -64,6 +64,9 @@ ComakTarget(SimTK::State s, Model* aModel,
     _contact_energy_weight = 0.0;
     _non_muscle_actuator_weight = 1000;
 
+    _nRealizeAcceleration = 0;
+    _nObjectiveEvaluations = 0;
+    _nGradientEvaluations = 0;
 }
 
 void ComakTarget::initialize(){
@@ -202,6 +205,7 @@ void ComakTarget::precomputeConstraintMatrix() {
 
         msl.setOverrideActuation(_state, force + 1.0);
 
+        ++_nRealizeAcceleration;
         _model->realizeAcceleration(_state);
         
         int k = 0;
@@ -233,6 +237,7 @@ void ComakTarget::precomputeConstraintMatrix() {
 
         actuator.setOverrideActuation(_state, force + 1.0);
 
+        ++_nRealizeAcceleration;
         _model->realizeAcceleration(_state);
         
         int k = 0;
@@ -266,6 +271,7 @@ void ComakTarget::precomputeConstraintMatrix() {
 
         optim_coord.setValue(_state, value,true);
         
+        ++_nRealizeAcceleration;
         _model->realizeAcceleration(_state);
         
         int k = 0;
@@ -295,6 +301,7 @@ void ComakTarget::precomputeConstraintMatrix() {
 
         optim_coord.setValue(_state, init_value, true);
     }
+    ++_nRealizeAcceleration;
     _model->realizeAcceleration(_state);
 
     //Compute COMAK damping unit udot
@@ -309,6 +316,7 @@ void ComakTarget::precomputeConstraintMatrix() {
 
         optim_coord.setSpeedValue(_state, init_speed + speed_epsilon);
 
+        ++_nRealizeAcceleration;
         _model->realizeAcceleration(_state);
 
         int k = 0;
@@ -426,6 +434,7 @@ void ComakTarget::realizeAccelerationFromParameters
     }
 
     _model->assemble(s);
+    ++_nRealizeAcceleration;
     _model->realizeAcceleration(s);
 }
 
@@ -441,6 +450,7 @@ int ComakTarget::
 objectiveFunc(const SimTK::Vector &parameters, const bool new_parameters,
     SimTK::Real &performance) const
 {
+    ++_nObjectiveEvaluations;
     int p = 0;
 
     //Muscle Activations
@@ -496,6 +506,7 @@ int ComakTarget::
 gradientFunc(const SimTK::Vector &parameters, const bool new_parameters,
     SimTK::Vector &gradient) const
 {
+    ++_nGradientEvaluations;
     gradient = 0;
     int p = 0;
     /*for (int i = 0; i < _nMuscles; i++) {
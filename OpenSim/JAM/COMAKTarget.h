@@ -162,6 +162,19 @@ public:
     void setEmgGammaWeight(SimTK::Vector weight) {
         _emg_gamma_weight = weight;
     }
+
+    /** Number of Model::realizeAcceleration() calls made so far, most of them
+     * while precomputing the constraint matrix. */
+    int getNumRealizeAccelerationCalls() const {
+        return _nRealizeAcceleration;
+    }
+
+    /** Number of objective function evaluations requested by the optimizer.*/
+    int getNumObjectiveEvaluations() const { return _nObjectiveEvaluations; }
+
+    /** Number of objective gradient evaluations requested by the optimizer.
+     * IPOPT evaluates the gradient once per iteration. */
+    int getNumGradientEvaluations() const { return _nGradientEvaluations; }
     //=========================================================================
     // DATA
     //=========================================================================
@@ -222,6 +235,10 @@ private:
     double _scale_delta_coord;
 
     SimTK::Matrix _constraint_matrix;
+
+    int _nRealizeAcceleration;
+    mutable int _nObjectiveEvaluations;
+    mutable int _nGradientEvaluations;
 protected:
 };
 
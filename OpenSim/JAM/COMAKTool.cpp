@@ -19,6 +19,7 @@
 #include "COMAKTarget.h"
 #include "JAMUtilities.h"
 #include "OpenSim/Actuators/CoordinateActuator.h"
+#include "OpenSim/Actuators/ModelFactory.h"
 #include "OpenSim/Common/Constant.h"
 #include "OpenSim/Simulation/Model/Blankevoort1991Ligament.h"
 #include "OpenSim/Simulation/Model/Smith2018ArticularContactForce.h"
@@ -31,9 +32,47 @@
 #include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Common/XMLDocument.h>
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace SimTK;
 
+namespace {
+// Adds the wall time between construction and stop() (or destruction) to an
+// accumulator.
+class ProfileTimer {
+public:
+    explicit ProfileTimer(double& accumulator) : _accumulator(accumulator) {}
+    ~ProfileTimer() { stop(); }
+    void stop() {
+        if (_running) {
+            _accumulator += _stopwatch.getElapsedTime();
+            _running = false;
+        }
+    }
+
+private:
+    double& _accumulator;
+    Stopwatch _stopwatch;
+    bool _running = true;
+};
+
+Smith2018ArticularContactForce::RayCastCounts sumRayCastCounts(
+        const Model& model) {
+    Smith2018ArticularContactForce::RayCastCounts total;
+    for (const auto& contact :
+            model.getComponentList<Smith2018ArticularContactForce>()) {
+        const auto& counts = contact.getRayCastCounts();
+        total.rays += counts.rays;
+        total.same_triangle += counts.same_triangle;
+        total.neighbor_triangle += counts.neighbor_triangle;
+        total.obb_search += counts.obb_search;
+        total.obb_hit += counts.obb_hit;
+    }
+    return total;
+}
+} // namespace
+
 COMAKTool::COMAKTool() {
     constructProperties();
     //_directoryOfSetupFile = "";
@@ -57,6 +96,7 @@ void COMAKTool::constructProperties() {
 
     constructProperty_replace_force_set(false);
     constructProperty_force_set_file("");
+    constructProperty_function_based_paths_file("");
 
     constructProperty_start_time(-1);
     constructProperty_stop_time(-1);
@@ -104,6 +144,7 @@ void COMAKTool::constructProperties() {
     constructProperty_model_assembly_accuracy(1e-12);
     constructProperty_geometry_folder("");
     constructProperty_use_visualizer(false);
+    constructProperty_print_profile(false);
 
     constructProperty_AnalysisSet(AnalysisSet());
     // Amir
@@ -148,6 +189,8 @@ bool COMAKTool::run() {
 
         const long long elapsed = stopwatch.getElapsedTimeInNs();
 
+        printProfileSummary(SimTK::nsToSec(elapsed));
+
         log_info("COMAK complete.");
         log_info("Finished in {}", stopwatch.formatNs(elapsed));
         log_info("Printed results to: {}", get_results_directory());
@@ -193,6 +236,15 @@ SimTK::State COMAKTool::initialize() {
 
     updateModelForces();
 
+    if (!get_function_based_paths_file().empty()) {
+        log_info("Replacing force paths with FunctionBasedPaths from {}",
+            get_function_based_paths_file());
+        _model.finalizeFromProperties();
+        _model.finalizeConnections();
+        ModelFactory::replacePathsWithFunctionBasedPaths(_model,
+            Set<FunctionBasedPath>(get_function_based_paths_file()));
+    }
+
     SimTK::State state = _model.initSystem();
 
     // Verfiy Coordinate Properties
@@ -652,10 +704,18 @@ SimTK::State COMAKTool::initialize() {
 
 void COMAKTool::performCOMAK() {
 
+    initializeProfile();
+
+    ProfileTimer initialize_timer(
+            _profile_total.phase_time[ProfileInitialize]);
     SimTK::State state = initialize();
+    initialize_timer.stop();
 
     // Read Kinematics and Compute Desired Accelerations
-    extractKinematicsFromFile();
+    {
+        ProfileTimer timer(_profile_total.phase_time[ProfileReadKinematics]);
+        extractKinematicsFromFile();
+    }
 
     // Check Cost Function Parameters
     log_info("{:<20} {:<20} {:<20} {:<20} {:<20} {:<20}", "Muscles",
@@ -686,6 +746,7 @@ void COMAKTool::performCOMAK() {
     SimTK::Vector init_secondary_values(_n_secondary_coord);
 
     if (get_settle_secondary_coordinates_at_start()) {
+        ProfileTimer timer(_profile_total.phase_time[ProfileSettle]);
         init_secondary_values = equilibriateSecondaryCoordinates();
     } else {
         for (int i = 0; i < _n_secondary_coord; ++i) {
@@ -724,7 +785,10 @@ void COMAKTool::performCOMAK() {
 
     _model.set_assembly_accuracy(get_model_assembly_accuracy());
 
-    state = _model.initSystem();
+    {
+        ProfileTimer timer(_profile_total.phase_time[ProfileInitialize]);
+        state = _model.initSystem();
+    }
 
     // Visualizer Settings
     SimTK::Visualizer* viz = NULL;
@@ -777,6 +841,11 @@ void COMAKTool::performCOMAK() {
         if (_time[i] < get_start_time()) { continue; }
         if (_time[i] > get_stop_time()) { break; };
 
+        const Stopwatch frame_stopwatch;
+        ProfileCounters frame;
+        const auto frame_start_ray_casts = sumRayCastCounts(_model);
+        ProfileTimer setup_timer(frame.phase_time[ProfileFrameSetup]);
+
         // Set Time
         state.setTime(_time[i]);
 
@@ -840,6 +909,7 @@ void COMAKTool::performCOMAK() {
 
         _model.assemble(state);
         _model.realizeVelocity(state);
+        setup_timer.stop();
 
         // Print initial optimization
         if (frame_num == 1 && get_verbose() > 1) {
@@ -936,8 +1006,13 @@ void COMAKTool::performCOMAK() {
             }
             target.setDesiredActivation(desired_act);
 
-            target.initialize();
+            {
+                ProfileTimer timer(
+                        frame.phase_time[ProfileConstraintMatrix]);
+                target.initialize();
+            }
 
+            ProfileTimer optimizer_timer(frame.phase_time[ProfileOptimizer]);
             SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
             SimTK::Optimizer optimizer(target, algorithm);
 
@@ -977,6 +1052,14 @@ void COMAKTool::performCOMAK() {
             catch (const SimTK::Exception::Base& ex) {
                 log_error("COMAK Optimization failed: {}", ex.getMessage());
             }
+            optimizer_timer.stop();
+
+            frame.realize_acceleration +=
+                    target.getNumRealizeAccelerationCalls();
+            frame.objective_evaluations += target.getNumObjectiveEvaluations();
+            frame.gradient_evaluations += target.getNumGradientEvaluations();
+
+            ProfileTimer udot_timer(frame.phase_time[ProfileUdotError]);
 
             // Account for optimization scale factors
             for (int m = 0; m < _n_secondary_coord; ++m) {
@@ -992,6 +1075,7 @@ void COMAKTool::performCOMAK() {
 
             // Compute udot linearized error
             _model.realizeAcceleration(state);
+            frame.realize_acceleration++;
 
             // Output Optimization Results
             if (get_verbose() > 1)
@@ -1151,7 +1235,9 @@ void COMAKTool::performCOMAK() {
         _convergence.appendRow(_time[i], convergence_metrics);
 
         // Store Solution
+        ProfileTimer record_timer(frame.phase_time[ProfileRecordResults]);
         _model.realizeAcceleration(state);
+        frame.realize_acceleration++;
         _prev_parameters = _optim_parameters;
         _prev_state = state;
 
@@ -1163,6 +1249,7 @@ void COMAKTool::performCOMAK() {
 
         // Save the results
         recordResultsStorage(state, i);
+        record_timer.stop();
 
         // Visualize the Results
         if (get_use_visualizer()) {
@@ -1183,6 +1270,21 @@ void COMAKTool::performCOMAK() {
                 msl.overrideActuation(state, true);
             }
         }
+
+        // Profile
+        frame.iterations = n_iter;
+        const auto frame_end_ray_casts = sumRayCastCounts(_model);
+        frame.rays = frame_end_ray_casts.rays - frame_start_ray_casts.rays;
+        frame.same_triangle = frame_end_ray_casts.same_triangle -
+                              frame_start_ray_casts.same_triangle;
+        frame.neighbor_triangle = frame_end_ray_casts.neighbor_triangle -
+                                  frame_start_ray_casts.neighbor_triangle;
+        frame.obb_search = frame_end_ray_casts.obb_search -
+                           frame_start_ray_casts.obb_search;
+        frame.obb_hit =
+                frame_end_ray_casts.obb_hit - frame_start_ray_casts.obb_hit;
+        recordProfileFrame(
+                _time[i], frame_stopwatch.getElapsedTime(), frame);
     } // END of COMAK timestep
 
     // Print Convergence Summary
@@ -1202,6 +1304,7 @@ void COMAKTool::performCOMAK() {
     }
 
     // Print Results
+    ProfileTimer print_timer(_profile_total.phase_time[ProfilePrintResults]);
     printResultsFiles();
 }
 
@@ -1392,6 +1495,101 @@ void COMAKTool::printResultsFiles() {
 
     _model.updAnalysisSet().printResults(
             get_results_prefix(), get_results_directory());
+
+    if (get_print_profile()) {
+        CSVFileAdapter::write(_profile, get_results_directory() + "/" +
+                                                get_results_prefix() +
+                                                "_profile.csv");
+    }
+}
+
+void COMAKTool::initializeProfile() {
+    _profile_total = ProfileCounters();
+    _profile = TimeSeriesTable();
+    _profile.setColumnLabels({"frame_time", "frame_setup_time",
+            "constraint_matrix_time", "optimizer_time", "udot_error_time",
+            "record_results_time", "iterations", "realize_acceleration",
+            "objective_evaluations", "gradient_evaluations", "ray_casts",
+            "ray_casts_same_triangle", "ray_casts_neighbor_triangle",
+            "obb_searches", "obb_hits"});
+}
+
+void COMAKTool::recordProfileFrame(
+        double time, double frame_time, const ProfileCounters& frame) {
+    SimTK::RowVector row(15);
+    row(0) = frame_time;
+    row(1) = frame.phase_time[ProfileFrameSetup];
+    row(2) = frame.phase_time[ProfileConstraintMatrix];
+    row(3) = frame.phase_time[ProfileOptimizer];
+    row(4) = frame.phase_time[ProfileUdotError];
+    row(5) = frame.phase_time[ProfileRecordResults];
+    row(6) = frame.iterations;
+    row(7) = (double)frame.realize_acceleration;
+    row(8) = (double)frame.objective_evaluations;
+    row(9) = (double)frame.gradient_evaluations;
+    row(10) = (double)frame.rays;
+    row(11) = (double)frame.same_triangle;
+    row(12) = (double)frame.neighbor_triangle;
+    row(13) = (double)frame.obb_search;
+    row(14) = (double)frame.obb_hit;
+    _profile.appendRow(time, row);
+
+    for (int p = 0; p < NumProfilePhases; ++p) {
+        _profile_total.phase_time[p] += frame.phase_time[p];
+    }
+    _profile_total.frames++;
+    _profile_total.iterations += frame.iterations;
+    _profile_total.realize_acceleration += frame.realize_acceleration;
+    _profile_total.objective_evaluations += frame.objective_evaluations;
+    _profile_total.gradient_evaluations += frame.gradient_evaluations;
+    _profile_total.rays += frame.rays;
+    _profile_total.same_triangle += frame.same_triangle;
+    _profile_total.neighbor_triangle += frame.neighbor_triangle;
+    _profile_total.obb_search += frame.obb_search;
+    _profile_total.obb_hit += frame.obb_hit;
+}
+
+void COMAKTool::printProfileSummary(double total_time) const {
+    static const std::array<std::string, NumProfilePhases> phase_names = {
+            "initialize", "read kinematics", "settle", "frame setup",
+            "constraint matrix", "optimizer", "udot error", "record results",
+            "print results"};
+
+    log_info("COMAK Profile:");
+    log_info("--------------");
+    log_info("{:<20} {:>12} {:>8}", "Phase", "Time (s)", "%");
+    double accounted = 0;
+    for (int p = 0; p < NumProfilePhases; ++p) {
+        const double t = _profile_total.phase_time[p];
+        accounted += t;
+        log_info("{:<20} {:>12.3f} {:>7.1f}%", phase_names[p], t,
+                100 * t / total_time);
+    }
+    log_info("{:<20} {:>12.3f} {:>7.1f}%", "other", total_time - accounted,
+            100 * (total_time - accounted) / total_time);
+    log_info("{:<20} {:>12.3f}", "total", total_time);
+    log_info("");
+
+    const double frames = std::max(_profile_total.frames, 1);
+    auto print_counter = [&](const std::string& name, double value) {
+        log_info("{:<28} {:>14} {:>12.1f}", name, value, value / frames);
+    };
+    log_info("{:<28} {:>14} {:>12}", "Counter", "Total", "Per frame");
+    print_counter("frames", _profile_total.frames);
+    print_counter("COMAK iterations", _profile_total.iterations);
+    print_counter("realizeAcceleration() calls",
+            (double)_profile_total.realize_acceleration);
+    print_counter("objective evaluations",
+            (double)_profile_total.objective_evaluations);
+    print_counter("gradient evaluations",
+            (double)_profile_total.gradient_evaluations);
+    print_counter("contact ray casts", (double)_profile_total.rays);
+    print_counter("  same triangle", (double)_profile_total.same_triangle);
+    print_counter(
+            "  neighbor triangle", (double)_profile_total.neighbor_triangle);
+    print_counter("  OBB tree searches", (double)_profile_total.obb_search);
+    print_counter("  OBB tree hits", (double)_profile_total.obb_hit);
+    log_info("");
 }
 
 SimTK::Vector COMAKTool::equilibriateSecondaryCoordinates() {
@@ -1641,39 +1839,31 @@ void COMAKTool::extractKinematicsFromFile() {
     _u_matrix = 0;
     _udot_matrix = 0;
 
+    // Differentiate each coordinate with a spline through its values,
+    // evaluated over the whole time grid at once.
+    std::vector<double> q(_n_frames), u(_n_frames), udot(_n_frames);
     int j = 0;
     for (const Coordinate& coord : _model.getComponentList<Coordinate>()) {
 
         if (q_col_map[j] != -1) {
             Array<double> data;
             store.getDataColumn(col_labels[q_col_map[j]], data, _time[0]);
-            for (int i = 0; i < _n_frames; ++i) { _q_matrix(i, j) = data[i]; }
+            for (int i = 0; i < _n_frames; ++i) { q[i] = data[i]; }
         } else {
             log_warn("Coordinate Value: {} not found in coordinates_file, "
                      "assuming default value.",
                     coord.getName());
-            for (int i = 0; i < _n_frames; ++i) {
-                _q_matrix(i, j) = coord.getDefaultValue();
-            }
+            std::fill(q.begin(), q.end(), coord.getDefaultValue());
         }
 
-        // GCVSpline q_spline;
-        // q_spline.setDegree(5);
-
-        SimmSpline q_spline;
-        for (int i = 0; i < _n_frames; ++i) {
-            q_spline.addPoint(_time[i], _q_matrix(i, j));
-        }
+        SimmSpline q_spline(_n_frames, &_time[0], q.data());
+        q_spline.calcValuesAndDerivatives(
+                _n_frames, &_time[0], nullptr, u.data(), udot.data());
 
         for (int i = 0; i < _n_frames; ++i) {
-            SimTK::Vector x(1);
-            x(0) = _time[i];
-
-            std::vector<int> u_order = {0};
-            _u_matrix(i, j) = q_spline.calcDerivative(u_order, x);
-
-            std::vector<int> udot_order = {0, 0};
-            _udot_matrix(i, j) = q_spline.calcDerivative(udot_order, x);
+            _q_matrix(i, j) = q[i];
+            _u_matrix(i, j) = u[i];
+            _udot_matrix(i, j) = udot[i];
         }
         j++;
     }
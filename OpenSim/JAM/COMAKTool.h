@@ -27,6 +27,8 @@
 
 #include "COMAKSettingsSet.h"
 
+#include <array>
+
 namespace OpenSim { 
 
 class COMAKCostFunctionParameter;
@@ -111,6 +113,12 @@ public:
     OpenSim_DECLARE_PROPERTY(force_set_file,std::string,
         "Path to .xml file containing an additional ForceSet.")
 
+    OpenSim_DECLARE_PROPERTY(function_based_paths_file, std::string,
+        "Optional. Path to .xml file containing a Set of FunctionBasedPaths "
+        "(e.g. ligament paths fitted with PolynomialPathFitter). The path of "
+        "each Force named by a FunctionBasedPath is replaced, so its length "
+        "is evaluated without wrapping.")
+
     OpenSim_DECLARE_PROPERTY(start_time, double, 
         "First time step of COMAK simulation.")
 
@@ -302,6 +310,13 @@ public:
         "Use SimTK visualizer to display simulations in progress. "
         "The default value is false.")
 
+    OpenSim_DECLARE_PROPERTY(print_profile, bool,
+        "Print a per-frame profile (results_prefix + '_profile.csv') of the "
+        "time spent in each COMAK phase and the number of iterations, "
+        "realizeAcceleration() calls, optimizer evaluations and contact ray "
+        "casts. A summary of the profile is always logged at the end of the "
+        "run. The default value is false.")
+
     OpenSim_DECLARE_UNNAMED_PROPERTY(AnalysisSet,"Analyses to be performed"
         "throughout the COMAK simulation.")
     // Amir
@@ -343,6 +358,39 @@ private:
     void printResultsFiles();
     void updatemusclemaxforce(SimTK::State& s); //Amir
 
+    // Profiling
+    enum ProfilePhase {
+        ProfileInitialize,
+        ProfileReadKinematics,
+        ProfileSettle,
+        ProfileFrameSetup,
+        ProfileConstraintMatrix,
+        ProfileOptimizer,
+        ProfileUdotError,
+        ProfileRecordResults,
+        ProfilePrintResults,
+        NumProfilePhases
+    };
+
+    struct ProfileCounters {
+        std::array<double, NumProfilePhases> phase_time{};
+        int frames = 0;
+        int iterations = 0;
+        long long realize_acceleration = 0;
+        long long objective_evaluations = 0;
+        long long gradient_evaluations = 0;
+        long long rays = 0;
+        long long same_triangle = 0;
+        long long neighbor_triangle = 0;
+        long long obb_search = 0;
+        long long obb_hit = 0;
+    };
+
+    void initializeProfile();
+    void recordProfileFrame(double time, double frame_time,
+        const ProfileCounters& frame);
+    void printProfileSummary(double total_time) const;
+
 public:
     bool run();
     void setModel(Model& model);
@@ -426,6 +474,9 @@ private:
     TimeSeriesTable _result_kinematics;
     TimeSeriesTable _result_values;
     TimeSeriesTable _convergence;
+
+    ProfileCounters _profile_total;
+    TimeSeriesTable _profile;
 //=============================================================================
 };  // END of class COMAK_TOOL
 
@@ -0,0 +1,402 @@
+/* -------------------------------------------------------------------------- *
+ *                         ForsimEnsembleTool.cpp                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ForsimEnsembleTool.h"
+#include <OpenSim/Common/Adapters.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LatinHypercubeDesign.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+
+using namespace OpenSim;
+
+//=============================================================================
+// ForsimEnsembleParameter
+//=============================================================================
+ForsimEnsembleParameter::ForsimEnsembleParameter() { constructProperties(); }
+
+ForsimEnsembleParameter::ForsimEnsembleParameter(
+        const std::string& componentPath, const std::string& propertyName,
+        double lowerBound, double upperBound, bool scaleBaseValue) {
+    constructProperties();
+    set_component_path(componentPath);
+    set_property_name(propertyName);
+    set_lower_bound(lowerBound);
+    set_upper_bound(upperBound);
+    set_scale_base_value(scaleBaseValue);
+}
+
+void ForsimEnsembleParameter::constructProperties() {
+    constructProperty_component_path("");
+    constructProperty_property_name("");
+    constructProperty_lower_bound(0.0);
+    constructProperty_upper_bound(0.0);
+    constructProperty_scale_base_value(false);
+}
+
+//=============================================================================
+// ForsimEnsembleTool
+//=============================================================================
+namespace {
+// The values of the outputs of one member at each report time.
+struct MemberResult {
+    bool success = false;
+    std::vector<double> times;
+    std::vector<std::vector<double>> values; // One vector per output.
+};
+} // anonymous namespace
+
+ForsimEnsembleTool::ForsimEnsembleTool() : Object() { constructProperties(); }
+
+ForsimEnsembleTool::ForsimEnsembleTool(const std::string& settings_file)
+        : Object(settings_file) {
+    constructProperties();
+    updateFromXMLDocument();
+}
+
+void ForsimEnsembleTool::constructProperties() {
+    constructProperty_model_file("");
+    constructProperty_results_directory(".");
+    constructProperty_results_file_basename("");
+    constructProperty_forsim_tool(ForsimTool());
+    constructProperty_parameters();
+    constructProperty_num_members(10);
+    constructProperty_design_method("random");
+    constructProperty_outputs();
+    constructProperty_num_threads(-1);
+    constructProperty_geometry_folder("");
+}
+
+void ForsimEnsembleTool::setModel(const Model& model) {
+    _model = model;
+    set_model_file(model.getDocumentFileName());
+    _model_exists = true;
+}
+
+void ForsimEnsembleTool::setDesign(const SimTK::Matrix& design) {
+    _design = design;
+}
+
+const TimeSeriesTable& ForsimEnsembleTool::getOutputTable(
+        const std::string& output) const {
+    const auto it = _output_tables.find(output);
+    OPENSIM_THROW_IF_FRMOBJ(it == _output_tables.end(), Exception,
+            "No results for output '{}'.", output);
+    return it->second;
+}
+
+SimTK::Matrix ForsimEnsembleTool::generateDesign() const {
+    LatinHypercubeDesign lhs;
+    lhs.setNumSamples(get_num_members());
+    lhs.setNumVariables(getProperty_parameters().size());
+
+    const std::string& method = get_design_method();
+    if (method == "random") {
+        return lhs.generateRandomDesign();
+    } else if (method == "translational_propagation") {
+        return lhs.generateTranslationalPropagationDesign();
+    } else if (method == "stochastic_evolutionary") {
+        return lhs.generateStochasticEvolutionaryDesign();
+    }
+    OPENSIM_THROW_FRMOBJ(Exception,
+            "Expected design_method to be 'random', "
+            "'translational_propagation' or 'stochastic_evolutionary', but "
+            "got '{}'.", method);
+}
+
+bool ForsimEnsembleTool::run() {
+    bool completed = false;
+
+    auto cwd = IO::CwdChanger::changeToParentOf(getDocumentFileName());
+
+    try {
+        const Stopwatch stopwatch;
+        log_critical("");
+        log_critical("==================");
+        log_critical("ForsimEnsembleTool");
+        log_critical("==================");
+        log_critical("");
+
+        _output_tables.clear();
+
+        //Make results directory
+        int makeDir_out = IO::makeDir(get_results_directory());
+        if (errno == ENOENT && makeDir_out == -1) {
+            OPENSIM_THROW(Exception, "Could not create " +
+                get_results_directory() +
+                "Possible reason: This tool cannot make new folder with subfolder.");
+        }
+
+        // The geometry search paths are shared by all threads, so they are
+        // set here instead of by the ForsimTool of each member.
+        if (!get_geometry_folder().empty()) {
+            ModelVisualizer::addDirToGeometrySearchPaths(get_geometry_folder());
+        }
+
+        // Load the base model. This loads the contact meshes and builds their
+        // OBB trees, which the copies of the model reuse.
+        if (!_model_exists) {
+            OPENSIM_THROW_IF_FRMOBJ(get_model_file().empty(), Exception,
+                    "No model was set in the ForsimEnsembleTool.");
+            _model = Model(get_model_file());
+        }
+        _model.finalizeFromProperties();
+
+        // Parameters.
+        const int numParams = getProperty_parameters().size();
+        OPENSIM_THROW_IF_FRMOBJ(numParams == 0, Exception,
+                "Expected at least one parameter.");
+        std::vector<double> baseValues;
+        for (int j = 0; j < numParams; ++j) {
+            const ForsimEnsembleParameter& param = get_parameters(j);
+            const Component& component = _model.getComponent<Component>(
+                    param.get_component_path());
+            baseValues.push_back(component.getPropertyByName<double>(
+                    param.get_property_name()).getValue());
+        }
+
+        SimTK::Matrix design = _design.nrow() ? _design : generateDesign();
+        OPENSIM_THROW_IF_FRMOBJ(design.ncol() != numParams, Exception,
+                "Expected the design to have {} columns (one per parameter), "
+                "but it has {}.", numParams, design.ncol());
+        const int numMembers = design.nrow();
+
+        _parameter_values.resize(numMembers, numParams);
+        for (int j = 0; j < numParams; ++j) {
+            const ForsimEnsembleParameter& param = get_parameters(j);
+            double lower = param.get_lower_bound();
+            double upper = param.get_upper_bound();
+            if (param.get_scale_base_value()) {
+                lower *= baseValues[j];
+                upper *= baseValues[j];
+            }
+            for (int i = 0; i < numMembers; ++i) {
+                _parameter_values(i, j) = lower + design(i, j) * (upper - lower);
+            }
+        }
+
+        // Outputs.
+        const int numOutputs = getProperty_outputs().size();
+        std::vector<std::string> componentPaths;
+        std::vector<std::string> outputNames;
+        for (int k = 0; k < numOutputs; ++k) {
+            const std::string& output = get_outputs(k);
+            const auto bar = output.rfind('|');
+            OPENSIM_THROW_IF_FRMOBJ(bar == std::string::npos, Exception,
+                    "Expected output '{}' to be formatted as "
+                    "'/path/to/component|output_name'.", output);
+            componentPaths.push_back(output.substr(0, bar));
+            outputNames.push_back(output.substr(bar + 1));
+
+            const AbstractOutput& abstractOutput =
+                    _model.getComponent<Component>(componentPaths.back())
+                            .getOutput(outputNames.back());
+            OPENSIM_THROW_IF_FRMOBJ(
+                    !dynamic_cast<const Output<double>*>(&abstractOutput),
+                    Exception, "Expected output '{}' to be of type double.",
+                    output);
+        }
+
+        // The ForsimTool of each member does not write results or show the
+        // simulation.
+        ForsimTool forsim = get_forsim_tool();
+        forsim.upd_AnalysisSet().clearAndDestroy();
+        forsim.set_use_visualizer(false);
+        forsim.set_geometry_folder("");
+
+        int numThreads = get_num_threads();
+        if (numThreads == -1) { numThreads = getMaxNumThreads(); }
+        OPENSIM_THROW_IF_FRMOBJ(numThreads < 1, Exception,
+                "Expected num_threads to be -1 or at least 1, but got {}.",
+                numThreads);
+        numThreads = std::min({numThreads, getMaxNumThreads(), numMembers});
+
+        // Simulate the members.
+        // ---------------------
+        log_info("Simulating {} members, {} at a time.", numMembers,
+                numThreads);
+        std::vector<MemberResult> results(numMembers);
+        std::mutex copyMutex;
+        std::atomic<int> nextMember(0);
+        auto worker = [&]() {
+            for (int i = nextMember++; i < numMembers; i = nextMember++) {
+                log_info("[{}/{}] Started member.", i + 1, numMembers);
+                const Stopwatch watch;
+                try {
+                    // Copying the base model and the tool only reads them,
+                    // but they are copied one at a time to be safe.
+                    std::unique_ptr<Model> model;
+                    std::unique_ptr<ForsimTool> tool;
+                    {
+                        std::lock_guard<std::mutex> lock(copyMutex);
+                        model.reset(_model.clone());
+                        tool.reset(forsim.clone());
+                    }
+                    model->finalizeFromProperties();
+                    for (int j = 0; j < numParams; ++j) {
+                        const ForsimEnsembleParameter& param =
+                                get_parameters(j);
+                        model->updComponent<Component>(
+                                        param.get_component_path())
+                                .updPropertyByName<double>(
+                                        param.get_property_name())
+                                .setValue(_parameter_values(i, j));
+                    }
+                    tool->setModel(*model);
+                    model.reset();
+
+                    tool->simulate();
+
+                    const Model& simModel = tool->getModel();
+                    std::vector<const Output<double>*> outputs;
+                    for (int k = 0; k < numOutputs; ++k) {
+                        const Component& component =
+                                simModel.getComponent<Component>(
+                                        componentPaths[k]);
+                        outputs.push_back(&dynamic_cast<const Output<double>&>(
+                                component.getOutput(outputNames[k])));
+                    }
+                    MemberResult& result = results[i];
+                    result.values.resize(numOutputs);
+                    for (const SimTK::State& state :
+                            tool->getStatesTrajectory()) {
+                        simModel.realizeReport(state);
+                        result.times.push_back(state.getTime());
+                        for (int k = 0; k < numOutputs; ++k) {
+                            result.values[k].push_back(
+                                    outputs[k]->getValue(state));
+                        }
+                    }
+                    result.success = true;
+                    log_info("[{}/{}] Finished member in {}.", i + 1,
+                            numMembers, watch.getElapsedTimeFormatted());
+                } catch (const std::exception& x) {
+                    results[i] = MemberResult();
+                    log_error("[{}/{}] Member failed after {}: {}", i + 1,
+                            numMembers, watch.getElapsedTimeFormatted(),
+                            x.what());
+                }
+            }
+        };
+        std::vector<std::future<void>> workers;
+        for (int w = 0; w < numThreads; ++w) {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+        for (auto& w : workers) w.get();
+
+        // Collect the outputs.
+        // --------------------
+        const auto firstSuccess = std::find_if(results.begin(), results.end(),
+                [](const MemberResult& r) { return r.success; });
+        OPENSIM_THROW_IF_FRMOBJ(firstSuccess == results.end(), Exception,
+                "All {} members failed.", numMembers);
+        const std::vector<double> times = firstSuccess->times;
+
+        int numFailed = 0;
+        for (int i = 0; i < numMembers; ++i) {
+            if (results[i].success && results[i].times != times) {
+                log_error("[{}/{}] The report times of the member differ "
+                          "from those of the other members; its outputs are "
+                          "ignored.", i + 1, numMembers);
+                results[i].success = false;
+            }
+            if (!results[i].success) ++numFailed;
+        }
+
+        std::vector<std::string> labels;
+        for (int i = 0; i < numMembers; ++i) {
+            labels.push_back("member_" + std::to_string(i + 1));
+        }
+        for (int k = 0; k < numOutputs; ++k) {
+            SimTK::Matrix values((int)times.size(), numMembers, SimTK::NaN);
+            for (int i = 0; i < numMembers; ++i) {
+                if (!results[i].success) continue;
+                for (int t = 0; t < (int)times.size(); ++t) {
+                    values(t, i) = results[i].values[k][t];
+                }
+            }
+            _output_tables[get_outputs(k)] =
+                    TimeSeriesTable(times, values, labels);
+        }
+
+        printResults();
+
+        log_info("{} of {} members succeeded.", numMembers - numFailed,
+                numMembers);
+        log_info("Finished in {}", stopwatch.getElapsedTimeFormatted());
+        log_info("");
+
+        completed = numFailed == 0;
+    }
+
+    catch(const std::exception& x) {
+        log_error("ForsimEnsembleTool::run() caught an exception: \n {}",
+                x.what());
+    }
+
+    cwd.restore();
+
+    return completed;
+}
+
+void ForsimEnsembleTool::printResults() const {
+    STOFileAdapter sto;
+    const std::string basefile =
+            get_results_directory() + "/" + get_results_file_basename();
+
+    // Parameters
+    std::vector<double> members;
+    std::vector<std::string> parameterLabels;
+    for (int i = 0; i < _parameter_values.nrow(); ++i) {
+        members.push_back(i + 1);
+    }
+    for (int j = 0; j < getProperty_parameters().size(); ++j) {
+        parameterLabels.push_back(get_parameters(j).get_component_path() +
+                                  "/" + get_parameters(j).get_property_name());
+    }
+    TimeSeriesTable parameters_table(
+            members, _parameter_values, parameterLabels);
+    parameters_table.addTableMetaData(
+            "header", std::string("Forsim Ensemble Parameters"));
+    sto.write(parameters_table, basefile + "_parameters.sto");
+
+    // Outputs
+    for (const auto& entry : _output_tables) {
+        std::string name = entry.first;
+        if (!name.empty() && name[0] == '/') name.erase(0, 1);
+        std::replace(name.begin(), name.end(), '/', '_');
+        std::replace(name.begin(), name.end(), '|', '_');
+
+        TimeSeriesTable table = entry.second;
+        table.addTableMetaData("header", entry.first);
+        table.addTableMetaData("inDegrees", std::string("no"));
+        sto.write(table, basefile + "_" + name + ".sto");
+    }
+
+    log_info("Printed results to: {}", get_results_directory());
+}
@@ -0,0 +1,206 @@
+#ifndef OPENSIM_FORSIM_ENSEMBLE_TOOL_H_
+#define OPENSIM_FORSIM_ENSEMBLE_TOOL_H_
+/* -------------------------------------------------------------------------- *
+ *                          ForsimEnsembleTool.h                              *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimJAMDLL.h"
+#include "ForsimTool.h"
+
+namespace OpenSim {
+
+//=============================================================================
+//                          ForsimEnsembleParameter
+//=============================================================================
+/** A property of a component of the model that is varied across the members
+of a ForsimEnsembleTool. The property must have a single value of type double
+(e.g., the slack_length or linear_stiffness of a Blankevoort1991Ligament, or
+the elastic_modulus or thickness of a Smith2018ContactMesh). */
+class OSIMJAM_API ForsimEnsembleParameter : public Object {
+    OpenSim_DECLARE_CONCRETE_OBJECT(ForsimEnsembleParameter, Object);
+
+public:
+    OpenSim_DECLARE_PROPERTY(component_path, std::string,
+        "Path to the component in the model, e.g. '/forceset/MCLd1'.")
+
+    OpenSim_DECLARE_PROPERTY(property_name, std::string,
+        "Name of the property of the component, e.g. 'slack_length'. The "
+        "property must have a single value of type double.")
+
+    OpenSim_DECLARE_PROPERTY(lower_bound, double,
+        "Smallest value of the property in the ensemble.")
+
+    OpenSim_DECLARE_PROPERTY(upper_bound, double,
+        "Largest value of the property in the ensemble.")
+
+    OpenSim_DECLARE_PROPERTY(scale_base_value, bool,
+        "If true, lower_bound and upper_bound are factors that scale the "
+        "value of the property in the base model (e.g., 0.95 and 1.05). "
+        "The default value is false.")
+
+    ForsimEnsembleParameter();
+    ForsimEnsembleParameter(const std::string& componentPath,
+            const std::string& propertyName, double lowerBound,
+            double upperBound, bool scaleBaseValue = false);
+
+private:
+    void constructProperties();
+};
+
+//=============================================================================
+//                            ForsimEnsembleTool
+//=============================================================================
+/**
+The ForsimEnsembleTool performs the forward simulation defined by a
+ForsimTool many times, each time (for each member of the ensemble) with
+different values of some properties of the model, and collects the values of
+chosen outputs of the model in one table per output. This is useful for
+Monte Carlo and sensitivity studies, e.g., of the effect of the slack lengths
+and stiffnesses of the ligaments or the properties of the cartilage on the
+kinematics of the knee.
+
+The properties to vary are listed as ForsimEnsembleParameter%s. The values of
+the parameters of the members are sampled from a Latin hypercube design (see
+LatinHypercubeDesign) with num_members samples, generated with the
+design_method, and scaled to the bounds of each parameter. Alternatively, a
+design can be provided with setDesign().
+
+## Performance
+The base model is loaded once, so its contact meshes are read from file and
+their OBB trees are built once. Each member simulates a copy of the base
+model, and the Smith2018ContactMesh%es of the copies reuse the meshes and OBB
+trees of the base model instead of loading them again; changing the
+elastic_modulus, poissons_ratio or (uniform) thickness of a mesh does not
+reload the mesh. The members are simulated concurrently by num_threads
+threads. The input files of the ForsimTool are read by each member.
+
+## Results
+For each of the outputs (e.g., '/forceset/MCLd1|total_force' or
+'/jointset/knee_r/knee_add_r|value'), which must be of type double, the tool
+writes a table with the value of the output at each report time of the
+ForsimTool (one column per member, labeled 'member_1', 'member_2', ...) to
+results_directory/results_file_basename_<output path>.sto, in which the
+slashes and the bar of the output path are replaced by underscores. The values
+of the parameters of the members are written to
+results_directory/results_file_basename_parameters.sto, with one row per
+member; the first ('time') column of this table is the number of the member.
+The columns of a member whose simulation fails are NaN.
+
+The results_directory, results_file_basename, AnalysisSet and use_visualizer
+of the ForsimTool are ignored, and the ForsimTool does not write any results
+files.
+*/
+class OSIMJAM_API ForsimEnsembleTool : public Object {
+    OpenSim_DECLARE_CONCRETE_OBJECT(ForsimEnsembleTool, Object);
+
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_PROPERTY(model_file, std::string,
+        "Path to the .osim file of the base model of the ensemble.")
+
+    OpenSim_DECLARE_PROPERTY(results_directory, std::string,
+        "Path to folder where all results files will be written.")
+
+    OpenSim_DECLARE_PROPERTY(results_file_basename, std::string,
+        "Prefix to each results file name.")
+
+    OpenSim_DECLARE_PROPERTY(forsim_tool, ForsimTool,
+        "Settings of the forward simulation of each member. Its model_file, "
+        "results_directory, results_file_basename, AnalysisSet and "
+        "use_visualizer are ignored.")
+
+    OpenSim_DECLARE_LIST_PROPERTY(parameters, ForsimEnsembleParameter,
+        "Properties of the model that are varied across the members.")
+
+    OpenSim_DECLARE_PROPERTY(num_members, int,
+        "Number of members (simulations) in the ensemble. "
+        "The default value is 10.")
+
+    OpenSim_DECLARE_PROPERTY(design_method, std::string,
+        "Method used to generate the Latin hypercube design: 'random', "
+        "'translational_propagation' or 'stochastic_evolutionary' (see "
+        "LatinHypercubeDesign). The default value is 'random'.")
+
+    OpenSim_DECLARE_LIST_PROPERTY(outputs, std::string,
+        "Paths to the outputs whose values are collected, formatted as "
+        "'/path/to/component|output_name'. Each output must be of type "
+        "double.")
+
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+        "Number of members that are simulated at a time. Set to -1 to use "
+        "the number of hardware threads. The default value is -1. At most "
+        "OPENSIM_MAX_THREADS members are simulated at a time, if that "
+        "environment variable is set.")
+
+    OpenSim_DECLARE_PROPERTY(geometry_folder, std::string, "Optional. "
+        "File path to folder containing model geometries.")
+
+    //=========================================================================
+    // METHODS
+    //=========================================================================
+    ForsimEnsembleTool();
+    ForsimEnsembleTool(const std::string& settings_file);
+
+    /** Use a copy of this model as the base model instead of loading the
+    model_file. */
+    void setModel(const Model& model);
+
+    /** Use this design instead of generating one. The design has one row per
+    member and one column per parameter, with values between 0 (the
+    lower_bound of the parameter) and 1 (the upper_bound); num_members and
+    design_method are then ignored. */
+    void setDesign(const SimTK::Matrix& design);
+
+    /** Simulate all members and write the results. Returns true if all
+    members were simulated successfully. */
+    bool run();
+
+    /** The values of the parameters of each member (one row per member) in
+    the last run. */
+    const SimTK::Matrix& getParameterValues() const {
+        return _parameter_values;
+    }
+
+    /** The values of the output with the given path in the last run, with
+    one column per member. */
+    const TimeSeriesTable& getOutputTable(const std::string& output) const;
+
+private:
+    void constructProperties();
+    SimTK::Matrix generateDesign() const;
+    void printResults() const;
+
+    //=========================================================================
+    // DATA
+    //=========================================================================
+    Model _model;
+    bool _model_exists = false;
+    SimTK::Matrix _design;
+
+    SimTK::Matrix _parameter_values;
+    std::map<std::string, TimeSeriesTable> _output_tables;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_FORSIM_ENSEMBLE_TOOL_H_
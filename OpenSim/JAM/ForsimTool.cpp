@@ -24,6 +24,7 @@
 #include <OpenSim/Common/Adapters.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
+#include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Common/IO.h>
 #include "OpenSim/Simulation/Model/Smith2018ArticularContactForce.h"
 #include "OpenSim/Simulation/Model/Blankevoort1991Ligament.h"
@@ -78,6 +79,7 @@ void ForsimTool::constructProperties()
     constructProperty_actuator_input_file("");
     constructProperty_external_loads_file("");
     constructProperty_prescribed_coordinates_file("");
+    constructProperty_function_based_paths_file("");
     constructProperty_geometry_folder("");
     constructProperty_use_visualizer(false);
     constructProperty_AnalysisSet(AnalysisSet());
@@ -101,9 +103,6 @@ bool ForsimTool::run()
     auto cwd = IO::CwdChanger::changeToParentOf(getDocumentFileName());
 
     try {
-        // Clear Previous Results
-        _result_states.clear();
-
         const Stopwatch stopwatch;
         log_critical("");
         log_critical("==========");
@@ -124,167 +123,184 @@ bool ForsimTool::run()
             ModelVisualizer::addDirToGeometrySearchPaths(get_geometry_folder());
         }
 
-        if (!_model_exists) {
-            if (get_model_file().empty()) {
-                OPENSIM_THROW(Exception, "No model was set in the ForsimTool.");
-            }
-            _model = Model(get_model_file());
-        }
+        simulate();
 
-        _model.initSystem();        
-        
-        initializeActuators();
+        printResults();
 
-        initializeCoordinates();
+        const long long elapsed = stopwatch.getElapsedTimeInNs();
 
-        initializeStartStopTimes();
+        log_info("\nForsim Tool complete.");
+        log_info("Finished in {}", stopwatch.formatNs(elapsed));        
+        log_info("");
 
-        applyExternalLoads();
+        completed = true;
+    }
 
-        //Add Analysis set
-        AnalysisSet aSet = get_AnalysisSet();
-        int size = aSet.getSize();
+    catch(const std::exception& x) {
+        log_error("ForsimTool::run() caught an exception: \n {}", x.what());
+        cwd.restore();
+    }
+    catch (...) { // e.g. may get InterruptedException
+        log_error("ForsimTool::run() caught an exception.");
+        cwd.restore();
+    }
 
-        for (int i = 0; i < size; i++) {
-            Analysis *analysis = aSet.get(i).clone();
-            _model.addAnalysis(analysis);
-        }
+    cwd.restore();
 
-        if (get_use_visualizer()) {
-            _model.setUseVisualizer(true);
-        }
+    return completed; 
+}
 
-        SimTK::State state = _model.initSystem();
-        
-        for (const auto& mesh : _model.updComponentList<Smith2018ContactMesh>()) {
-            mesh.printMeshDebugInfo();
-        }        
+void ForsimTool::simulate()
+{
+    // Clear Previous Results
+    _result_states.clear();
 
-        // Initialize Muscle States
-        for (Muscle& msl : _model.updComponentList<Muscle>()) {
-            std::string msl_path = msl.getAbsolutePathString();
+    if (!_model_exists) {
+        if (get_model_file().empty()) {
+            OPENSIM_THROW(Exception, "No model was set in the ForsimTool.");
+        }
+        _model = Model(get_model_file());
+    }
 
-            if (contains_string(_prescribed_frc_actuator_paths, msl_path)) {                
-                msl.overrideActuation(state, true);
-                msl.setOverrideActuation(state, 0.0);
+    if (!get_function_based_paths_file().empty()) {
+        log_info("Replacing force paths with FunctionBasedPaths from {}",
+            get_function_based_paths_file());
+        _model.finalizeFromProperties();
+        _model.finalizeConnections();
+        ModelFactory::replacePathsWithFunctionBasedPaths(_model,
+            Set<FunctionBasedPath>(get_function_based_paths_file()));
+    }
 
-                continue;
-            }
-            if (contains_string(_prescribed_act_actuator_paths, msl_path)) {
-                continue;
-            }
-            if (contains_string(_prescribed_control_actuator_paths, msl_path)) {
-                continue;
-            }
+    _model.initSystem();        
+    
+    initializeActuators();
 
-            if (get_constant_muscle_control() > -1) {
-                if (!get_use_muscle_physiology ()) {
-                    msl.overrideActuation(state, true);
-                    /*msl.setOverrideActuation(
-                            state, get_constant_muscle_control() *
-                                           msl.getMaxIsometricForce()); */
-                }
-            }
-        }
+    initializeCoordinates();
 
-        if (get_equilibrate_muscles()) { _model.equilibrateMuscles(state); }
+    initializeStartStopTimes();
 
-        AnalysisSet& analysisSet = _model.updAnalysisSet();
+    applyExternalLoads();
 
-        //Setup Visualizer
-        if (get_use_visualizer()) {
-            _model.updMatterSubsystem().setShowDefaultGeometry(false);
-            SimTK::Visualizer& viz = _model.updVisualizer().updSimbodyVisualizer();
-            viz.setBackgroundColor(SimTK::Black);
-            viz.setBackgroundType(SimTK::Visualizer::BackgroundType::SolidColor);
-            viz.setMode(SimTK::Visualizer::Mode::Sampling);
-            viz.setShowSimTime(true);
-            viz.setDesiredFrameRate(100);
-        }
+    //Add Analysis set
+    AnalysisSet aSet = get_AnalysisSet();
+    int size = aSet.getSize();
 
-        //Setup Integrator
-        state.setTime(get_start_time());
-    
-        SimTK::CPodesIntegrator integrator(_model.getSystem(), SimTK::CPodes::BDF, SimTK::CPodes::Newton);
-        integrator.setAccuracy(get_integrator_accuracy());
-        integrator.setMinimumStepSize(get_minimum_time_step());
-        integrator.setMaximumStepSize(get_maximum_time_step());
-        if (get_internal_step_limit()>0) {
-            integrator.setInternalStepLimit(get_internal_step_limit());
-        }
-        SimTK::TimeStepper timestepper(_model.getSystem(), integrator);
-        timestepper.initialize(state);
-    
-       // Record Initial State
-        log_debug("Initial State:");
-        _model.realizeReport(state);
-        printDebugInfo(state);
-        analysisSet.begin(state);
-        
-        _result_states.append(state);
+    for (int i = 0; i < size; i++) {
+        Analysis *analysis = aSet.get(i).clone();
+        _model.addAnalysis(analysis);
+    }
 
-        // Integrate Forward in Time
-        double dt = get_report_time_step();
-        int nSteps = (int)lround((get_stop_time() - get_start_time()) / dt);
+    if (get_use_visualizer()) {
+        _model.setUseVisualizer(true);
+    }
 
-        log_info("start time: {}", get_start_time());
-        log_info("stop time: {}", get_stop_time());
+    SimTK::State state = _model.initSystem();
+    
+    for (const auto& mesh : _model.updComponentList<Smith2018ContactMesh>()) {
+        mesh.printMeshDebugInfo();
+    }        
 
-        for (int i = 0; i <= nSteps; ++i) {
-            
-            double t = get_start_time() + (i+1) * dt;
-            log_info("time: {}", t);
-            
-            //Set Prescribed Muscle Forces
-            if(_prescribed_frc_actuator_paths.size() > 0){
-                for (int j = 0; j < (int)_prescribed_frc_actuator_paths.size();++j) {
-                    std::string actuator_path = _prescribed_frc_actuator_paths[j];
-                    ScalarActuator& actuator = _model.updComponent<ScalarActuator>(actuator_path);
-                    double value = _frc_functions.get(actuator_path +"_frc").calcValue(SimTK::Vector(1,t));
-                    actuator.setOverrideActuation(state, value);
-                }
-                timestepper.initialize(state);
-            }
+    // Initialize Muscle States
+    for (Muscle& msl : _model.updComponentList<Muscle>()) {
+        std::string msl_path = msl.getAbsolutePathString();
 
-            timestepper.stepTo(t);
+        if (contains_string(_prescribed_frc_actuator_paths, msl_path)) {                
+            msl.overrideActuation(state, true);
+            msl.setOverrideActuation(state, 0.0);
 
-            state = timestepper.getState();
-            _model.realizeReport(state);
-            printDebugInfo(state);
+            continue;
+        }
+        if (contains_string(_prescribed_act_actuator_paths, msl_path)) {
+            continue;
+        }
+        if (contains_string(_prescribed_control_actuator_paths, msl_path)) {
+            continue;
+        }
 
-            // Record Result
-            /* if (i == 0) {
-                analysisSet.begin(state);
+        if (get_constant_muscle_control() > -1) {
+            if (!get_use_muscle_physiology ()) {
+                msl.overrideActuation(state, true);
+                /*msl.setOverrideActuation(
+                        state, get_constant_muscle_control() *
+                                       msl.getMaxIsometricForce()); */
             }
-            else {*/
-                analysisSet.step(state, i);
-            //}
-            _result_states.append(state);            
         }
+    }
 
-        printResults();
+    if (get_equilibrate_muscles()) { _model.equilibrateMuscles(state); }
 
-        const long long elapsed = stopwatch.getElapsedTimeInNs();
+    AnalysisSet& analysisSet = _model.updAnalysisSet();
 
-        log_info("\nForsim Tool complete.");
-        log_info("Finished in {}", stopwatch.formatNs(elapsed));        
-        log_info("");
-
-        completed = true;
+    //Setup Visualizer
+    if (get_use_visualizer()) {
+        _model.updMatterSubsystem().setShowDefaultGeometry(false);
+        SimTK::Visualizer& viz = _model.updVisualizer().updSimbodyVisualizer();
+        viz.setBackgroundColor(SimTK::Black);
+        viz.setBackgroundType(SimTK::Visualizer::BackgroundType::SolidColor);
+        viz.setMode(SimTK::Visualizer::Mode::Sampling);
+        viz.setShowSimTime(true);
+        viz.setDesiredFrameRate(100);
     }
 
-    catch(const std::exception& x) {
-        log_error("ForsimTool::run() caught an exception: \n {}", x.what());
-        cwd.restore();
-    }
-    catch (...) { // e.g. may get InterruptedException
-        log_error("ForsimTool::run() caught an exception.");
-        cwd.restore();
+    //Setup Integrator
+    state.setTime(get_start_time());
+
+    SimTK::CPodesIntegrator integrator(_model.getSystem(), SimTK::CPodes::BDF, SimTK::CPodes::Newton);
+    integrator.setAccuracy(get_integrator_accuracy());
+    integrator.setMinimumStepSize(get_minimum_time_step());
+    integrator.setMaximumStepSize(get_maximum_time_step());
+    if (get_internal_step_limit()>0) {
+        integrator.setInternalStepLimit(get_internal_step_limit());
     }
+    SimTK::TimeStepper timestepper(_model.getSystem(), integrator);
+    timestepper.initialize(state);
 
-    cwd.restore();
+   // Record Initial State
+    log_debug("Initial State:");
+    _model.realizeReport(state);
+    printDebugInfo(state);
+    analysisSet.begin(state);
+    
+    _result_states.append(state);
 
-    return completed; 
+    // Integrate Forward in Time
+    double dt = get_report_time_step();
+    int nSteps = (int)lround((get_stop_time() - get_start_time()) / dt);
+
+    log_info("start time: {}", get_start_time());
+    log_info("stop time: {}", get_stop_time());
+
+    for (int i = 0; i <= nSteps; ++i) {
+        
+        double t = get_start_time() + (i+1) * dt;
+        log_info("time: {}", t);
+        
+        //Set Prescribed Muscle Forces
+        if(_prescribed_frc_actuator_paths.size() > 0){
+            for (int j = 0; j < (int)_prescribed_frc_actuator_paths.size();++j) {
+                std::string actuator_path = _prescribed_frc_actuator_paths[j];
+                ScalarActuator& actuator = _model.updComponent<ScalarActuator>(actuator_path);
+                double value = _frc_functions.get(actuator_path +"_frc").calcValue(SimTK::Vector(1,t));
+                actuator.setOverrideActuation(state, value);
+            }
+            timestepper.initialize(state);
+        }
+
+        timestepper.stepTo(t);
+
+        state = timestepper.getState();
+        _model.realizeReport(state);
+        printDebugInfo(state);
+
+        // Record Result
+        /* if (i == 0) {
+            analysisSet.begin(state);
+        }
+        else {*/
+            analysisSet.step(state, i);
+        //}
+        _result_states.append(state);            
+    }
 }
 
 void ForsimTool::initializeStartStopTimes() {
@@ -630,18 +646,25 @@ void ForsimTool::initializeCoordinates() {
     STOFileAdapter coord_file;
     if (get_prescribed_coordinates_file() != "") {
 
-        std::string saveWorkingDirectory = IO::getCwd();
-        IO::chDir(_directoryOfSetupFile);
-
-        try {
+        // The working directory is shared by all threads, so only change it
+        // if a directory was set (see simulate()).
+        if (_directoryOfSetupFile.empty()) {
             _coord_table = TimeSeriesTable(get_prescribed_coordinates_file());
+        } else {
+            std::string saveWorkingDirectory = IO::getCwd();
+            IO::chDir(_directoryOfSetupFile);
 
-        }
-        catch (...) { // Properly restore current directory if an exception is thrown
+            try {
+                _coord_table =
+                        TimeSeriesTable(get_prescribed_coordinates_file());
+
+            }
+            catch (...) { // Properly restore current directory if an exception is thrown
+                IO::chDir(saveWorkingDirectory);
+                throw;
+            }
             IO::chDir(saveWorkingDirectory);
-            throw;
         }
-        IO::chDir(saveWorkingDirectory);
 
         std::vector<std::string> labels = _coord_table.getColumnLabels();
 
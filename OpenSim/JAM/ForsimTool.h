@@ -189,6 +189,12 @@ public:
         "The columns labels must be formatted as 'time' and "
         "'/Path/To/Coordinate'")
 
+    OpenSim_DECLARE_PROPERTY(function_based_paths_file, std::string,
+        "Optional. Path to .xml file containing a Set of FunctionBasedPaths "
+        "(e.g. ligament paths fitted with PolynomialPathFitter). The path of "
+        "each Force named by a FunctionBasedPath is replaced, so its length "
+        "is evaluated without wrapping.")
+
     OpenSim_DECLARE_PROPERTY(use_visualizer, bool, "Use the SimTK visualizer "
         "to display the simulation. The default value is false.")
 
@@ -209,6 +215,23 @@ public:
 
     void setModel(Model& aModel);
     bool run();
+
+    /** Perform the forward simulation without changing the working directory
+    or writing any results files, and throw if the simulation fails. Relative
+    paths to the input files are resolved against the current working
+    directory, and the geometry_folder is not added to the geometry search
+    paths. Unlike run(), this can be called by several threads at once, each
+    with its own ForsimTool and model (see ForsimEnsembleTool). */
+    void simulate();
+
+    /** The model after simulate() or run(), including the controller and
+    reporters added by the tool. */
+    const Model& getModel() const { return _model; }
+
+    /** The states at each report time of the last simulation. */
+    const StatesTrajectory& getStatesTrajectory() const {
+        return _result_states;
+    }
     
 private:
     void setNull();
@@ -1908,13 +1908,13 @@ int JointMechanicsTool::record(const SimTK::State& s, const int frame_num)
             Blankevoort1991Ligament& lig = 
                 _model.updComponent<Blankevoort1991Ligament>(lig_path);
 
-            //Path Points
-            const GeometryPath& geoPath = lig.updGeometryPath();
-
+            //Path Points (none for surrogate paths, e.g. FunctionBasedPath)
             int nPoints = 0;
             SimTK::Vector_<SimTK::Vec3> path_points(_max_path_points, SimTK::Vec3(-1));
 
-            getGeometryPathPoints(s, geoPath, path_points, nPoints);
+            if (const GeometryPath* geoPath = lig.tryGetPath<GeometryPath>()) {
+                getGeometryPathPoints(s, *geoPath, path_points, nPoints);
+            }
             for (int i = 0; i < nPoints; ++i) {
                 _ligament_path_points[nLig].set(frame_num,i,path_points(i));
             }
@@ -1937,15 +1937,15 @@ int JointMechanicsTool::record(const SimTK::State& s, const int frame_num)
         for (const std::string& msl_path : _muscle_paths) {
             Muscle& msl = _model.updComponent<Muscle>(msl_path);
 
-            //Path Points
-            const GeometryPath& geoPath = msl.updGeometryPath();
-
+            //Path Points (none for surrogate paths, e.g. FunctionBasedPath)
             int nPoints = 0;
 
             SimTK::Vector_<SimTK::Vec3> 
                 path_points(_max_path_points,SimTK::Vec3(-1));
 
-            getGeometryPathPoints(s, geoPath, path_points, nPoints);
+            if (const GeometryPath* geoPath = msl.tryGetPath<GeometryPath>()) {
+                getGeometryPathPoints(s, *geoPath, path_points, nPoints);
+            }
             for (int i = 0; i < nPoints; ++i) {
                 _muscle_path_points[nMsl].set(frame_num,i,path_points(i));
             }
@@ -1957,7 +1957,7 @@ int JointMechanicsTool::record(const SimTK::State& s, const int frame_num)
                 
                 if (output_name == "length") {
                     _muscle_output_double_values[nMsl].set(frame_num, j,
-                        msl.getGeometryPath().getOutputValue<double>
+                        msl.getPath().getOutputValue<double>
                         (s, "length"));
                 }
                 else if (output_name == "tension") {
@@ -25,6 +25,7 @@
 #include "OpenSim/Simulation/Model/Smith2018ArticularContactForce.h"
 #include "JointMechanicsTool.h"
 #include "ForsimTool.h"
+#include "ForsimEnsembleTool.h"
 #include "COMAKSettings.h"
 #include "COMAKSettingsSet.h"
 #include "COMAKTool.h"
@@ -44,6 +45,8 @@ OSIMJAM_API void RegisterTypes_osimJAM() {
     Object::registerType(JointMechanicsFrameTransform());
     Object::registerType(JointMechanicsFrameTransformSet());
     Object::registerType(ForsimTool());
+    Object::registerType(ForsimEnsembleParameter());
+    Object::registerType(ForsimEnsembleTool());
     Object::registerType(COMAKSecondaryCoordinate());
     Object::registerType(COMAKSecondaryCoordinateSet());
     Object::registerType(COMAKCostFunctionParameter());
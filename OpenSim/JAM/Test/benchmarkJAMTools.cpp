@@ -0,0 +1,479 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim JAM: benchmarkJAMTools.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2024 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Benchmark for the JAM tools that does not depend on any external model or
+// data files. A knee-like model is generated procedurally for each requested
+// cartilage mesh resolution: a femur welded to ground, a tibia attached
+// through a 6 degree-of-freedom CustomJoint, a spherical femoral condyle
+// contacting a flat tibial plateau (Smith2018ArticularContactForce), four
+// Blankevoort1991Ligaments and six muscles. Each model is then driven
+// through the same synthetic flexion motion by ForsimTool, COMAKTool and
+// JointMechanicsTool.
+//
+// Usage:
+//     benchmarkJAMTools [results_directory] [resolution ...]
+//
+// The resolution is the number of grid cells along each edge of the
+// cartilage meshes (each mesh has 2 * resolution^2 triangles); the default
+// is 10, 20 and 40. Wall times for every phase, and the number of contact
+// evaluations per second for the contact sweep phase, are written to
+// jam_benchmark.csv and jam_benchmark.json in the results directory.
+
+#include <OpenSim/OpenSim.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/JAM/COMAKTool.h>
+#include <OpenSim/JAM/ForsimTool.h>
+#include <OpenSim/JAM/JointMechanicsTool.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+using namespace OpenSim;
+
+namespace {
+
+const double condyleRadius = 0.025;
+const double condyleHalfWidth = 0.6 * condyleRadius;
+const double plateauHalfWidth = 0.02;
+const double initialPenetration = 0.001;
+
+const double motionDuration = 1.0;
+const double motionTimeStep = 0.01;
+const double maxFlexion = 60.0; // degrees
+const int numContactSweepFrames = 500;
+
+struct PhaseResult {
+    int resolution;
+    int numTriangles;
+    std::string phase;
+    bool success;
+    double wallTime;
+    long long numEvaluations;
+};
+
+struct Attachment {
+    std::string name;
+    SimTK::Vec3 femurPoint;
+    SimTK::Vec3 tibiaPoint;
+};
+
+double distance(const SimTK::Vec3& a, const SimTK::Vec3& b) {
+    return (a - b).norm();
+}
+
+// Write an n x n grid of quads (two triangles each) to a Wavefront .obj
+// file. The vertices are placed at (x, height(x, z), z) for x, z in
+// [-halfWidth, halfWidth]; the triangle normals point along +y if `faceUp`
+// is true and along -y otherwise.
+void writeGridMesh(const std::string& fileName, int n, double halfWidth,
+        const std::function<double(double, double)>& height, bool faceUp) {
+    std::ofstream out(fileName);
+    OPENSIM_THROW_IF(!out, Exception, "Could not open " + fileName + ".");
+    out.precision(12);
+
+    const double step = 2 * halfWidth / n;
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= n; ++j) {
+            const double x = -halfWidth + i * step;
+            const double z = -halfWidth + j * step;
+            out << "v " << x << " " << height(x, z) << " " << z << "\n";
+        }
+    }
+
+    // .obj vertex indices are 1-based.
+    auto index = [n](int i, int j) { return i * (n + 1) + j + 1; };
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            const int a = index(i, j);
+            const int b = index(i + 1, j);
+            const int c = index(i + 1, j + 1);
+            const int d = index(i, j + 1);
+            if (faceUp) {
+                out << "f " << a << " " << c << " " << b << "\n";
+                out << "f " << a << " " << d << " " << c << "\n";
+            } else {
+                out << "f " << a << " " << b << " " << c << "\n";
+                out << "f " << a << " " << c << " " << d << "\n";
+            }
+        }
+    }
+}
+
+// Generate the synthetic knee model and its cartilage meshes in `directory`
+// and return the path to the printed .osim file. All coordinates are zero in
+// the default pose, so the tibia and femur frames coincide and the ligament
+// and muscle lengths in that pose are the straight-line distances between
+// their attachments.
+std::string buildKneeModel(const std::string& directory, int resolution) {
+    const std::string suffix = "_" + std::to_string(resolution);
+    const std::string femurMeshFile = "femur_cartilage" + suffix + ".obj";
+    const std::string tibiaMeshFile = "tibia_cartilage" + suffix + ".obj";
+
+    writeGridMesh(directory + "/" + femurMeshFile, resolution,
+            condyleHalfWidth,
+            [](double x, double z) {
+                return -std::sqrt(condyleRadius * condyleRadius - x * x -
+                                  z * z);
+            },
+            false);
+    writeGridMesh(directory + "/" + tibiaMeshFile, resolution,
+            plateauHalfWidth, [](double, double) { return 0.0; }, true);
+
+    Model model;
+    model.setName("synthetic_knee" + suffix);
+
+    auto* femur = new OpenSim::Body("femur", 9.3, SimTK::Vec3(0, 0.17, 0),
+            SimTK::Inertia(0.13, 0.03, 0.13));
+    auto* tibia = new OpenSim::Body("tibia", 3.7, SimTK::Vec3(0, -0.18, 0),
+            SimTK::Inertia(0.05, 0.006, 0.05));
+    model.addBody(femur);
+    model.addBody(tibia);
+
+    model.addJoint(new WeldJoint("hip", model.getGround(), *femur));
+
+    // The knee rotates about the center of the femoral condyle so that the
+    // condyle rolls in place on the plateau as the knee flexes.
+    SpatialTransform transform;
+    transform.upd_rotation1().set_coordinates(0, "knee_flex");
+    transform.upd_rotation1().set_axis(SimTK::Vec3(0, 0, -1));
+    transform.upd_rotation2().set_coordinates(0, "knee_add");
+    transform.upd_rotation2().set_axis(SimTK::Vec3(1, 0, 0));
+    transform.upd_rotation3().set_coordinates(0, "knee_rot");
+    transform.upd_rotation3().set_axis(SimTK::Vec3(0, 1, 0));
+    transform.upd_translation1().set_coordinates(0, "knee_tx");
+    transform.upd_translation1().set_axis(SimTK::Vec3(1, 0, 0));
+    transform.upd_translation2().set_coordinates(0, "knee_ty");
+    transform.upd_translation2().set_axis(SimTK::Vec3(0, 1, 0));
+    transform.upd_translation3().set_coordinates(0, "knee_tz");
+    transform.upd_translation3().set_axis(SimTK::Vec3(0, 0, 1));
+    for (auto* axis : {&transform.upd_rotation1(), &transform.upd_rotation2(),
+                 &transform.upd_rotation3(), &transform.upd_translation1(),
+                 &transform.upd_translation2(),
+                 &transform.upd_translation3()}) {
+        axis->set_function(LinearFunction());
+    }
+    auto* knee = new CustomJoint("knee", *femur, *tibia, transform);
+    for (int i = 0; i < knee->numCoordinates(); ++i) {
+        Coordinate& coord = knee->upd_coordinates(i);
+        if (coord.getName() == "knee_flex") {
+            double range[2] = {SimTK::convertDegreesToRadians(-10.0),
+                    SimTK::convertDegreesToRadians(120.0)};
+            coord.setRange(range);
+        }
+    }
+    model.addJoint(knee);
+
+    // Cartilage contact.
+    auto* femurCartilage = new Smith2018ContactMesh("femur_cartilage",
+            femurMeshFile, *femur);
+    femurCartilage->set_thickness(0.0025);
+    femurCartilage->set_elastic_modulus(5e6);
+    auto* tibiaCartilage = new Smith2018ContactMesh("tibia_cartilage",
+            tibiaMeshFile, *tibia,
+            SimTK::Vec3(0, -condyleRadius + initialPenetration, 0),
+            SimTK::Vec3(0));
+    tibiaCartilage->set_thickness(0.003);
+    tibiaCartilage->set_elastic_modulus(5e6);
+    model.addContactGeometry(femurCartilage);
+    model.addContactGeometry(tibiaCartilage);
+    model.addForce(new Smith2018ArticularContactForce(
+            "tf_contact", *femurCartilage, *tibiaCartilage));
+
+    // Ligaments, slightly taut in the default pose.
+    const std::vector<Attachment> ligaments = {
+            {"ACL", {-0.012, 0.0, -0.008}, {0.012, -0.028, 0.004}},
+            {"PCL", {0.010, 0.0, 0.005}, {-0.015, -0.030, -0.003}},
+            {"MCL", {0.0, 0.005, 0.035}, {0.0, -0.060, 0.030}},
+            {"LCL", {0.0, 0.005, -0.035}, {-0.005, -0.055, -0.035}}};
+    const double referenceStrain = 0.03;
+    for (const auto& lig : ligaments) {
+        const double length = distance(lig.femurPoint, lig.tibiaPoint);
+        model.addForce(new Blankevoort1991Ligament(lig.name, *femur,
+                lig.femurPoint, *tibia, lig.tibiaPoint, 2000.0,
+                length / (1 + referenceStrain)));
+    }
+
+    // Muscles, with their fibers at the optimal length in the default pose.
+    const std::vector<Attachment> muscles = {
+            {"vasmed", {0.025, 0.20, 0.01}, {0.035, -0.06, 0.005}},
+            {"vaslat", {0.025, 0.20, -0.01}, {0.035, -0.06, -0.005}},
+            {"semimem", {-0.03, 0.20, 0.015}, {-0.025, -0.05, 0.02}},
+            {"bflh", {-0.03, 0.20, -0.015}, {-0.025, -0.05, -0.025}},
+            {"gasmed", {-0.02, 0.02, 0.02}, {-0.04, -0.38, 0.0}},
+            {"gaslat", {-0.02, 0.02, -0.02}, {-0.04, -0.38, -0.005}}};
+    const double optimalFiberLength = 0.07;
+    for (const auto& msl : muscles) {
+        const double length = distance(msl.femurPoint, msl.tibiaPoint);
+        auto* muscle = new Millard2012EquilibriumMuscle(msl.name, 1500.0,
+                optimalFiberLength, length - optimalFiberLength, 0.0);
+        muscle->addNewPathPoint(msl.name + "-P1", *femur, msl.femurPoint);
+        muscle->addNewPathPoint(msl.name + "-P2", *tibia, msl.tibiaPoint);
+        model.addForce(muscle);
+    }
+
+    auto* reserve = new CoordinateActuator("knee_flex");
+    reserve->setName("knee_flex_reserve");
+    reserve->setOptimalForce(10.0);
+    model.addForce(reserve);
+
+    // The mesh files are found relative to the model file, so the model must
+    // know where it will be printed before its connections are finalized.
+    const std::string modelFile =
+            directory + "/synthetic_knee" + suffix + ".osim";
+    model.setInputFileName(modelFile);
+    model.finalizeFromProperties();
+    model.finalizeConnections();
+    model.print(modelFile);
+    return modelFile;
+}
+
+// A smooth flexion-extension cycle, 0 -> maxFlexion -> 0 degrees.
+double flexionAngle(double time) {
+    return 0.5 * maxFlexion *
+           (1 - std::cos(2 * SimTK::Pi * time / motionDuration));
+}
+
+std::string writeMotionFile(const std::string& directory) {
+    std::vector<double> time;
+    SimTK::Matrix values(
+            (int)std::lround(motionDuration / motionTimeStep) + 1, 1);
+    for (int i = 0; i < values.nrow(); ++i) {
+        time.push_back(i * motionTimeStep);
+        values(i, 0) = flexionAngle(time.back());
+    }
+    TimeSeriesTable table(time, values, {"knee_flex"});
+    table.addTableMetaData("inDegrees", std::string("yes"));
+
+    const std::string motionFile = directory + "/synthetic_flexion.sto";
+    STOFileAdapter::write(table, motionFile);
+    return motionFile;
+}
+
+// Evaluate the contact force alone (muscles and ligaments disabled) over a
+// sweep of flexion angles and small superior-inferior tibial translations.
+long long sweepContact(const std::string& modelFile) {
+    Model model(modelFile);
+    for (auto& force : model.updComponentList<Force>()) {
+        if (!dynamic_cast<Smith2018ArticularContactForce*>(&force)) {
+            force.set_appliesForce(false);
+        }
+    }
+    SimTK::State state = model.initSystem();
+    const auto& flex = model.getComponent<Coordinate>("/jointset/knee/knee_flex");
+    const auto& ty = model.getComponent<Coordinate>("/jointset/knee/knee_ty");
+    const auto& contact = model.getComponent<Smith2018ArticularContactForce>(
+            "/forceset/tf_contact");
+
+    long long numContacting = 0;
+    for (int i = 0; i < numContactSweepFrames; ++i) {
+        const double t = motionDuration * i / numContactSweepFrames;
+        flex.setValue(state,
+                SimTK::convertDegreesToRadians(flexionAngle(t)), false);
+        ty.setValue(state,
+                0.5 * initialPenetration * std::sin(6 * SimTK::Pi * t), false);
+        model.realizeDynamics(state);
+        numContacting += contact.getCastingNumContactingTriangles(state);
+    }
+    log_info("Contact sweep: {} contacting triangles per frame on average.",
+            numContacting / numContactSweepFrames);
+    return numContactSweepFrames;
+}
+
+bool runForsim(const std::string& modelFile, const std::string& motionFile,
+        const std::string& resultsDir) {
+    ForsimTool forsim;
+    forsim.set_model_file(modelFile);
+    forsim.set_results_directory(resultsDir);
+    forsim.set_results_file_basename("forsim");
+    forsim.set_report_time_step(motionTimeStep);
+    forsim.set_integrator_accuracy(1e-3);
+    forsim.set_constant_muscle_control(0.02);
+    forsim.set_use_activation_dynamics(true);
+    forsim.set_use_tendon_compliance(false);
+    forsim.set_use_muscle_physiology(true);
+    forsim.set_equilibrate_muscles(true);
+    int i = 0;
+    for (const auto* name :
+            {"knee_add", "knee_rot", "knee_tx", "knee_ty", "knee_tz"}) {
+        forsim.set_unconstrained_coordinates(
+                i++, std::string("/jointset/knee/") + name);
+    }
+    forsim.set_prescribed_coordinates_file(motionFile);
+    return forsim.run();
+}
+
+bool runCOMAK(const std::string& modelFile, const std::string& motionFile,
+        const std::string& resultsDir) {
+    COMAKTool comak;
+    comak.set_model_file(modelFile);
+    comak.set_coordinates_file(motionFile);
+    comak.set_results_directory(resultsDir);
+    comak.set_results_prefix("comak");
+    comak.set_start_time(0);
+    comak.set_stop_time(motionDuration);
+    comak.set_time_step(5 * motionTimeStep);
+    comak.set_lowpass_filter_frequency(-1);
+    comak.set_primary_coordinates(0, "/jointset/knee/knee_flex");
+    for (const auto* name :
+            {"knee_add", "knee_rot", "knee_tx", "knee_ty", "knee_tz"}) {
+        COMAKSecondaryCoordinate secondary;
+        secondary.setName(name);
+        secondary.set_coordinate(std::string("/jointset/knee/") + name);
+        const bool isRotation = std::string(name) == "knee_add" ||
+                                std::string(name) == "knee_rot";
+        secondary.set_max_change(isRotation ? 0.05 : 0.002);
+        comak.upd_COMAKSecondaryCoordinateSet().cloneAndAppend(secondary);
+    }
+    comak.set_settle_secondary_coordinates_at_start(true);
+    comak.set_settle_threshold(1e-3);
+    comak.set_settle_accuracy(1e-3);
+    comak.set_max_iterations(25);
+    comak.set_udot_tolerance(1);
+    comak.set_udot_worse_case_tolerance(50);
+    return comak.run();
+}
+
+bool runJointMechanics(const std::string& modelFile,
+        const std::string& forsimResultsDir, const std::string& resultsDir) {
+    JointMechanicsTool jnt_mech;
+    jnt_mech.set_model_file(modelFile);
+    jnt_mech.set_input_states_file(forsimResultsDir + "/forsim_states.sto");
+    jnt_mech.set_use_activation_dynamics(true);
+    jnt_mech.set_use_tendon_compliance(false);
+    jnt_mech.set_use_muscle_physiology(true);
+    jnt_mech.set_results_directory(resultsDir);
+    jnt_mech.set_results_file_basename("joint_mechanics");
+    jnt_mech.set_contacts(0, "all");
+    jnt_mech.set_ligaments(0, "all");
+    jnt_mech.set_muscles(0, "all");
+    jnt_mech.set_muscle_outputs(0, "all");
+    jnt_mech.set_write_vtp_files(true);
+    jnt_mech.set_write_h5_file(false);
+    return jnt_mech.run();
+}
+
+template <typename F>
+void timePhase(std::vector<PhaseResult>& results, int resolution,
+        int numTriangles, const std::string& phase, F&& f) {
+    log_info("Benchmark: resolution {}, phase '{}'.", resolution, phase);
+    bool success = true;
+    long long numEvaluations = 0;
+    const Stopwatch stopwatch;
+    try {
+        numEvaluations = f();
+        if (numEvaluations < 0) { success = false; }
+    } catch (const std::exception& e) {
+        log_error("Phase '{}' failed: {}", phase, e.what());
+        success = false;
+    }
+    const double elapsed = stopwatch.getElapsedTime();
+    results.push_back({resolution, numTriangles, phase, success, elapsed,
+            std::max(numEvaluations, 0LL)});
+}
+
+void writeResults(const std::string& directory,
+        const std::vector<PhaseResult>& results) {
+    auto rate = [](const PhaseResult& r) {
+        return r.numEvaluations > 0 && r.wallTime > 0
+                       ? r.numEvaluations / r.wallTime
+                       : 0.0;
+    };
+
+    std::ofstream csv(directory + "/jam_benchmark.csv");
+    csv << "resolution,triangles,phase,success,wall_time_s,"
+           "contact_evaluations,contact_evaluations_per_s\n";
+    for (const auto& r : results) {
+        csv << r.resolution << "," << r.numTriangles << "," << r.phase << ","
+            << (r.success ? "true" : "false") << "," << r.wallTime << ","
+            << r.numEvaluations << "," << rate(r) << "\n";
+    }
+
+    std::ofstream json(directory + "/jam_benchmark.json");
+    json << "{\n  \"phases\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        json << "    {\"resolution\": " << r.resolution
+             << ", \"triangles\": " << r.numTriangles << ", \"phase\": \""
+             << r.phase << "\", \"success\": "
+             << (r.success ? "true" : "false")
+             << ", \"wall_time_s\": " << r.wallTime
+             << ", \"contact_evaluations\": " << r.numEvaluations
+             << ", \"contact_evaluations_per_s\": " << rate(r) << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const std::string resultsDir =
+                argc > 1 ? argv[1] : "benchmarkJAMTools_results";
+        std::vector<int> resolutions;
+        for (int i = 2; i < argc; ++i) {
+            resolutions.push_back(std::stoi(argv[i]));
+        }
+        if (resolutions.empty()) { resolutions = {10, 20, 40}; }
+
+        IO::makeDir(resultsDir);
+        const std::string motionFile = writeMotionFile(resultsDir);
+
+        std::vector<PhaseResult> results;
+        for (int resolution : resolutions) {
+            const std::string dir =
+                    resultsDir + "/resolution_" + std::to_string(resolution);
+            IO::makeDir(dir);
+            const int numTriangles = 2 * resolution * resolution;
+
+            std::string modelFile;
+            timePhase(results, resolution, numTriangles, "build_model", [&] {
+                modelFile = buildKneeModel(dir, resolution);
+                return 0LL;
+            });
+            timePhase(results, resolution, numTriangles, "contact_sweep",
+                    [&] { return sweepContact(modelFile); });
+            timePhase(results, resolution, numTriangles, "forsim", [&] {
+                return runForsim(modelFile, motionFile, dir + "/forsim")
+                               ? 0LL : -1LL;
+            });
+            timePhase(results, resolution, numTriangles, "comak", [&] {
+                return runCOMAK(modelFile, motionFile, dir + "/comak")
+                               ? 0LL : -1LL;
+            });
+            timePhase(results, resolution, numTriangles, "joint_mechanics",
+                    [&] {
+                        return runJointMechanics(modelFile, dir + "/forsim",
+                                       dir + "/joint-mechanics")
+                                       ? 0LL : -1LL;
+                    });
+        }
+
+        writeResults(resultsDir, results);
+        for (const auto& r : results) {
+            log_cout("{:>4} {:>7} {:<16} {:>10.3f} s {}", r.resolution,
+                    r.numTriangles, r.phase, r.wallTime,
+                    r.success ? "" : "(failed)");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -16,19 +16,25 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <OpenSim/JAM/ForsimEnsembleTool.h>
 #include <OpenSim/JAM/ForsimTool.h>
 #include <OpenSim/JAM/JointMechanicsTool.h>
 #include <OpenSim/Analyses/ForceReporter.h>
 #include <OpenSim/Analyses/MuscleAnalysis.h>
+#include <OpenSim/Actuators/SpringGeneralizedForce.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 
 void testPassiveFlexion();
 void testLigamentBalance();
+void testForsimEnsemble();
 
 int main() {
     try {
         //testPassiveFlexion();
+        testForsimEnsemble();
 
     } catch (const Exception& e) {
         e.print(std::cerr);
@@ -212,4 +218,91 @@ void testLigamentBalance() {
         model.print(new_model_file); 
         */
 
-}
\ No newline at end of file
+}
+
+// A block hanging from a spring along a slider joint.
+Model createSpringBlockModel() {
+    Model model;
+    model.setName("spring_block");
+    model.setGravity(SimTK::Vec3(-9.81, 0, 0));
+    auto* block = new Body("block", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
+    model.addBody(block);
+    auto* slider = new SliderJoint("slider", model.getGround(), *block);
+    slider->updCoordinate().setName("x");
+    model.addJoint(slider);
+    auto* spring = new SpringGeneralizedForce("x");
+    spring->setName("spring");
+    spring->setStiffness(100);
+    spring->setViscosity(5);
+    model.addForce(spring);
+    model.finalizeConnections();
+    return model;
+}
+
+void testForsimEnsemble() {
+    Model model = createSpringBlockModel();
+
+    ForsimTool forsim;
+    forsim.set_start_time(0);
+    forsim.set_stop_time(0.5);
+    forsim.set_report_time_step(0.05);
+    forsim.set_integrator_accuracy(1e-6);
+    forsim.set_constant_muscle_control(-1);
+    forsim.set_equilibrate_muscles(false);
+    forsim.set_unconstrained_coordinates(0, "/jointset/slider/x");
+
+    ForsimEnsembleTool ensemble;
+    ensemble.setModel(model);
+    ensemble.set_results_directory("forsim_ensemble");
+    ensemble.set_results_file_basename("spring_block");
+    ensemble.set_forsim_tool(forsim);
+    ensemble.append_parameters(ForsimEnsembleParameter(
+            "/forceset/spring", "stiffness", 0.5, 1.5, true));
+    ensemble.append_outputs("/jointset/slider/x|value");
+    ensemble.set_num_threads(2);
+
+    SimTK::Matrix design(3, 1);
+    design(0, 0) = 0;
+    design(1, 0) = 0.5;
+    design(2, 0) = 1;
+    ensemble.setDesign(design);
+    ASSERT(ensemble.run());
+
+    const SimTK::Matrix& stiffness = ensemble.getParameterValues();
+    ASSERT_EQUAL(50.0, stiffness(0, 0), 1e-12);
+    ASSERT_EQUAL(100.0, stiffness(1, 0), 1e-12);
+    ASSERT_EQUAL(150.0, stiffness(2, 0), 1e-12);
+
+    const TimeSeriesTable& table =
+            ensemble.getOutputTable("/jointset/slider/x|value");
+    ASSERT(table.getNumColumns() == 3);
+    ASSERT(table.getColumnLabel(2) == "member_3");
+
+    // Each member matches a simulation of the perturbed model on its own.
+    for (int i = 0; i < 3; ++i) {
+        Model member(model);
+        member.finalizeFromProperties();
+        member.updComponent<SpringGeneralizedForce>("/forceset/spring")
+                .setStiffness(stiffness(i, 0));
+        ForsimTool memberForsim(forsim);
+        memberForsim.setModel(member);
+        memberForsim.simulate();
+
+        const Model& simModel = memberForsim.getModel();
+        const StatesTrajectory& states = memberForsim.getStatesTrajectory();
+        ASSERT((int)states.getSize() == (int)table.getNumRows());
+        const auto& column = table.getDependentColumnAtIndex(i);
+        for (int t = 0; t < (int)states.getSize(); ++t) {
+            ASSERT_EQUAL(table.getIndependentColumn()[t],
+                    states[t].getTime(), 1e-12);
+            ASSERT_EQUAL(column[t],
+                    simModel.getCoordinateSet().get("x").getValue(states[t]),
+                    1e-12);
+        }
+    }
+
+    // A stiffer spring stretches less.
+    const int last = (int)table.getNumRows() - 1;
+    ASSERT(std::abs(table.getDependentColumnAtIndex(2)[last]) <
+           std::abs(table.getDependentColumnAtIndex(0)[last]));
+}
@@ -27,6 +27,7 @@
 #include "COMAKTarget.h"
 #include "COMAKTool.h"
 #include "ForsimTool.h"
+#include "ForsimEnsembleTool.h"
 #include "H5FileAdapter.h"
 #include "JointMechanicsTool.h"
 
@@ -18,6 +18,8 @@
 
 #include "CasOCProblem.h"
 
+#include <algorithm>
+
 #include <OpenSim/Moco/MocoUtilities.h>
 #include "CasOCTranscription.h"
 #include "CasOCTrapezoidal.h"
@@ -43,6 +45,90 @@ Iterate Iterate::resample(const casadi::DM& newTimes,
             appendProjectionStates);
 }
 
+bool Problem::updateBoundsFrom(const Problem& other) {
+    auto sameNames = [](const auto& a, const auto& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(),
+                       [](const auto& x, const auto& y) {
+                           return x.name == y.name;
+                       });
+    };
+    auto sameEndpointInfos = [&](const auto& a, const auto& b) {
+        if (!sameNames(a, b)) return false;
+        for (int i = 0; i < (int)a.size(); ++i) {
+            if (a[i].num_outputs != b[i].num_outputs ||
+                    (bool)a[i].integrand_function !=
+                            (bool)b[i].integrand_function ||
+                    (bool)a[i].endpoint_function !=
+                            (bool)b[i].endpoint_function) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!sameNames(m_stateInfos, other.m_stateInfos) ||
+            !sameNames(m_controlInfos, other.m_controlInfos) ||
+            !sameNames(m_multiplierInfos, other.m_multiplierInfos) ||
+            !sameNames(m_slackInfos, other.m_slackInfos) ||
+            !sameNames(m_paramInfos, other.m_paramInfos) ||
+            !sameEndpointInfos(m_costInfos, other.m_costInfos) ||
+            !sameEndpointInfos(m_endpointConstraintInfos,
+                    other.m_endpointConstraintInfos) ||
+            !sameNames(m_pathInfos, other.m_pathInfos) ||
+            m_dynamicsMode != other.m_dynamicsMode ||
+            m_kinematicConstraintMethod != other.m_kinematicConstraintMethod ||
+            m_prescribedKinematics != other.m_prescribedKinematics ||
+            m_enforceConstraintDerivatives !=
+                    other.m_enforceConstraintDerivatives ||
+            m_auxiliaryDerivativeNames != other.m_auxiliaryDerivativeNames) {
+        return false;
+    }
+    for (int i = 0; i < (int)m_pathInfos.size(); ++i) {
+        if (m_pathInfos[i].size() != other.m_pathInfos[i].size()) {
+            return false;
+        }
+    }
+
+    m_timeInitialBounds = other.m_timeInitialBounds;
+    m_timeFinalBounds = other.m_timeFinalBounds;
+    for (int i = 0; i < (int)m_stateInfos.size(); ++i) {
+        m_stateInfos[i].bounds = other.m_stateInfos[i].bounds;
+        m_stateInfos[i].initialBounds = other.m_stateInfos[i].initialBounds;
+        m_stateInfos[i].finalBounds = other.m_stateInfos[i].finalBounds;
+    }
+    for (int i = 0; i < (int)m_controlInfos.size(); ++i) {
+        m_controlInfos[i].bounds = other.m_controlInfos[i].bounds;
+        m_controlInfos[i].initialBounds =
+                other.m_controlInfos[i].initialBounds;
+        m_controlInfos[i].finalBounds = other.m_controlInfos[i].finalBounds;
+    }
+    for (int i = 0; i < (int)m_multiplierInfos.size(); ++i) {
+        m_multiplierInfos[i].bounds = other.m_multiplierInfos[i].bounds;
+        m_multiplierInfos[i].initialBounds =
+                other.m_multiplierInfos[i].initialBounds;
+        m_multiplierInfos[i].finalBounds =
+                other.m_multiplierInfos[i].finalBounds;
+    }
+    for (int i = 0; i < (int)m_slackInfos.size(); ++i) {
+        m_slackInfos[i].bounds = other.m_slackInfos[i].bounds;
+    }
+    for (int i = 0; i < (int)m_paramInfos.size(); ++i) {
+        m_paramInfos[i].bounds = other.m_paramInfos[i].bounds;
+    }
+    for (int i = 0; i < (int)m_endpointConstraintInfos.size(); ++i) {
+        m_endpointConstraintInfos[i].lowerBounds =
+                other.m_endpointConstraintInfos[i].lowerBounds;
+        m_endpointConstraintInfos[i].upperBounds =
+                other.m_endpointConstraintInfos[i].upperBounds;
+    }
+    for (int i = 0; i < (int)m_pathInfos.size(); ++i) {
+        m_pathInfos[i].lowerBounds = other.m_pathInfos[i].lowerBounds;
+        m_pathInfos[i].upperBounds = other.m_pathInfos[i].upperBounds;
+    }
+    m_kinematicConstraintBounds = other.m_kinematicConstraintBounds;
+    return true;
+}
+
 std::vector<std::string>
 Problem::createKinematicConstraintEquationNamesImpl() const {
     std::vector<std::string> names(getNumKinematicConstraintEquations());
@@ -413,6 +413,14 @@ public:
         return it;
     }
 
+    /// Copy the bounds on the time, states, controls, multipliers, slacks,
+    /// parameters, endpoint constraints and path constraints from another
+    /// problem with the same variables, goals and constraints. The functions
+    /// of this problem are unchanged, so a Transcription of this problem
+    /// remains valid. If the other problem has different variables, goals or
+    /// constraints, this returns false and does not modify this problem.
+    bool updateBoundsFrom(const Problem& other);
+
     void initialize(const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection) const {
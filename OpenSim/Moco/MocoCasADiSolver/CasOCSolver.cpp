@@ -116,7 +116,12 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
 }
 
 Solution Solver::solve(const Iterate& guess) const {
-    auto transcription = createTranscription();
+    if (m_reuseTranscription && m_transcription) {
+        m_transcription->updateBounds();
+        return m_transcription->solve(guess);
+    }
+
+    std::shared_ptr<Transcription> transcription = createTranscription();
     auto pointsForSparsityDetection =
             std::make_shared<std::vector<VariablesDM>>();
     if (m_sparsity_detection == "initial-guess") {
@@ -144,6 +149,7 @@ Solution Solver::solve(const Iterate& guess) const {
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
                     pointsForSparsityDetection));
+    if (m_reuseTranscription) m_transcription = transcription;
     return transcription->solve(guess);
 }
 
@@ -40,7 +40,10 @@ public:
             m_mesh.push_back(i / (double)(numMeshIntervals));
         }
     }
-    void setMesh(std::vector<double> mesh) { m_mesh = std::move(mesh); }
+    void setMesh(std::vector<double> mesh) {
+        m_mesh = std::move(mesh);
+        m_transcription.reset();
+    }
 
     const std::vector<double>& getMesh() const { return m_mesh; }
     void setTranscriptionScheme(std::string scheme) {
@@ -208,6 +211,19 @@ public:
     /// The contents of this iterate depends on the transcription scheme.
     Iterate createRandomIterateWithinBounds() const;
 
+    /// Keep the transcription of the problem (including the NLP solver)
+    /// created by the first call to solve(), and reuse it in later calls
+    /// instead of transcribing the problem again (default: false). Before
+    /// each later call, the bounds of the NLP are updated from the bounds of
+    /// the problem (see Problem::updateBoundsFrom()). Changing the mesh
+    /// discards the transcription; changes to other settings of this solver
+    /// do not take effect until the transcription is discarded.
+    void setReuseTranscription(bool tf) {
+        m_reuseTranscription = tf;
+        if (!tf) m_transcription.reset();
+    }
+    bool getReuseTranscription() const { return m_reuseTranscription; }
+
     Solution solve(const Iterate& guess) const;
 
 private:
@@ -238,6 +254,8 @@ private:
     int m_numThreads = 1;
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
+    bool m_reuseTranscription = false;
+    mutable std::shared_ptr<Transcription> m_transcription;
     std::string m_optimSolver;
 };
 
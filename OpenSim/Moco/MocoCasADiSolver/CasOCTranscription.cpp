@@ -217,14 +217,10 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
 
     // Set variable bounds.
     // --------------------
-    auto initializeBoundsDM = [&](VariablesDM& bounds) {
-        for (auto& kv : m_scaledVars) {
-            bounds[kv.first] = DM(kv.second.rows(), kv.second.columns());
-        }
-    };
-    initializeBoundsDM(m_lowerBounds);
-    initializeBoundsDM(m_upperBounds);
+    setVariableBoundsFromProblem();
 
+    // Set variable scaling.
+    // ---------------------
     // The VariablesDM for scaling have length 1 in the time dimension.
     auto initializeScalingDM = [&](VariablesDM& bounds) {
         for (auto& kv : m_scaledVars) {
@@ -235,12 +231,112 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     initializeScalingDM(m_shift);
     initializeScalingDM(m_scale);
 
-    setVariableBounds(initial_time, 0, 0, m_problem.getTimeInitialBounds());
-    setVariableBounds(final_time, 0, 0, m_problem.getTimeFinalBounds());
-
     setVariableScaling(initial_time, 0, 0, m_problem.getTimeInitialBounds());
     setVariableScaling(final_time, 0, 0, m_problem.getTimeFinalBounds());
 
+    for (const auto& info : m_problem.getStateInfos()) {
+        setVariableScaling(states, Slice(), Slice(), info.bounds);
+    }
+    for (const auto& info : m_problem.getControlInfos()) {
+        setVariableScaling(controls, Slice(), Slice(), info.bounds);
+    }
+    for (const auto& info : m_problem.getMultiplierInfos()) {
+        setVariableScaling(multipliers, Slice(), Slice(), info.bounds);
+    }
+    if (m_problem.isDynamicsModeImplicit()) {
+        setVariableScaling(derivatives, Slice(0, m_problem.getNumSpeeds()),
+                Slice(), m_solver.getImplicitMultibodyAccelerationBounds());
+    }
+    if (m_problem.getNumAuxiliaryResidualEquations()) {
+        setVariableScaling(derivatives,
+                Slice(m_problem.getNumAccelerations(),
+                        m_problem.getNumDerivatives()),
+                Slice(), m_solver.getImplicitAuxiliaryDerivativeBounds());
+    }
+    {
+        int isl = 0;
+        for (const auto& info : m_problem.getSlackInfos()) {
+            setVariableScaling(slacks, isl, Slice(), info.bounds);
+            ++isl;
+        }
+    }
+    for (int ips = 0; ips < m_numProjectionStates; ++ips) {
+        setVariableScaling(projection_states, Slice(), Slice(),
+                m_problem.getStateInfos()[ips].bounds);
+    }
+    {
+        int ip = 0;
+        for (const auto& info : m_problem.getParameterInfos()) {
+            setVariableScaling(parameters, ip, 0, info.bounds);
+            ++ip;
+        }
+    }
+    m_unscaledVars = unscaleVariables(m_scaledVars);
+
+    m_duration = m_unscaledVars[final_time] - m_unscaledVars[initial_time];
+    m_times = createTimes(
+            m_unscaledVars[initial_time], m_unscaledVars[final_time]);
+    m_paramsTrajGrid =
+            MX::repmat(m_unscaledVars[parameters], 1, m_numGridPoints);
+    m_paramsTrajMesh =
+            MX::repmat(m_unscaledVars[parameters], 1, m_numMeshPoints);
+    m_paramsTrajMeshInterior =
+            MX::repmat(m_unscaledVars[parameters], 1, m_numMeshInteriorPoints);
+    m_paramsTrajPathCon =
+            MX::repmat(m_unscaledVars[parameters], 1, m_numPathConstraintPoints);
+    m_paramsTrajProjState =
+            MX::repmat(m_unscaledVars[parameters], 1, m_numMeshIntervals);
+
+    casadi_int istart = 0;
+    int numStates = m_problem.getNumStates();
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        casadi_int numPts = m_numPointsPerMeshInterval;
+        casadi_int iend = istart + numPts - 1;
+        if (m_numProjectionStates) {
+            // The states at all points in the mesh interval except the last
+            // point are the regular state variables.
+            m_statesByMeshInterval[imesh](Slice(), Slice(0, numPts-1)) =
+                    m_unscaledVars[states](Slice(), Slice(istart, iend));
+
+            // The multibody states at the last point in the mesh interval are
+            // the projection states.
+            m_statesByMeshInterval[imesh]
+                    (Slice(0, m_numProjectionStates), numPts-1) =
+                            m_unscaledVars[projection_states](Slice(), imesh);
+
+            // The non-multibody states at the last point (i.e., auxiliary state
+            // variables for muscles) are also the same as the regular state
+            // variables (there are no projection states for these variables).
+            m_statesByMeshInterval[imesh](
+                    Slice(m_numProjectionStates, numStates), numPts-1) =
+                    m_unscaledVars[states](
+                            Slice(m_numProjectionStates, numStates), iend);
+
+            // Calculate the distance between the regular multibody states and
+            // the projection multibody states.
+            m_projectionStateDistances(Slice(), imesh) =
+                m_unscaledVars[projection_states](Slice(), imesh) -
+                m_unscaledVars[states](Slice(0, m_numProjectionStates), iend);
+        } else {
+            m_statesByMeshInterval[imesh](Slice(), Slice()) =
+                    m_unscaledVars[states](Slice(), Slice(istart, iend+1));
+        }
+        istart = iend;
+    }
+}
+
+void Transcription::setVariableBoundsFromProblem() {
+    auto initializeBoundsDM = [&](VariablesDM& bounds) {
+        for (auto& kv : m_scaledVars) {
+            bounds[kv.first] = DM(kv.second.rows(), kv.second.columns());
+        }
+    };
+    initializeBoundsDM(m_lowerBounds);
+    initializeBoundsDM(m_upperBounds);
+
+    setVariableBounds(initial_time, 0, 0, m_problem.getTimeInitialBounds());
+    setVariableBounds(final_time, 0, 0, m_problem.getTimeFinalBounds());
+
     {
         const auto& stateInfos = m_problem.getStateInfos();
         int is = 0;
@@ -251,7 +347,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
             setVariableBounds(states, is, 0, info.initialBounds);
             // The "-1" grabs the last column (last mesh point).
             setVariableBounds(states, is, -1, info.finalBounds);
-            setVariableScaling(states, Slice(), Slice(), info.bounds);
             ++is;
         }
     }
@@ -263,7 +358,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
                     controls, ic, Slice(1, m_numGridPoints - 1), info.bounds);
             setVariableBounds(controls, ic, 0, info.initialBounds);
             setVariableBounds(controls, ic, -1, info.finalBounds);
-            setVariableScaling(controls, Slice(), Slice(), info.bounds);
             ++ic;
         }
     }
@@ -275,7 +369,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
                     info.bounds);
             setVariableBounds(multipliers, im, 0, info.initialBounds);
             setVariableBounds(multipliers, im, -1, info.finalBounds);
-            setVariableScaling(multipliers, Slice(), Slice(), info.bounds);
             ++im;
         }
     }
@@ -285,19 +378,12 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
             // Matlab).
             setVariableBounds(derivatives, Slice(0, m_problem.getNumSpeeds()),
                     Slice(), m_solver.getImplicitMultibodyAccelerationBounds());
-            setVariableScaling(derivatives, Slice(0, m_problem.getNumSpeeds()),
-                    Slice(), m_solver.getImplicitMultibodyAccelerationBounds());
-
         }
         if (m_problem.getNumAuxiliaryResidualEquations()) {
             setVariableBounds(derivatives,
                     Slice(m_problem.getNumAccelerations(),
                             m_problem.getNumDerivatives()),
                     Slice(), m_solver.getImplicitAuxiliaryDerivativeBounds());
-            setVariableScaling(derivatives,
-                    Slice(m_problem.getNumAccelerations(),
-                            m_problem.getNumDerivatives()),
-                    Slice(), m_solver.getImplicitAuxiliaryDerivativeBounds());
         }
     }
     {
@@ -305,7 +391,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
         int isl = 0;
         for (const auto& info : slackInfos) {
             setVariableBounds(slacks, isl, Slice(), info.bounds);
-            setVariableScaling(slacks, isl, Slice(), info.bounds);
             ++isl;
         }
     }
@@ -319,8 +404,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
                     projection_states, ips, Slice(0, m_numMeshIntervals - 1),
                     info.bounds);
             setVariableBounds(projection_states, ips, -1, info.finalBounds);
-            setVariableScaling(projection_states, Slice(), Slice(),
-                               info.bounds);
         }
     }
     {
@@ -328,62 +411,9 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
         int ip = 0;
         for (const auto& info : paramInfos) {
             setVariableBounds(parameters, ip, 0, info.bounds);
-            setVariableScaling(parameters, ip, 0, info.bounds);
             ++ip;
         }
     }
-    m_unscaledVars = unscaleVariables(m_scaledVars);
-
-    m_duration = m_unscaledVars[final_time] - m_unscaledVars[initial_time];
-    m_times = createTimes(
-            m_unscaledVars[initial_time], m_unscaledVars[final_time]);
-    m_paramsTrajGrid =
-            MX::repmat(m_unscaledVars[parameters], 1, m_numGridPoints);
-    m_paramsTrajMesh =
-            MX::repmat(m_unscaledVars[parameters], 1, m_numMeshPoints);
-    m_paramsTrajMeshInterior =
-            MX::repmat(m_unscaledVars[parameters], 1, m_numMeshInteriorPoints);
-    m_paramsTrajPathCon =
-            MX::repmat(m_unscaledVars[parameters], 1, m_numPathConstraintPoints);
-    m_paramsTrajProjState =
-            MX::repmat(m_unscaledVars[parameters], 1, m_numMeshIntervals);
-
-    casadi_int istart = 0;
-    int numStates = m_problem.getNumStates();
-    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
-        casadi_int numPts = m_numPointsPerMeshInterval;
-        casadi_int iend = istart + numPts - 1;
-        if (m_numProjectionStates) {
-            // The states at all points in the mesh interval except the last
-            // point are the regular state variables.
-            m_statesByMeshInterval[imesh](Slice(), Slice(0, numPts-1)) =
-                    m_unscaledVars[states](Slice(), Slice(istart, iend));
-
-            // The multibody states at the last point in the mesh interval are
-            // the projection states.
-            m_statesByMeshInterval[imesh]
-                    (Slice(0, m_numProjectionStates), numPts-1) =
-                            m_unscaledVars[projection_states](Slice(), imesh);
-
-            // The non-multibody states at the last point (i.e., auxiliary state
-            // variables for muscles) are also the same as the regular state
-            // variables (there are no projection states for these variables).
-            m_statesByMeshInterval[imesh](
-                    Slice(m_numProjectionStates, numStates), numPts-1) =
-                    m_unscaledVars[states](
-                            Slice(m_numProjectionStates, numStates), iend);
-
-            // Calculate the distance between the regular multibody states and
-            // the projection multibody states.
-            m_projectionStateDistances(Slice(), imesh) =
-                m_unscaledVars[projection_states](Slice(), imesh) -
-                m_unscaledVars[states](Slice(0, m_numProjectionStates), iend);
-        } else {
-            m_statesByMeshInterval[imesh](Slice(), Slice()) =
-                    m_unscaledVars[states](Slice(), Slice(istart, iend+1));
-        }
-        istart = iend;
-    }
 }
 
 void Transcription::transcribe() {
@@ -930,11 +960,98 @@ void Transcription::setObjectiveAndEndpointConstraints() {
     }
 }
 
+void Transcription::createNlpFunction() {
+    // Option handling is copied from casadi::OptiNode::solver().
+    casadi::Dict options = m_solver.getPluginOptions();
+    if (!options.empty()) {
+        options[m_solver.getOptimSolver()] = m_solver.getSolverOptions();
+    }
+
+    m_nlpVariables = flattenVariables(m_scaledVars);
+    const auto& x = m_nlpVariables;
+    casadi_int numVariables = x.numel();
+
+    // The m_constraints symbolic vector holds all of the expressions for
+    // the constraint functions.
+    m_nlpConstraints = flattenConstraints(m_constraints);
+    const auto& g = m_nlpConstraints;
+    casadi_int numConstraints = g.numel();
+
+    // The callback must outlive the NLP function.
+    m_nlpsolCallback = OpenSim::make_unique<NlpsolCallback>(*this, m_problem,
+            numVariables, numConstraints, m_solver.getCallbackInterval());
+    options["iteration_callback"] = *m_nlpsolCallback;
+
+    // The inputs to nlpsol() are symbolic (casadi::MX).
+    casadi::MXDict nlp;
+    nlp.emplace(std::make_pair("x", x));
+    // The objective symbolic variable holds an expression graph including
+    // all the calculations performed on the variables x.
+    casadi::MX objective = MX::sum1(m_objectiveTerms);
+    if (m_objectiveTerms.numel() == 0) {
+        objective = 0;
+    }
+    nlp.emplace(std::make_pair("f", objective));
+    nlp.emplace(std::make_pair("g", g));
+    if (!m_solver.getWriteSparsity().empty()) {
+        const auto prefix = m_solver.getWriteSparsity();
+        auto gradient = casadi::MX::gradient(nlp["f"], nlp["x"]);
+        gradient.sparsity().to_file(
+                prefix + "_objective_gradient_sparsity.mtx");
+        auto hessian = casadi::MX::hessian(nlp["f"], nlp["x"]);
+        hessian.sparsity().to_file(prefix + "_objective_Hessian_sparsity.mtx");
+        auto lagrangian = objective +
+                          casadi::MX::dot(casadi::MX::ones(nlp["g"].sparsity()),
+                                  nlp["g"]);
+        auto hessian_lagr = casadi::MX::hessian(lagrangian, nlp["x"]);
+        hessian_lagr.sparsity().to_file(
+                prefix + "_Lagrangian_Hessian_sparsity.mtx");
+        auto jacobian = casadi::MX::jacobian(nlp["g"], nlp["x"]);
+        jacobian.sparsity().to_file(
+                prefix + "constraint_Jacobian_sparsity.mtx");
+    }
+    m_nlpFunc = casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+}
+
+void Transcription::updateBounds() {
+    setVariableBoundsFromProblem();
+
+    const auto& kcBounds = m_problem.getKinematicConstraintBounds();
+    auto repmatBounds = [](double value, const casadi::DM& shape) {
+        return casadi::DM::repmat(value, shape.rows(), shape.columns());
+    };
+    m_constraintsLowerBounds.kinematic =
+            repmatBounds(kcBounds.lower, m_constraintsLowerBounds.kinematic);
+    m_constraintsUpperBounds.kinematic =
+            repmatBounds(kcBounds.upper, m_constraintsUpperBounds.kinematic);
+    m_constraintsLowerBounds.kinematic_udoterr = repmatBounds(
+            kcBounds.lower, m_constraintsLowerBounds.kinematic_udoterr);
+    m_constraintsUpperBounds.kinematic_udoterr = repmatBounds(
+            kcBounds.upper, m_constraintsUpperBounds.kinematic_udoterr);
+
+    for (int ipc = 0; ipc < (int)m_constraints.path.size(); ++ipc) {
+        const auto& info = m_problem.getPathConstraintInfos()[ipc];
+        m_constraintsLowerBounds.path[ipc] = casadi::DM::repmat(
+                info.lowerBounds, 1, m_numPathConstraintPoints);
+        m_constraintsUpperBounds.path[ipc] = casadi::DM::repmat(
+                info.upperBounds, 1, m_numPathConstraintPoints);
+    }
+    for (int iec = 0; iec < (int)m_constraints.endpoint.size(); ++iec) {
+        const auto& info = m_problem.getEndpointConstraintInfos()[iec];
+        m_constraintsLowerBounds.endpoint[iec] = info.lowerBounds;
+        m_constraintsUpperBounds.endpoint[iec] = info.upperBounds;
+    }
+}
+
 Solution Transcription::solve(const Iterate& guessOrig) {
 
     // Define the NLP.
     // ---------------
-    transcribe();
+    // The NLP is defined during the first call only; later calls reuse it.
+    if (m_nlpFunc.is_null()) {
+        transcribe();
+        createNlpFunction();
+    }
 
     // Resample the guess.
     // -------------------
@@ -1017,61 +1134,10 @@ Solution Transcription::solve(const Iterate& guessOrig) {
                 m_numMeshIntervals, projection_states.size2());
     }
 
-    // Create the CasADi NLP function.
-    // -------------------------------
-    // Option handling is copied from casadi::OptiNode::solver().
-    casadi::Dict options = m_solver.getPluginOptions();
-    if (!options.empty()) {
-        options[m_solver.getOptimSolver()] = m_solver.getSolverOptions();
-    }
-
-    auto x = flattenVariables(m_scaledVars);
-    casadi_int numVariables = x.numel();
-
-    // The m_constraints symbolic vector holds all of the expressions for
-    // the constraint functions.
-    auto g = flattenConstraints(m_constraints);
-    casadi_int numConstraints = g.numel();
-
-    NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
-            m_solver.getCallbackInterval());
-    options["iteration_callback"] = callback;
-
-    // The inputs to nlpsol() are symbolic (casadi::MX).
-    casadi::MXDict nlp;
-    nlp.emplace(std::make_pair("x", x));
-    // The objective symbolic variable holds an expression graph including
-    // all the calculations performed on the variables x.
-    casadi::MX objective = MX::sum1(m_objectiveTerms);
-    if (m_objectiveTerms.numel() == 0) {
-        objective = 0;
-    }
-    nlp.emplace(std::make_pair("f", objective));
-    nlp.emplace(std::make_pair("g", g));
-    if (!m_solver.getWriteSparsity().empty()) {
-        const auto prefix = m_solver.getWriteSparsity();
-        auto gradient = casadi::MX::gradient(nlp["f"], nlp["x"]);
-        gradient.sparsity().to_file(
-                prefix + "_objective_gradient_sparsity.mtx");
-        auto hessian = casadi::MX::hessian(nlp["f"], nlp["x"]);
-        hessian.sparsity().to_file(prefix + "_objective_Hessian_sparsity.mtx");
-        auto lagrangian = objective +
-                          casadi::MX::dot(casadi::MX::ones(nlp["g"].sparsity()),
-                                  nlp["g"]);
-        auto hessian_lagr = casadi::MX::hessian(lagrangian, nlp["x"]);
-        hessian_lagr.sparsity().to_file(
-                prefix + "_Lagrangian_Hessian_sparsity.mtx");
-        auto jacobian = casadi::MX::jacobian(nlp["g"], nlp["x"]);
-        jacobian.sparsity().to_file(
-                prefix + "constraint_Jacobian_sparsity.mtx");
-    }
-    const casadi::Function nlpFunc =
-            casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
-
     // Run the optimization (evaluate the CasADi NLP function).
     // --------------------------------------------------------
     // The inputs and outputs of nlpFunc are numeric (casadi::DM).
-    const casadi::DMDict nlpResult = nlpFunc(casadi::DMDict{
+    const casadi::DMDict nlpResult = m_nlpFunc(casadi::DMDict{
                     {"x0", flattenVariables(scaleVariables(guess.variables))},
                     {"lbx", flattenVariables(scaleVariables(m_lowerBounds))},
                     {"ubx", flattenVariables(scaleVariables(m_upperBounds))},
@@ -1086,14 +1152,15 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     solution.objective = nlpResult.at("f").scalar();
 
     casadi::DMVector finalVarsDMV{finalVariables};
-    casadi::Function objectiveFunc("objective", {x}, {m_objectiveTerms});
+    casadi::Function objectiveFunc(
+            "objective", {m_nlpVariables}, {m_objectiveTerms});
     casadi::DMVector objectiveOut;
     objectiveFunc.call(finalVarsDMV, objectiveOut);
     solution.objective_breakdown = expandObjectiveTerms(objectiveOut[0]);
 
     solution.times = createTimes(
             solution.variables[initial_time], solution.variables[final_time]);
-    solution.stats = nlpFunc.stats();
+    solution.stats = m_nlpFunc.stats();
 
     // Print breakdown of objective.
     printObjectiveBreakdown(solution, objectiveOut[0]);
@@ -1102,7 +1169,8 @@ Solution Transcription::solve(const Iterate& guessOrig) {
 
         // For some reason, nlpResult.at("g") is all 0. So we calculate the
         // constraints ourselves.
-        casadi::Function constraintFunc("constraints", {x}, {g});
+        casadi::Function constraintFunc(
+                "constraints", {m_nlpVariables}, {m_nlpConstraints});
         casadi::DMVector constraintsOut;
         constraintFunc.call(finalVarsDMV, constraintsOut);
         printConstraintValues(solution, expandConstraints(constraintsOut[0]));
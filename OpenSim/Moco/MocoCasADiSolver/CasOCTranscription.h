@@ -62,7 +62,12 @@ public:
         return meshIndices;
     }
 
+    /// The NLP is created during the first call and is reused by later calls.
     Solution solve(const Iterate& guessOrig);
+    /// Update the bounds on the variables and constraints of the NLP from the
+    /// bounds in the problem (see Problem::updateBoundsFrom()). The bounds
+    /// take effect in the next call to solve().
+    void updateBounds();
 
 protected:
     /// This must be called in the constructor of derived classes so that
@@ -203,6 +208,13 @@ private:
     Constraints<casadi::DM> m_constraintsLowerBounds;
     Constraints<casadi::DM> m_constraintsUpperBounds;
 
+    // The NLP, created during the first call to solve(). The callback is
+    // declared first so that it outlives the NLP function.
+    std::unique_ptr<casadi::Callback> m_nlpsolCallback;
+    casadi::MX m_nlpVariables;
+    casadi::MX m_nlpConstraints;
+    casadi::Function m_nlpFunc;
+
 private:
     /// Override this function in your derived class to compute a vector of
     /// quadrature coeffecients (of length m_numGridPoints) required to set the
@@ -223,7 +235,9 @@ private:
                 "Must provide constraints for interpolating controls.")
     }
 
+    void setVariableBoundsFromProblem();
     void transcribe();
+    void createNlpFunction();
     void setObjectiveAndEndpointConstraints();
     void calcDefects() {
         calcDefectsImpl(m_statesByMeshInterval,
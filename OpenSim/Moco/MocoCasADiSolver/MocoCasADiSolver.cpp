@@ -28,6 +28,8 @@
 
     #include <OpenSim/Common/Stopwatch.h>
 
+    #include <algorithm>
+
     using casadi::Callback;
     using casadi::Dict;
     using casadi::DM;
@@ -38,6 +40,104 @@
 
 using namespace OpenSim;
 
+#ifdef OPENSIM_WITH_CASADI
+namespace {
+/// Estimate the error of the solution in each interval of the mesh, as
+/// described in the MocoCasADiSolver documentation. The functions of the
+/// problem must have been initialized by solving the problem.
+std::vector<double> estimateMeshIntervalErrors(const CasOC::Problem& problem,
+        const CasOC::Solution& solution, const std::vector<double>& mesh) {
+    const int NQ = problem.getNumCoordinates();
+    const int NU = problem.getNumSpeeds();
+    const int NS = problem.getNumStates();
+    const bool implicit = problem.isDynamicsModeImplicit();
+    const casadi::Function& multibodySystem =
+            implicit ? problem.getImplicitMultibodySystemIgnoringConstraints()
+                     : problem.getMultibodySystemIgnoringConstraints();
+
+    const DM& states = solution.variables.at(CasOC::states);
+    const DM& controls = solution.variables.at(CasOC::controls);
+    const DM& multipliers = solution.variables.at(CasOC::multipliers);
+    const DM& derivatives = solution.variables.at(CasOC::derivatives);
+    const DM& parameters = solution.variables.at(CasOC::parameters);
+    const auto times = static_cast<std::vector<double>>(solution.times);
+    const int numTimes = (int)times.size();
+
+    // qdot = u; udot is either computed by the multibody system (explicit
+    // mode) or is a variable (implicit mode).
+    auto calcStateDerivatives = [&](double time, const DM& x, const DM& c,
+                                        const DM& lambda, const DM& w) {
+        const casadi::DMVector out = multibodySystem(
+                casadi::DMVector{DM(time), x, c, lambda, w, parameters});
+        DM xdot = DM::zeros(NS, 1);
+        xdot(Slice(0, NQ)) = x(Slice(NQ, NQ + NU));
+        xdot(Slice(NQ, NQ + NU)) = implicit ? DM(w(Slice(0, NU))) : out.at(0);
+        xdot(Slice(NQ + NU, NS)) = out.at(1);
+        return xdot;
+    };
+
+    std::vector<DM> xdot(numTimes);
+    std::vector<double> scale(NS, 1.0);
+    for (int itime = 0; itime < numTimes; ++itime) {
+        xdot[itime] = calcStateDerivatives(times[itime],
+                states(Slice(), itime), controls(Slice(), itime),
+                multipliers(Slice(), itime), derivatives(Slice(), itime));
+        for (int is = 0; is < NS; ++is) {
+            scale[is] = std::max(scale[is],
+                    1.0 + std::abs(states(is, itime).scalar()));
+        }
+    }
+
+    const double initialTime = times.front();
+    const double duration = times.back() - initialTime;
+    const int numMeshIntervals = (int)mesh.size() - 1;
+    std::vector<double> errors(numMeshIntervals, 0.0);
+    for (int itime = 0; itime < numTimes - 1; ++itime) {
+        const double h = times[itime + 1] - times[itime];
+        if (h <= 0) continue;
+        const DM x0 = states(Slice(), itime);
+        const DM x1 = states(Slice(), itime + 1);
+        const DM& xdot0 = xdot[itime];
+        const DM& xdot1 = xdot[itime + 1];
+        // The cubic Hermite interpolant of the states and its derivative at
+        // the middle of the segment.
+        const DM xmid = 0.5 * (x0 + x1) + h / 8.0 * (xdot0 - xdot1);
+        const DM xdotmid = 1.5 / h * (x1 - x0) - 0.25 * (xdot0 + xdot1);
+        auto interpolate = [&](const DM& var) -> DM {
+            return 0.5 * (var(Slice(), itime) + var(Slice(), itime + 1));
+        };
+        const double tmid = times[itime] + 0.5 * h;
+        const DM xdotModel = calcStateDerivatives(tmid, xmid,
+                interpolate(controls), interpolate(multipliers),
+                interpolate(derivatives));
+
+        const double tau = (tmid - initialTime) / duration;
+        int imesh = (int)(std::upper_bound(mesh.begin(), mesh.end(), tau) -
+                          mesh.begin()) - 1;
+        imesh = std::min(std::max(imesh, 0), numMeshIntervals - 1);
+        for (int is = 0; is < NS; ++is) {
+            const double error = h *
+                    std::abs(xdotmid(is).scalar() - xdotModel(is).scalar()) /
+                    scale[is];
+            errors[imesh] = std::max(errors[imesh], error);
+        }
+    }
+    return errors;
+}
+
+/// Whether the properties of the two solvers, other than guess_file, are
+/// equal.
+bool haveSameSettings(const MocoCasADiSolver& a, const MocoCasADiSolver& b) {
+    for (int i = 0; i < a.getNumProperties(); ++i) {
+        const auto& property = a.getPropertyByIndex(i);
+        if (property.getName() == "guess_file") continue;
+        if (!(property == b.getPropertyByIndex(i))) return false;
+    }
+    return true;
+}
+} // anonymous namespace
+#endif
+
 MocoCasADiSolver::MocoCasADiSolver() { constructProperties(); }
 
 void MocoCasADiSolver::constructProperties() {
@@ -58,6 +158,12 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_minimize_state_projection_distance(true);
     constructProperty_state_projection_distance_weight(1e-6);
     constructProperty_projection_slack_variable_bounds({-1e-3, 1e-3});
+
+    constructProperty_mesh_refinement_max_iterations(0);
+    constructProperty_mesh_refinement_tolerance(1e-3);
+    constructProperty_mesh_refinement_max_mesh_intervals(1000);
+
+    constructProperty_reuse_transcription(false);
 }
 
 bool MocoCasADiSolver::isAvailable() {
@@ -243,6 +349,15 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
                 "point must be one.");
     }
 
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_mesh_refinement_max_iterations(), 0,
+            std::numeric_limits<int>::max(), {});
+    checkPropertyValueIsInRangeOrSet(getProperty_mesh_refinement_tolerance(),
+            0.0, SimTK::NTraits<double>::getInfinity(), {});
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_mesh_refinement_max_mesh_intervals(), 1,
+            std::numeric_limits<int>::max(), {});
+
     checkPropertyValueIsInRangeOrSet(getProperty_optim_max_iterations(), 0,
             std::numeric_limits<int>::max(), {-1});
     checkPropertyValueIsInRangeOrSet(getProperty_optim_convergence_tolerance(),
@@ -365,8 +480,46 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         log_info(std::string(72, '-'));
         getProblemRep().printDescription();
     }
-    auto casProblem = createCasOCProblem();
-    auto casSolver = createCasOCSolver(*casProblem);
+    std::shared_ptr<MocoCasOCProblem> casProblem = createCasOCProblem();
+    std::shared_ptr<CasOC::Solver> casSolver;
+    if (get_reuse_transcription()) {
+        OPENSIM_THROW_IF_FRMOBJ(get_mesh_refinement_max_iterations() > 0,
+                Exception,
+                "Cannot reuse the transcription with mesh refinement; set "
+                "reuse_transcription or mesh_refinement_max_iterations to 0.");
+        if (m_reusableCasSolver &&
+                haveSameSettings(*this, *m_reusableSettings) &&
+                m_reusableCasProblem->updateFrom(*casProblem)) {
+            casProblem = m_reusableCasProblem;
+            casSolver = m_reusableCasSolver;
+            if (get_verbosity()) {
+                log_info("Reusing the transcription from the previous solve.");
+            }
+        } else {
+            if (m_reusableCasSolver && get_verbosity()) {
+                log_info("Cannot reuse the transcription from the previous "
+                         "solve, since the problem or the solver settings "
+                         "changed; transcribing the problem again.");
+            }
+            // Discard the previous transcription, including the sparsity
+            // patterns detected for the previous problem, before creating
+            // the new one.
+            m_reusableCasSolver.reset();
+            m_reusableCasProblem.reset();
+            m_reusableSettings.reset();
+            casSolver = createCasOCSolver(*casProblem);
+            casSolver->setReuseTranscription(true);
+            // The previous solver refers to the previous problem.
+            m_reusableCasSolver = casSolver;
+            m_reusableCasProblem = casProblem;
+            m_reusableSettings = std::shared_ptr<MocoCasADiSolver>(clone());
+        }
+    } else {
+        casSolver = createCasOCSolver(*casProblem);
+        m_reusableCasSolver.reset();
+        m_reusableCasProblem.reset();
+        m_reusableSettings.reset();
+    }
     if (get_verbosity()) {
         log_info("Number of threads: {}", casProblem->getJarSize());
     }
@@ -374,17 +527,17 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     std::vector<int> inputControlIndexes =
             getProblemRep().getInputControlIndexes();
     MocoTrajectory guess = getGuess();
+    std::vector<std::string> expectedSlackNames;
+    for (const auto& info : casProblem->getSlackInfos()) {
+        expectedSlackNames.push_back(info.name);
+    }
+    // We do not need to append projection states to the guess since they will
+    // be appended later when the guess is resampled by the solver (if needed).
+    const bool appendProjectionStates = false;
     CasOC::Iterate casGuess;
     if (guess.empty()) {
         casGuess = casSolver->createInitialGuessFromBounds();
     } else {
-        std::vector<std::string> expectedSlackNames;
-        for (const auto& info : casProblem->getSlackInfos()) {
-            expectedSlackNames.push_back(info.name);
-        }
-        // We do not need to append projection states here since they will be
-        // appended later when the guess is resampled by the solver (if needed).
-        bool appendProjectionStates = false;
         casGuess = convertToCasOCIterate(guess, expectedSlackNames,
                 appendProjectionStates, inputControlIndexes);
     }
@@ -393,22 +546,124 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     // log isn't flooded while computing finite differences.
     Logger::Level origLoggerLevel = Logger::getLevel();
     Logger::setLevel(Logger::Level::Warn);
-    CasOC::Solution casSolution;
-    try {
-        casSolution = casSolver->solve(casGuess);
-    } catch(const Exception& ex) {
-        OPENSIM_THROW_FRMOBJ(Exception,
-            fmt::format("MocoCasADiSolver failed internally with message: {}",
-                ex.getMessage()));
-    } catch(const casadi::CasadiException& ex) {
-        OPENSIM_THROW_FRMOBJ(Exception,
-            fmt::format("MocoCasADiSolver failed internally with message: {}",
-                ex.what()));
-    } catch (...) {
-        OPENSIM_THROW_FRMOBJ(Exception, "MocoCasADiSolver failed internally.");
+    auto solveOnMesh = [&](const CasOC::Iterate& iterate) {
+        try {
+            return casSolver->solve(iterate);
+        } catch(const Exception& ex) {
+            OPENSIM_THROW_FRMOBJ(Exception,
+                fmt::format("MocoCasADiSolver failed internally with message: "
+                            "{}", ex.getMessage()));
+        } catch(const casadi::CasadiException& ex) {
+            OPENSIM_THROW_FRMOBJ(Exception,
+                fmt::format("MocoCasADiSolver failed internally with message: "
+                            "{}", ex.what()));
+        } catch (...) {
+            OPENSIM_THROW_FRMOBJ(Exception,
+                    "MocoCasADiSolver failed internally.");
+        }
+    };
+    Stopwatch solveStopwatch;
+    CasOC::Solution casSolution = solveOnMesh(casGuess);
+
+    // Mesh refinement.
+    // ----------------
+    struct MeshRefinementIteration {
+        int numMeshIntervals;
+        double maxError;
+        long long solveTime;
+    };
+    std::vector<MeshRefinementIteration> meshRefinementIterations;
+    std::vector<double> mesh = casSolver->getMesh();
+    meshRefinementIterations.push_back({(int)mesh.size() - 1, SimTK::NaN,
+            solveStopwatch.getElapsedTimeInNs()});
+    const int maxRefinements = get_mesh_refinement_max_iterations();
+    const double tolerance = get_mesh_refinement_tolerance();
+    for (int irefine = 0; maxRefinements > 0; ++irefine) {
+        const bool success = casSolution.stats.at("success");
+        if (!success) break;
+
+        const std::vector<double> errors =
+                estimateMeshIntervalErrors(*casProblem, casSolution, mesh);
+        meshRefinementIterations.back().maxError =
+                *std::max_element(errors.begin(), errors.end());
+        if (meshRefinementIterations.back().maxError <= tolerance) break;
+        if (irefine == maxRefinements) {
+            log_warn("Mesh refinement reached the maximum number of "
+                     "iterations ({}) before meeting the tolerance ({}).",
+                    maxRefinements, tolerance);
+            break;
+        }
+
+        // Split the intervals whose error is too large.
+        std::vector<double> refinedMesh{mesh.front()};
+        for (int imesh = 0; imesh < (int)errors.size(); ++imesh) {
+            if (errors[imesh] > tolerance) {
+                refinedMesh.push_back(0.5 * (mesh[imesh] + mesh[imesh + 1]));
+            }
+            refinedMesh.push_back(mesh[imesh + 1]);
+        }
+        if ((int)refinedMesh.size() - 1 >
+                get_mesh_refinement_max_mesh_intervals()) {
+            log_warn("Mesh refinement stopped before meeting the tolerance "
+                     "({}), since the refined mesh would have more than {} "
+                     "mesh intervals.",
+                    tolerance, get_mesh_refinement_max_mesh_intervals());
+            break;
+        }
+        casSolver->setMesh(refinedMesh);
+
+        // Start from the solution on the previous mesh; the solver
+        // interpolates it onto the refined mesh.
+        casGuess = convertToCasOCIterate(
+                convertToMocoTrajectory(casSolution, inputControlIndexes),
+                expectedSlackNames, appendProjectionStates,
+                inputControlIndexes);
+        solveStopwatch.reset();
+        CasOC::Solution refinedSolution;
+        std::string failure;
+        try {
+            refinedSolution = solveOnMesh(casGuess);
+            if (!(bool)refinedSolution.stats.at("success")) {
+                const std::string status =
+                        refinedSolution.stats.at("return_status");
+                failure = fmt::format("failed with status '{}'", status);
+            }
+        } catch (const Exception& ex) {
+            failure = fmt::format("threw an exception ({})", ex.getMessage());
+        }
+        meshRefinementIterations.push_back(
+                {(int)refinedMesh.size() - 1, SimTK::NaN,
+                        solveStopwatch.getElapsedTimeInNs()});
+
+        // If the solve on the refined mesh failed, keep the solution on the
+        // previous mesh, which succeeded.
+        if (!failure.empty()) {
+            log_warn("Mesh refinement stopped since the solve on the refined "
+                     "mesh ({} mesh intervals) {}; returning the solution on "
+                     "the previous mesh ({} mesh intervals).",
+                    (int)refinedMesh.size() - 1, failure,
+                    (int)mesh.size() - 1);
+            casSolver->setMesh(mesh);
+            break;
+        }
+        mesh = refinedMesh;
+        casSolution = std::move(refinedSolution);
     }
     OpenSim::Logger::setLevel(origLoggerLevel);
 
+    if (get_verbosity() && maxRefinements > 0) {
+        log_info(std::string(72, '-'));
+        log_info("Mesh refinement:");
+        log_info("{:>9} {:>14} {:>12} {:>14}", "iteration", "mesh intervals",
+                "max error", "solve time");
+        for (int i = 0; i < (int)meshRefinementIterations.size(); ++i) {
+            const auto& iteration = meshRefinementIterations[i];
+            log_info("{:>9} {:>14} {:>12.3e} {:>14}", i,
+                    iteration.numMeshIntervals, iteration.maxError,
+                    solveStopwatch.formatNs(iteration.solveTime));
+        }
+    }
+
     MocoSolution mocoSolution = convertToMocoTrajectory<MocoSolution>(
             casSolution, inputControlIndexes);
 
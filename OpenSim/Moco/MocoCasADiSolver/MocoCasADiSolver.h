@@ -99,6 +99,49 @@ not affect the solution. We encourage you to use the environment variable
 instead, as this allows different users to solve the same problem with the
 parallelization they prefer.
 
+Mesh refinement
+===============
+Resolving fast events (e.g., impacts or rapid changes in activation) with a
+uniform mesh requires many mesh intervals everywhere, even where the
+trajectory is smooth. Instead, you can ask the solver to refine the mesh
+where it is needed by setting mesh_refinement_max_iterations to a positive
+number. The problem is first solved on the mesh given by num_mesh_intervals
+(or setMesh()). Then, the solver estimates the error of the solution in each
+mesh interval: between each pair of adjacent grid points, the states are
+interpolated with a cubic Hermite polynomial, and the state derivative
+computed from the model at the middle of these two points is compared to the
+derivative of the polynomial. The difference, multiplied by the time between
+the points and divided by (1 + the largest magnitude of the state over the
+trajectory), is the error. Mesh intervals whose largest error exceeds
+mesh_refinement_tolerance are split in half, and the problem is solved
+again on the new mesh, using the previous solution as the initial guess. The
+solver stops refining once the errors of all mesh intervals are within the
+tolerance, after mesh_refinement_max_iterations refinements, if a solve
+fails, or if the new mesh would have more than
+mesh_refinement_max_mesh_intervals intervals. The size of the mesh, the
+largest error, and the duration of each solve are printed after solving.
+The returned solution is the solution on the last mesh. If the solve on a
+refined mesh fails (or throws an exception), the solver instead returns the
+solution on the previous mesh, and prints a warning.
+
+Solving a problem repeatedly
+============================
+Before solving, the solver transcribes the MocoProblem into a nonlinear
+program (NLP): it builds the expression graph of the NLP, detects the sparsity
+of its derivatives, and creates the NLP solver. For large problems, this can
+take a substantial fraction of the solution time. If you solve the same
+problem many times with different data, weights or bounds (e.g., tracking
+different trials with the same model in MocoTrack), set reuse_transcription
+to true and solve with the same MocoStudy. The first solve keeps the
+transcription, and the next solves use it again, as long as the problem has
+the same variables, goals and constraints, and the properties of the solver
+(other than guess_file) are unchanged; otherwise, the problem is transcribed
+again. When the transcription is reused, the solver evaluates the model,
+goals and constraints of the new problem, and uses its bounds, but the
+scaling of the variables (scale_variables_using_bounds) is the one computed
+from the bounds of the first problem. Reusing the transcription cannot be
+combined with mesh refinement.
+
 Parameter variables
 ===================
 By default, MocoCasADiSolver is much slower than MocoTroperSolver at
@@ -193,6 +236,23 @@ public:
             "mesh interval when using the 'Bordalba2023' method for "
             "enforcing kinematic constraints. Default: [-1e-3, 1e-3].");
 
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "The maximum number of times to refine the mesh and solve the "
+            "problem again after the first solve. "
+            "Default: 0 (no mesh refinement).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "Mesh intervals whose estimated error is larger than this "
+            "tolerance are split during mesh refinement. Default: 1e-3.");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_mesh_intervals, int,
+            "Stop refining the mesh if the refined mesh would have more "
+            "than this number of mesh intervals. Default: 1000.");
+
+    OpenSim_DECLARE_PROPERTY(reuse_transcription, bool,
+            "Keep the transcription of the problem (including the NLP solver) "
+            "after solving, and reuse it in the next solve if the problem has "
+            "the same variables, goals and constraints and the solver "
+            "settings are unchanged. Default: false.");
+
     MocoCasADiSolver();
 
     /// Returns true if Moco was compiled with the CasADi library; returns false
@@ -261,6 +321,15 @@ private:
     MocoTrajectory m_guessFromAPI;
     mutable SimTK::ResetOnCopy<MocoTrajectory> m_guessFromFile;
     mutable SimTK::ReferencePtr<const MocoTrajectory> m_guessToUse;
+
+    // The transcription kept for the next solve if reuse_transcription is
+    // true, and a copy of the solver settings used to create it.
+    mutable SimTK::ResetOnCopy<std::shared_ptr<MocoCasOCProblem>>
+            m_reusableCasProblem;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<CasOC::Solver>>
+            m_reusableCasSolver;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<MocoCasADiSolver>>
+            m_reusableSettings;
 };
 
 } // namespace OpenSim
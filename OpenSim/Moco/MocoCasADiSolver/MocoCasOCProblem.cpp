@@ -285,3 +285,18 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
             fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
                     problemRep.getName(), m_formattedTimeString));
 }
+
+bool MocoCasOCProblem::updateFrom(MocoCasOCProblem& other) {
+    if (other.getJarSize() != getJarSize() ||
+            other.m_yIndexMap != m_yIndexMap ||
+            other.m_paramsRequireInitSystem != m_paramsRequireInitSystem ||
+            other.m_uerrOffset != m_uerrOffset ||
+            other.m_uerrSize != m_uerrSize ||
+            other.m_udoterrOffset != m_udoterrOffset ||
+            other.m_udoterrSize != m_udoterrSize) {
+        return false;
+    }
+    if (!updateBoundsFrom(other)) return false;
+    m_jar = std::move(other.m_jar);
+    return true;
+}
@@ -313,6 +313,13 @@ public:
 
     int getJarSize() const { return (int)m_jar->size(); }
 
+    /// Take the MocoProblemRep%s and the bounds of another MocoCasOCProblem,
+    /// created from the same (possibly modified) MocoProblem, so that a
+    /// transcription of this problem solves the other problem. The other
+    /// problem must have the same variables, goals and constraints; if it
+    /// does not, this returns false and neither problem is modified.
+    bool updateFrom(MocoCasOCProblem& other);
+
 private:
     void calcMultibodySystemExplicit(const ContinuousInput& input,
             bool calcKCErrors,
@@ -888,10 +895,10 @@ private:
     static thread_local SimTK::Vector m_pvaerr;
     // These offsets are necessary when not enforcing the derivatives of the
     // kinematic constraint equations.
-    int m_uerrOffset;
-    int m_uerrSize;
-    int m_udoterrOffset;
-    int m_udoterrSize;
+    int m_uerrOffset = 0;
+    int m_uerrSize = 0;
+    int m_udoterrOffset = 0;
+    int m_udoterrSize = 0;
 };
 
 } // namespace OpenSim
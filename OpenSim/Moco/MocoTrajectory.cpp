@@ -23,10 +23,124 @@
 #include <OpenSim/Common/Assertion.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
 using namespace OpenSim;
 
+namespace {
+// Binary format of MocoTrajectory::write() (native byte order):
+//   magic (8 bytes), byte order mark (uint32), version (uint32),
+//   number of times (uint64), then for each of the states, controls,
+//   input controls, multipliers, derivatives, slacks and parameters, the
+//   number of names (uint64) followed by the length (uint64) and characters
+//   of each name, then the times, the columns of each matrix (time-major
+//   within a column), and the parameters as doubles.
+const char binaryMagic[8] = {'M', 'O', 'C', 'O', 'T', 'R', 'J', '\0'};
+constexpr std::uint32_t binaryByteOrderMark = 0x01020304;
+constexpr std::uint32_t binaryVersion = 1;
+
+bool hasBinaryExtension(const std::string& filepath) {
+    const std::string extension = ".mocotraj";
+    return filepath.size() >= extension.size() &&
+           IO::Lowercase(filepath.substr(filepath.size() -
+                   extension.size())) == extension;
+}
+
+bool isBinaryFile(const std::string& filepath) {
+    std::ifstream in(filepath, std::ios::binary);
+    char magic[sizeof(binaryMagic)];
+    return in.read(magic, sizeof(magic)) &&
+           std::memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(std::istream& in, const std::string& filepath) {
+    T value;
+    OPENSIM_THROW_IF(!in.read(reinterpret_cast<char*>(&value), sizeof(T)),
+            Exception, "Unexpected end of file '{}'.", filepath);
+    return value;
+}
+
+// Number of bytes between the read position and the end of the file.
+std::uint64_t getRemainingBytes(std::istream& in) {
+    const auto position = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto end = in.tellg();
+    in.seekg(position);
+    return end > position ? (std::uint64_t)(end - position) : 0;
+}
+
+// Read the number of items that follow, each taking at least itemSize bytes,
+// so that a corrupt count cannot cause a huge allocation.
+size_t readCount(std::istream& in, const std::string& filepath,
+        std::uint64_t itemSize) {
+    const auto count = readValue<std::uint64_t>(in, filepath);
+    OPENSIM_THROW_IF(count > getRemainingBytes(in) / itemSize, Exception,
+            "File '{}' is corrupt: a count of {} exceeds the size of the "
+            "file.", filepath, count);
+    return (size_t)count;
+}
+
+void writeNames(std::ostream& out, const std::vector<std::string>& names) {
+    writeValue<std::uint64_t>(out, names.size());
+    for (const auto& name : names) {
+        writeValue<std::uint64_t>(out, name.size());
+        out.write(name.data(), name.size());
+    }
+}
+
+std::vector<std::string> readNames(
+        std::istream& in, const std::string& filepath) {
+    // Each name has at least its length.
+    std::vector<std::string> names(
+            readCount(in, filepath, sizeof(std::uint64_t)));
+    for (auto& name : names) {
+        name.resize(readCount(in, filepath, 1));
+        OPENSIM_THROW_IF(!in.read(&name[0], name.size()), Exception,
+                "Unexpected end of file '{}'.", filepath);
+    }
+    return names;
+}
+
+void writeMatrix(std::ostream& out, const SimTK::Matrix& matrix) {
+    std::vector<double> column(matrix.nrow());
+    for (int icol = 0; icol < matrix.ncol(); ++icol) {
+        for (int irow = 0; irow < matrix.nrow(); ++irow) {
+            column[irow] = matrix(irow, icol);
+        }
+        out.write(reinterpret_cast<const char*>(column.data()),
+                column.size() * sizeof(double));
+    }
+}
+
+void readMatrix(std::istream& in, const std::string& filepath, int nrow,
+        int ncol, SimTK::Matrix& matrix) {
+    OPENSIM_THROW_IF((std::uint64_t)nrow * (std::uint64_t)ncol >
+                    getRemainingBytes(in) / sizeof(double),
+            Exception, "Unexpected end of file '{}'.", filepath);
+    matrix.resize(nrow, ncol);
+    std::vector<double> column(nrow);
+    for (int icol = 0; icol < ncol; ++icol) {
+        OPENSIM_THROW_IF(!in.read(reinterpret_cast<char*>(column.data()),
+                                 column.size() * sizeof(double)),
+                Exception, "Unexpected end of file '{}'.", filepath);
+        for (int irow = 0; irow < nrow; ++irow) {
+            matrix(irow, icol) = column[irow];
+        }
+    }
+}
+} // anonymous namespace
+
 const std::vector<std::string> MocoTrajectory::m_allowedKeys =
         {"states", "controls", "input_controls", "multipliers", "derivatives"};
 
@@ -935,6 +1049,10 @@ void MocoTrajectory::resample(SimTK::Vector time) {
 }
 
 MocoTrajectory::MocoTrajectory(const std::string& filepath) {
+    if (isBinaryFile(filepath)) {
+        readBinary(filepath);
+        return;
+    }
     TimeSeriesTable table(filepath);
     const auto& metadata = table.getTableMetaData();
     // TODO: bug with file adapters.
@@ -1077,9 +1195,80 @@ MocoTrajectory::MocoTrajectory(const std::string& filepath) {
 
 void MocoTrajectory::write(const std::string& filepath) const {
     ensureUnsealed();
+    if (hasBinaryExtension(filepath)) {
+        writeBinary(filepath);
+        return;
+    }
     STOFileAdapter::write(convertToTable(), filepath);
 }
 
+void MocoTrajectory::writeBinary(const std::string& filepath) const {
+    std::ofstream out(filepath, std::ios::binary);
+    OPENSIM_THROW_IF(!out, Exception, "Could not open file '{}'.", filepath);
+    out.write(binaryMagic, sizeof(binaryMagic));
+    writeValue(out, binaryByteOrderMark);
+    writeValue(out, binaryVersion);
+    writeValue<std::uint64_t>(out, m_time.size());
+    for (const auto* names : {&m_state_names, &m_control_names,
+                 &m_input_control_names, &m_multiplier_names,
+                 &m_derivative_names, &m_slack_names, &m_parameter_names}) {
+        writeNames(out, *names);
+    }
+    if (m_time.size()) {
+        out.write(reinterpret_cast<const char*>(&m_time[0]),
+                m_time.size() * sizeof(double));
+    }
+    for (const auto* matrix : {&m_states, &m_controls, &m_input_controls,
+                 &m_multipliers, &m_derivatives, &m_slacks}) {
+        writeMatrix(out, *matrix);
+    }
+    for (int i = 0; i < (int)m_parameter_names.size(); ++i) {
+        writeValue(out, m_parameters[i]);
+    }
+    OPENSIM_THROW_IF(!out, Exception, "Could not write file '{}'.", filepath);
+}
+
+void MocoTrajectory::readBinary(const std::string& filepath) {
+    std::ifstream in(filepath, std::ios::binary);
+    OPENSIM_THROW_IF(!in, Exception, "Could not open file '{}'.", filepath);
+    in.ignore(sizeof(binaryMagic));
+    OPENSIM_THROW_IF(
+            readValue<std::uint32_t>(in, filepath) != binaryByteOrderMark,
+            Exception,
+            "File '{}' was written on a machine with a different byte order.",
+            filepath);
+    const auto version = readValue<std::uint32_t>(in, filepath);
+    OPENSIM_THROW_IF(version != binaryVersion, Exception,
+            "Expected version {} of the binary format in file '{}', but got "
+            "version {}.", binaryVersion, filepath, version);
+    const int numTimes = (int)readCount(in, filepath, sizeof(double));
+    for (auto* names : {&m_state_names, &m_control_names,
+                 &m_input_control_names, &m_multiplier_names,
+                 &m_derivative_names, &m_slack_names, &m_parameter_names}) {
+        *names = readNames(in, filepath);
+    }
+    m_time.resize(numTimes);
+    if (numTimes) {
+        OPENSIM_THROW_IF(!in.read(reinterpret_cast<char*>(&m_time[0]),
+                                 numTimes * sizeof(double)),
+                Exception, "Unexpected end of file '{}'.", filepath);
+    }
+    readMatrix(in, filepath, numTimes, (int)m_state_names.size(), m_states);
+    readMatrix(in, filepath, numTimes, (int)m_control_names.size(),
+            m_controls);
+    readMatrix(in, filepath, numTimes, (int)m_input_control_names.size(),
+            m_input_controls);
+    readMatrix(in, filepath, numTimes, (int)m_multiplier_names.size(),
+            m_multipliers);
+    readMatrix(in, filepath, numTimes, (int)m_derivative_names.size(),
+            m_derivatives);
+    readMatrix(in, filepath, numTimes, (int)m_slack_names.size(), m_slacks);
+    m_parameters.resize((int)m_parameter_names.size());
+    for (int i = 0; i < (int)m_parameter_names.size(); ++i) {
+        m_parameters[i] = readValue<double>(in, filepath);
+    }
+}
+
 TimeSeriesTable MocoTrajectory::convertToTable() const {
     ensureUnsealed();
     std::vector<double> time(&m_time[0], &m_time[0] + m_time.size());
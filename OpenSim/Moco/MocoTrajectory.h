@@ -184,8 +184,9 @@ public:
                     continuousVars,
             const NamesAndData<SimTK::RowVector>& parameters = {});
 #endif
-    /// Read a MocoTrajectory from an STO file (see STOFileAdapter). See output
-    /// of write() for the correct format.
+    /// Read a MocoTrajectory from an STO file (see STOFileAdapter) or from a
+    /// binary file written by write(). See output of write() for the correct
+    /// format.
     explicit MocoTrajectory(const std::string& filepath);
 
     virtual ~MocoTrajectory() = default;
@@ -832,6 +833,14 @@ public:
     /// @{
 
     /// Save the trajectory to a STO file. Use the ."sto" file extension.
+    /// If the file extension is ".mocotraj", the trajectory is instead saved
+    /// in a binary format that is much faster to write and read than an STO
+    /// file and preserves the values exactly (e.g., for checkpointing
+    /// intermediate solutions to use as guesses). The binary file contains
+    /// the names and values of the time, states, controls, input controls,
+    /// multipliers, derivatives, slacks and parameters, in the byte order of
+    /// the machine that wrote it; the additional information in the header of
+    /// an STO file for a MocoSolution (e.g., the objective) is not saved.
     void write(const std::string& filepath) const;
 
     /// This table can be saved as a Storage file that can be used in the
@@ -949,6 +958,8 @@ protected:
 
 private:
     TimeSeriesTable convertToTable() const;
+    void writeBinary(const std::string& filepath) const;
+    void readBinary(const std::string& filepath);
     virtual void convertToTableImpl(TimeSeriesTable&) const {}
     double compareContinuousVariablesRMSInternal(const MocoTrajectory& other,
             std::vector<std::string> stateNames = {},
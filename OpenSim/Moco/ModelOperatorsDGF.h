@@ -18,6 +18,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBatch.h>
 #include <OpenSim/Actuators/ModelProcessor.h>
 
 namespace OpenSim {
@@ -180,6 +181,26 @@ public:
     }
 };
 
+/** Add a DeGrooteFregly2016MuscleBatch to the model, if it does not already
+contain one, so that the DeGrooteFregly2016Muscle%s with a rigid tendon are
+evaluated together. */
+class OSIMMOCO_API ModOpUseBatchedEvaluationDGF : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            ModOpUseBatchedEvaluationDGF, ModelOperator);
+
+public:
+    void operate(Model& model, const std::string&) const override {
+        model.finalizeFromProperties();
+        const auto batches =
+                model.getComponentList<DeGrooteFregly2016MuscleBatch>();
+        if (batches.begin() == batches.end()) {
+            auto* batch = new DeGrooteFregly2016MuscleBatch();
+            batch->setName("muscle_batch");
+            model.addComponent(batch);
+        }
+    }
+};
+
 } // namespace OpenSim
 
 #endif // OPENSIM_MODELOPERATORS_H
@@ -126,6 +126,7 @@ OSIMMOCO_API void RegisterTypes_osimMoco() {
         Object::registerType(ModOpTendonComplianceDynamicsModeDGF());
         Object::registerType(ModOpIgnorePassiveFiberForcesDGF());
         Object::registerType(ModOpScaleActiveFiberForceCurveWidthDGF());
+        Object::registerType(ModOpUseBatchedEvaluationDGF());
 
         Object::registerType(AckermannVanDenBogert2010Force());
         Object::registerType(MeyerFregly2016Force());
@@ -19,6 +19,7 @@
 #include <OpenSim/Actuators/BodyActuator.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/LogSink.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -184,6 +185,143 @@ TEMPLATE_TEST_CASE("Non-uniform mesh", "", MocoCasADiSolver, MocoTropterSolver)
     }
 }
 
+TEST_CASE("Mesh refinement", "[casadi]") {
+    // The optimal control of this minimum-time problem switches from the
+    // upper bound to the lower bound halfway, so the error of the solution on
+    // a coarse mesh is largest near the switch.
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>(
+            transcriptionScheme, 5);
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    const int numPointsPerInterval =
+            transcriptionScheme == "hermite-simpson" ? 2 : 1;
+
+    SECTION("Disabled by default") {
+        MocoSolution solution = study.solve();
+        CHECK(solution.getNumTimes() == 5 * numPointsPerInterval + 1);
+    }
+    SECTION("Refine") {
+        solver.set_mesh_refinement_max_iterations(3);
+        solver.set_mesh_refinement_tolerance(1e-8);
+        MocoSolution solution = study.solve();
+        const int numMeshIntervals =
+                (solution.getNumTimes() - 1) / numPointsPerInterval;
+        CHECK(numMeshIntervals > 5);
+        CHECK(numMeshIntervals <= 5 * 8);
+        CHECK(solution.getFinalTime() == Approx(2.0).epsilon(1e-2));
+    }
+    SECTION("Limit the number of mesh intervals") {
+        solver.set_mesh_refinement_max_iterations(10);
+        solver.set_mesh_refinement_tolerance(1e-8);
+        solver.set_mesh_refinement_max_mesh_intervals(10);
+        MocoSolution solution = study.solve();
+        CHECK((solution.getNumTimes() - 1) / numPointsPerInterval <= 10);
+    }
+    SECTION("Failed solve on a refined mesh") {
+        // With a fixed final time, the mesh points are at multiples of 0.6 s.
+        // This constraint is infeasible halfway between them, where the
+        // refined mesh has new mesh points.
+        MocoProblem& problem = study.updProblem();
+        problem.setTimeBounds(0, 3);
+        auto* constr =
+                problem.addPathConstraint<MocoControlBoundConstraint>();
+        constr->addControlPath("/actuator");
+        PiecewiseLinearFunction lowerBound;
+        for (int i = 0; i < 5; ++i) {
+            lowerBound.addPoint(0.6 * i, -100);
+            lowerBound.addPoint(0.6 * i + 0.3, 100);
+        }
+        lowerBound.addPoint(3, -100);
+        constr->setLowerBound(lowerBound);
+        solver.set_optim_max_iterations(200);
+        solver.set_mesh_refinement_max_iterations(3);
+        solver.set_mesh_refinement_tolerance(1e-12);
+
+        auto sink = std::make_shared<StringLogSink>();
+        Logger::addSink(sink);
+        MocoSolution solution = study.solve();
+        Logger::removeSink(sink);
+        CHECK(sink->getString().find("returning the solution on the "
+                                     "previous mesh") != std::string::npos);
+        CHECK(solution.success());
+        CHECK(solution.getNumTimes() == 5 * numPointsPerInterval + 1);
+    }
+    SECTION("Invalid settings") {
+        solver.set_mesh_refinement_tolerance(-1);
+        CHECK_THROWS(study.solve());
+    }
+}
+
+TEST_CASE("Reuse transcription", "[casadi]") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>(
+            transcriptionScheme, 10);
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_reuse_transcription(true);
+
+    // Solve, and check from the log whether the transcription of the
+    // previous solve was reused.
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+    auto solve = [&](bool expectReused) {
+        sink->clear();
+        MocoSolution solution = study.solve();
+        const bool reused = sink->getString().find(
+                "Reusing the transcription") != std::string::npos;
+        CHECK(reused == expectReused);
+        return solution;
+    };
+    MocoSolution first = solve(false);
+    CHECK(first.getFinalTime() == Approx(2.0).epsilon(1e-2));
+
+    SECTION("Change bounds") {
+        // Reuse the transcription of the first solve.
+        MocoProblem& problem = study.updProblem();
+        problem.setStateInfo("/slider/position/value", MocoBounds(0, 1),
+                MocoInitialBounds(0), MocoFinalBounds(0.5));
+        MocoSolution reused = solve(true);
+
+        MocoStudy fresh = createSlidingMassMocoStudy<MocoCasADiSolver>(
+                transcriptionScheme, 10);
+        fresh.updProblem().setStateInfo("/slider/position/value",
+                MocoBounds(0, 1), MocoInitialBounds(0), MocoFinalBounds(0.5));
+        MocoSolution expected = fresh.solve();
+        CHECK(reused.getFinalTime() < first.getFinalTime());
+        CHECK(reused.getFinalTime() ==
+                Approx(expected.getFinalTime()).epsilon(1e-4));
+    }
+    SECTION("Change weight") {
+        MocoProblem& problem = study.updProblem();
+        problem.updGoal("goal").setWeight(10);
+        MocoSolution reused = solve(true);
+        CHECK(reused.getObjective() ==
+                Approx(10 * first.getObjective()).epsilon(1e-4));
+    }
+    SECTION("Change goals") {
+        // The problem has a different structure, so it is transcribed again.
+        MocoProblem& problem = study.updProblem();
+        problem.addGoal<MocoControlGoal>("effort", 0.01);
+        MocoSolution solution = solve(false);
+        CHECK(solution.getObjective() > first.getObjective());
+        // The new transcription is reused in turn.
+        solve(true);
+    }
+    SECTION("Change settings") {
+        solver.set_num_mesh_intervals(20);
+        const int numPointsPerInterval =
+                transcriptionScheme == "hermite-simpson" ? 2 : 1;
+        MocoSolution solution = solve(false);
+        CHECK(solution.getNumTimes() == 20 * numPointsPerInterval + 1);
+    }
+    SECTION("Cannot combine with mesh refinement") {
+        solver.set_mesh_refinement_max_iterations(1);
+        CHECK_THROWS(study.solve());
+    }
+    Logger::removeSink(sink);
+}
+
 /// This model is torque-actuated.
 std::unique_ptr<Model> createPendulumModel() {
     auto model = make_unique<Model>();
@@ -1650,6 +1788,71 @@ TEST_CASE("MocoTrajectory randomize") {
     }
 }
 
+TEST_CASE("MocoTrajectory binary file") {
+    SimTK::Vector time(3);
+    time[0] = 0;
+    time[1] = 0.1;
+    time[2] = 0.25;
+    MocoTrajectory orig(time, {"a", "b"}, {"g", "h", "i", "j"}, {"m"},
+            {"o", "p"}, SimTK::Test::randMatrix(3, 2),
+            SimTK::Test::randMatrix(3, 4), SimTK::Test::randMatrix(3, 1),
+            SimTK::Test::randVector(2).transpose());
+    // Values that lose precision in an STO file.
+    orig.setState("a", SimTK::Vector(3, 1.0 / 3.0));
+    orig.write("testMocoInterface_MocoTrajectory.mocotraj");
+
+    SECTION("Round trip") {
+        MocoTrajectory deserialized("testMocoInterface_MocoTrajectory.mocotraj");
+        CHECK(deserialized.getStateNames() == orig.getStateNames());
+        CHECK(deserialized.getControlNames() == orig.getControlNames());
+        CHECK(deserialized.getMultiplierNames() == orig.getMultiplierNames());
+        CHECK(deserialized.getParameterNames() == orig.getParameterNames());
+        CHECK((deserialized.getTime() - orig.getTime()).normInf() == 0);
+        CHECK((deserialized.getStatesTrajectory() -
+                      orig.getStatesTrajectory()).normInf() == 0);
+        CHECK((deserialized.getControlsTrajectory() -
+                      orig.getControlsTrajectory()).normInf() == 0);
+        CHECK((deserialized.getMultipliersTrajectory() -
+                      orig.getMultipliersTrajectory()).normInf() == 0);
+        CHECK((deserialized.getParameters() - orig.getParameters())
+                        .normInf() == 0);
+    }
+    SECTION("Truncated file") {
+        {
+            std::ofstream out("testMocoInterface_MocoTrajectory_truncated"
+                              ".mocotraj", std::ios::binary);
+            std::ifstream in("testMocoInterface_MocoTrajectory.mocotraj",
+                    std::ios::binary | std::ios::ate);
+            std::vector<char> contents((size_t)in.tellg() / 2);
+            in.seekg(0);
+            in.read(contents.data(), contents.size());
+            out.write(contents.data(), contents.size());
+        }
+        CHECK_THROWS(MocoTrajectory(
+                "testMocoInterface_MocoTrajectory_truncated.mocotraj"));
+    }
+    SECTION("Corrupt counts") {
+        // The number of times, and the number of state names, follow the
+        // 16-byte header.
+        for (const int offset : {16, 24}) {
+            {
+                std::ifstream in("testMocoInterface_MocoTrajectory.mocotraj",
+                        std::ios::binary);
+                std::ofstream out("testMocoInterface_MocoTrajectory_corrupt"
+                                  ".mocotraj", std::ios::binary);
+                out << in.rdbuf();
+                out.seekp(offset);
+                const std::uint64_t count = std::uint64_t(1) << 60;
+                out.write(reinterpret_cast<const char*>(&count),
+                        sizeof(count));
+            }
+            CHECK_THROWS_WITH(MocoTrajectory(
+                    "testMocoInterface_MocoTrajectory_corrupt.mocotraj"),
+                    ContainsSubstring("exceeds the size of the file"));
+        }
+    }
+}
+
 TEST_CASE("createPeriodicTrajectory") {
     const std::string hip_r = "hip_r/hip_flexion_r/value";
     const std::string hip_l = "hip_l/hip_flexion_l/value";
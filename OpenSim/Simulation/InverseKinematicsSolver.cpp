@@ -24,6 +24,7 @@
 #include "InverseKinematicsSolver.h"
 #include "Model/Model.h"
 #include "Model/MarkerSet.h"
+#include "SimbodyEngine/Constraint.h"
 
 #include "simbody/internal/AssemblyCondition_Markers.h"
 #include "simbody/internal/AssemblyCondition_OrientationSensors.h"
@@ -218,6 +219,7 @@ SimTK::Vec3 InverseKinematicsSolver::computeCurrentMarkerLocation(const std::str
 
 SimTK::Vec3 InverseKinematicsSolver::computeCurrentMarkerLocation(int markerIndex)
 {
+    updateAssemblerWithSolution();
     if(markerIndex >=0 && markerIndex < _markerAssemblyCondition->getNumMarkers()){
         return _markerAssemblyCondition->findCurrentMarkerLocation(SimTK::Markers::MarkerIx(markerIndex));
     }
@@ -228,6 +230,7 @@ SimTK::Vec3 InverseKinematicsSolver::computeCurrentMarkerLocation(int markerInde
 /* Compute and return the spatial locations of all markers in ground. */
 void InverseKinematicsSolver::computeCurrentMarkerLocations(SimTK::Array_<SimTK::Vec3> &markerLocations)
 {
+    updateAssemblerWithSolution();
     markerLocations.resize(_markerAssemblyCondition->getNumMarkers());
     for(unsigned int i=0; i<markerLocations.size(); i++)
         markerLocations[i] = _markerAssemblyCondition->findCurrentMarkerLocation(SimTK::Markers::MarkerIx(i));
@@ -245,6 +248,7 @@ double InverseKinematicsSolver::computeCurrentMarkerError(const std::string &mar
 
 double InverseKinematicsSolver::computeCurrentMarkerError(int markerIndex)
 {
+    updateAssemblerWithSolution();
     if(markerIndex >=0 && markerIndex < _markerAssemblyCondition->getNumMarkers()){
         return _markerAssemblyCondition->findCurrentMarkerError(SimTK::Markers::MarkerIx(markerIndex));
     }
@@ -255,6 +259,7 @@ double InverseKinematicsSolver::computeCurrentMarkerError(int markerIndex)
 /* Compute and return the distance errors between all model markers and their observations. */
 void InverseKinematicsSolver::computeCurrentMarkerErrors(SimTK::Array_<double> &markerErrors)
 {
+    updateAssemblerWithSolution();
     markerErrors.resize(_markerAssemblyCondition->getNumMarkers());
     for(unsigned int i=0; i<markerErrors.size(); i++)
         markerErrors[i] = _markerAssemblyCondition->findCurrentMarkerError(SimTK::Markers::MarkerIx(i));
@@ -272,6 +277,7 @@ double InverseKinematicsSolver::computeCurrentSquaredMarkerError(const std::stri
 
 double InverseKinematicsSolver::computeCurrentSquaredMarkerError(int markerIndex)
 {
+    updateAssemblerWithSolution();
     if(markerIndex >=0 && markerIndex < _markerAssemblyCondition->getNumMarkers()){
         return _markerAssemblyCondition->findCurrentMarkerErrorSquared(SimTK::Markers::MarkerIx(markerIndex));
     }
@@ -283,6 +289,7 @@ double InverseKinematicsSolver::computeCurrentSquaredMarkerError(int markerIndex
 void InverseKinematicsSolver::
     computeCurrentSquaredMarkerErrors(SimTK::Array_<double> &markerErrors)
 {
+    updateAssemblerWithSolution();
     markerErrors.resize(_markerAssemblyCondition->getNumMarkers());
     for(unsigned int i=0; i<markerErrors.size(); i++)
         markerErrors[i] = _markerAssemblyCondition->
@@ -372,6 +379,23 @@ std::string InverseKinematicsSolver::
     of the base assembly solver, that is going to do the assembly.  */
 void InverseKinematicsSolver::setupGoals(SimTK::State &s)
 {
+    // Record the locked coordinates before the base class unlocks those that
+    // have a reference.
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
+    _lockedQ.clear();
+    for (int i = 0; i < modelCoordSet.getSize(); ++i) {
+        const Coordinate& coord = modelCoordSet[i];
+        if (coord.getLocked(s)) {
+            _lockedQ.push_back(
+                    int(matter.getMobilizedBody(coord.getBodyIndex())
+                                    .getFirstQIndex(s)) +
+                    coord.getMobilizerQIndex());
+        }
+    }
+    _assemblerNeedsSolution = false;
+
     // Setup coordinates performed by the base class
     AssemblySolver::setupGoals(s);
 
@@ -380,6 +404,18 @@ void InverseKinematicsSolver::setupGoals(SimTK::State &s)
     setupOrientationsGoal(s);
 
     updateGoals(s);
+
+    _trackWithLevenbergMarquardt = false;
+    if (_useLevenbergMarquardt) {
+        const std::string reason = checkLevenbergMarquardt(s);
+        if (reason.empty()) {
+            _trackWithLevenbergMarquardt = true;
+        } else {
+            log_warn("InverseKinematicsSolver: track() uses the "
+                     "SimTK::Assembler instead of the Levenberg-Marquardt "
+                     "solver because {}.", reason);
+        }
+    }
 }
 
 void InverseKinematicsSolver::setupMarkersGoal(SimTK::State &s)
@@ -511,4 +547,254 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     }
 }
 
+void InverseKinematicsSolver::track(SimTK::State &s)
+{
+    if (_trackWithLevenbergMarquardt) {
+        trackWithLevenbergMarquardt(s);
+    } else {
+        AssemblySolver::track(s);
+    }
+}
+
+std::string InverseKinematicsSolver::checkLevenbergMarquardt(
+        const SimTK::State &s) const
+{
+    if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
+        return "orientation sensors are tracked";
+    }
+    if (s.getNQ() != s.getNU()) {
+        return "the model has quaternions (NQ != NU)";
+    }
+    for (const auto& constraint : getModel().getComponentList<Constraint>()) {
+        if (constraint.isEnforced(s)) {
+            return "constraint '" + constraint.getName() + "' is enforced";
+        }
+    }
+    return "";
+}
+
+void InverseKinematicsSolver::trackWithLevenbergMarquardt(SimTK::State &s)
+{
+    if (!getAssembler().isInitialized()) {
+        throw Exception("InverseKinematicsSolver::track() failed: "
+                        "assemble() must be called first.");
+    }
+    // Move the marker observations and the desired coordinate values to the
+    // time of the state.
+    updateGoals(s);
+
+    const SimTK::MultibodySystem& system = getModel().getMultibodySystem();
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
+    const int nq = s.getNQ();
+
+    // The q's that are solved for (all but those of locked and prescribed
+    // coordinates), and the range of the clamped ones. Prescribed coordinates
+    // are held at the value of their function at the time of the state.
+    SimTK::Array_<bool> isFree(nq, true);
+    SimTK::Vector lower(nq, -SimTK::Infinity);
+    SimTK::Vector upper(nq, SimTK::Infinity);
+    const auto findQIndex = [&](const Coordinate& coord) {
+        return int(matter.getMobilizedBody(coord.getBodyIndex())
+                           .getFirstQIndex(s)) +
+               coord.getMobilizerQIndex();
+    };
+    for (const int iq : _lockedQ) isFree[iq] = false;
+    for (int i = 0; i < modelCoordSet.getSize(); ++i) {
+        const Coordinate& coord = modelCoordSet[i];
+        const int iq = findQIndex(coord);
+        if (coord.getLocked(s)) {
+            isFree[iq] = false;
+        } else if (coord.isPrescribed(s)) {
+            isFree[iq] = false;
+            s.updQ()[iq] = coord.getPrescribedFunction().calcValue(
+                    SimTK::Vector(1, s.getTime()));
+        } else if (coord.getClamped(s)) {
+            lower[iq] = coord.getRangeMin();
+            upper[iq] = coord.getRangeMax();
+        }
+    }
+    SimTK::Array_<int> freeQ;
+    for (int iq = 0; iq < nq; ++iq) {
+        if (isFree[iq]) freeQ.push_back(iq);
+    }
+    const int nf = (int)freeQ.size();
+
+    // Markers with an observation at this time. The squared errors are
+    // normalized by the sum of the weights of these markers, as in
+    // SimTK::Markers.
+    SimTK::Array_<SimTK::MobilizedBodyIndex> markerBodies;
+    SimTK::Array_<SimTK::Vec3> markerStations;
+    SimTK::Array_<SimTK::Vec3> observations;
+    SimTK::Array_<double> markerWeights;
+    double totalMarkerWeight = 0;
+    const int numMarkers = _markerAssemblyCondition.empty()
+            ? 0 : _markerAssemblyCondition->getNumMarkers();
+    for (int i = 0; i < numMarkers; ++i) {
+        const SimTK::Markers::MarkerIx mx(i);
+        const double weight = _markerAssemblyCondition->getMarkerWeight(mx);
+        if (!_markerAssemblyCondition->hasObservation(mx) || weight == 0) {
+            continue;
+        }
+        const SimTK::Vec3& observation =
+                _markerAssemblyCondition->getObservation(
+                        _markerAssemblyCondition->getObservationIxForMarker(
+                                mx));
+        if (!observation.isFinite()) continue;
+        markerBodies.push_back(_markerAssemblyCondition->getMarkerBody(mx));
+        markerStations.push_back(
+                _markerAssemblyCondition->getMarkerStation(mx));
+        observations.push_back(observation);
+        markerWeights.push_back(weight);
+        totalMarkerWeight += weight;
+    }
+    const int nm = (int)markerBodies.size();
+    for (int k = 0; k < nm; ++k) {
+        markerWeights[k] = std::sqrt(markerWeights[k] / totalMarkerWeight);
+    }
+
+    // Desired coordinate values (the references of locked coordinates were
+    // removed by AssemblySolver::setupGoals()).
+    const SimTK::Array_<CoordinateReference>& coordRefs =
+            getCoordinateReferences();
+    const int nc = (int)coordRefs.size();
+    SimTK::Array_<int> refQ(nc);
+    SimTK::Vector refValues(nc);
+    SimTK::Vector refWeights(nc);
+    for (int j = 0; j < nc; ++j) {
+        refQ[j] = findQIndex(modelCoordSet.get(coordRefs[j].getName()));
+        refValues[j] = coordRefs[j].getValue(s);
+        refWeights[j] = std::sqrt(coordRefs[j].getWeight(s));
+    }
+
+    // Weighted residuals, whose sum of squares is the objective.
+    const int nr = 3 * nm + nc;
+    const auto calcResiduals = [&](SimTK::Vector& r) {
+        r.resize(nr);
+        for (int k = 0; k < nm; ++k) {
+            const SimTK::Vec3 error = markerWeights[k] *
+                    (matter.getMobilizedBody(markerBodies[k])
+                            .findStationLocationInGround(s, markerStations[k])
+                            - observations[k]);
+            for (int l = 0; l < 3; ++l) r[3 * k + l] = error[l];
+        }
+        for (int j = 0; j < nc; ++j) {
+            r[3 * nm + j] = refWeights[j] * (s.getQ()[refQ[j]] - refValues[j]);
+        }
+    };
+
+    // Jacobian of the residuals with respect to the free q's. The station
+    // Jacobian of all markers maps u to the marker velocities, so the
+    // Jacobian with respect to q is JS*NInv (qdot = N*u).
+    SimTK::Matrix JS;
+    SimTK::Vector rowU(s.getNU()), rowQ(nq);
+    const auto calcJacobian = [&](SimTK::Matrix& J) {
+        J.resize(nr, nf);
+        J = 0;
+        if (nm > 0) {
+            matter.calcStationJacobian(s, markerBodies, markerStations, JS);
+        }
+        for (int i = 0; i < 3 * nm; ++i) {
+            rowU = ~JS[i];
+            matter.multiplyByNInv(s, true, rowU, rowQ);
+            for (int f = 0; f < nf; ++f) {
+                J(i, f) = markerWeights[i / 3] * rowQ[freeQ[f]];
+            }
+        }
+        for (int j = 0; j < nc; ++j) {
+            for (int f = 0; f < nf; ++f) {
+                if (freeQ[f] == refQ[j]) J(3 * nm + j, f) = refWeights[j];
+            }
+        }
+    };
+
+    // Levenberg-Marquardt iterations, starting from the q's in the state.
+    // The iterations stop once the largest change in q is within the
+    // accuracy, or the objective cannot be decreased further.
+    const int maxIterations = 100;
+    const double maxDamping = 1e10;
+    double damping = 1e-3;
+    system.realize(s, SimTK::Stage::Position);
+    SimTK::Vector r, rTrial, dq;
+    SimTK::Matrix J, A;
+    calcResiduals(r);
+    double cost = r.normSqr();
+    SimTK::Vector q = s.getQ();
+    int numIterations = 0;
+    bool converged = (nf == 0);
+    while (!converged && numIterations < maxIterations) {
+        ++numIterations;
+        calcJacobian(J);
+        const SimTK::Matrix JTJ = ~J * J;
+        const SimTK::Vector JTr = ~J * r;
+
+        bool decreased = false;
+        while (!decreased && damping < maxDamping) {
+            A = JTJ;
+            for (int f = 0; f < nf; ++f) {
+                A(f, f) += damping *
+                           std::max(JTJ(f, f), SimTK::SignificantReal);
+            }
+            SimTK::FactorLU(A).solve(-JTr, dq);
+
+            double maxStep = 0;
+            for (int f = 0; f < nf; ++f) {
+                const int iq = freeQ[f];
+                const double qi = SimTK::clamp(lower[iq], q[iq] + dq[f],
+                        upper[iq]);
+                maxStep = std::max(maxStep, std::abs(qi - q[iq]));
+                s.updQ()[iq] = qi;
+            }
+            system.realize(s, SimTK::Stage::Position);
+            calcResiduals(rTrial);
+            const double costTrial = rTrial.normSqr();
+            if (costTrial < cost) {
+                decreased = true;
+                cost = costTrial;
+                r = rTrial;
+                q = s.getQ();
+                damping = std::max(0.1 * damping, 1e-12);
+                converged = (maxStep <= getAccuracy());
+            } else {
+                damping *= 10;
+                converged = (maxStep <= getAccuracy());
+                if (converged) break;
+            }
+        }
+        if (!decreased) {
+            // No step decreases the objective: q is the minimum.
+            s.updQ() = q;
+            system.realize(s, SimTK::Stage::Position);
+            converged = true;
+        }
+    }
+    if (!converged) {
+        log_warn("InverseKinematicsSolver::track(): Levenberg-Marquardt "
+                 "solver did not converge in {} iterations at time {}.",
+                maxIterations, s.getTime());
+    }
+
+    // The marker errors and locations are computed from the internal state
+    // of the SimTK::Assembler, which is updated with the solution only if
+    // these are requested (see updateAssemblerWithSolution()).
+    _solutionQ = s.getQ();
+    _solutionTime = s.getTime();
+    _assemblerNeedsSolution = true;
+    log_debug("Tracking: t= {} (Levenberg-Marquardt iterations={} cost={})",
+            s.getTime(), numIterations, cost);
+}
+
+void InverseKinematicsSolver::updateAssemblerWithSolution()
+{
+    if (!_assemblerNeedsSolution) return;
+    SimTK::State s = getAssembler().getInternalState();
+    s.updTime() = _solutionTime;
+    s.updQ() = _solutionQ;
+    updAssembler().initialize(s);
+    getModel().getMultibodySystem().realize(
+            getAssembler().getInternalState(), SimTK::Stage::Position);
+    _assemblerNeedsSolution = false;
+}
+
 } // end of namespace OpenSim
@@ -63,6 +63,21 @@ namespace OpenSim {
  *
  * See SimTK::Assembler for more algorithmic details of the underlying solver.
  *
+ * With setUseLevenbergMarquardt(), track() instead minimizes the objective
+ * with a Levenberg-Marquardt solver that starts from the coordinates in the
+ * state (i.e., the solution of the previous frame). The Jacobian of the marker
+ * errors is computed analytically at each iteration, for all markers at once,
+ * from the station Jacobian of the SimbodyMatterSubsystem. This is much
+ * faster than the SimTK::Assembler for models with many markers. As with the
+ * SimTK::Assembler, the marker term is normalized by the sum of the weights
+ * of the markers with observations, locked coordinates are not changed,
+ * prescribed coordinates follow their prescribed function and clamped
+ * coordinates are kept within their range. This mode does not support
+ * orientation sensors, enforced constraints or models whose number of
+ * coordinates (q) differs from the number of speeds (u), e.g. those with
+ * quaternions; track() then uses the SimTK::Assembler. assemble() always uses
+ * the SimTK::Assembler.
+ *
  * @author Ajay Seth
  */
 class OSIMSIMULATION_API InverseKinematicsSolver: public AssemblySolver
@@ -115,13 +130,21 @@ public:
         does not have to satisfy the constraints. */
     //virtual void assemble(SimTK::State &s);
 
-    /* Obtain a model configuration that meets the InverseKinematics conditions  
-        (desired values and constraints) given a state that satisfies or
-        is close to satisfying the constraints. Note there can be no change
-        in the number of constraints or desired coordinates. Desired
+    /** Obtain a model configuration that meets the InverseKinematics
+        conditions (desired values and constraints) given a state that
+        satisfies or is close to satisfying the constraints. Note there can be
+        no change in the number of constraints or desired coordinates. Desired
         coordinate values can and should be updated between repeated calls
         to track a desired trajectory of coordinate values. */
-    //virtual void track(SimTK::State &s);
+    void track(SimTK::State &s) override;
+
+    /** Use a Levenberg-Marquardt solver with an analytic Jacobian, instead of
+        the SimTK::Assembler, in track() (see the class description). Takes
+        effect when assemble() is called next. The default is false. */
+    void setUseLevenbergMarquardt(bool useLevenbergMarquardt) {
+        _useLevenbergMarquardt = useLevenbergMarquardt;
+    }
+    bool getUseLevenbergMarquardt() const { return _useLevenbergMarquardt; }
 
     /** Return the number of markers used to solve for model coordinates.
         It is a count of the number of markers in the intersection of 
@@ -248,6 +271,13 @@ private:
         assembly problem. */
     void setupOrientationsGoal(SimTK::State &s);
 
+    /** Return an empty string if track() can use the Levenberg-Marquardt
+        solver for this state, otherwise the reason it cannot. */
+    std::string checkLevenbergMarquardt(const SimTK::State &s) const;
+
+    /** Levenberg-Marquardt implementation of track(). */
+    void trackWithLevenbergMarquardt(SimTK::State &s);
+
     // The marker reference values and weightings
     std::shared_ptr<MarkersReference> _markersReference;
 
@@ -266,6 +296,25 @@ private:
     // controlled by the driver porgram (typically based on pre-recorded data).
     bool _advanceTimeFromReference{false};
 
+    // Whether track() should use the Levenberg-Marquardt solver, and whether
+    // it does so since the last assemble().
+    bool _useLevenbergMarquardt{false};
+    bool _trackWithLevenbergMarquardt{false};
+
+    // The q's of the coordinates that were locked when assemble() was called.
+    // AssemblySolver::setupGoals() unlocks those that have a reference and
+    // locks their q's in the SimTK::Assembler instead.
+    SimTK::Array_<int> _lockedQ;
+
+    // The marker locations and errors are computed from the internal state of
+    // the SimTK::Assembler. After track() with the Levenberg-Marquardt solver,
+    // the Assembler is updated with the solution (_solutionQ at _solutionTime)
+    // only once these are requested.
+    bool _assemblerNeedsSolution{false};
+    SimTK::Vector _solutionQ;
+    double _solutionTime{SimTK::NaN};
+    void updateAssemblerWithSolution();
+
 //=============================================================================
 };  // END of class InverseKinematicsSolver
 //=============================================================================
@@ -115,6 +115,13 @@ to consider the order of scaling the model and setting the slack_length
 property for your specific application. The linear_stiffness property is not 
 affected by scaling the model. 
 
+The path property can be any AbstractGeometryPath. In knee models with many 
+ligament bundles wrapping over the bones, the GeometryPath of each bundle can 
+be replaced by a FunctionBasedPath fitted over the secondary coordinate space 
+with PolynomialPathFitter, so the length and lengthening speed are evaluated 
+without wrapping. See the "Ligaments" section of PolynomialPathFitter and the 
+function_based_paths_file property of COMAKTool and ForsimTool.
+
 ### References
 
 [1] Blankevoort, L. and Huiskes, R., (1991).
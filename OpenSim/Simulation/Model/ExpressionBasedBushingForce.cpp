@@ -215,59 +215,91 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
-/** Set the expression for the Mx function and create it's lepton program */
+/** Set the expression for the Mx function and compile it */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(0, expression);
 }
 
-/** Set the expression for the My function and create it's lepton program */
+/** Set the expression for the My function and compile it */
 void ExpressionBasedBushingForce::setMyExpression(std::string expression) 
 {
     
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(1, expression);
 }
 
-/** Set the expression for the Mz function and create it's lepton program */
+/** Set the expression for the Mz function and compile it */
 void ExpressionBasedBushingForce::setMzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(2, expression);
 }
 
-/** Set the expression for the Fx function and create it's lepton program */
+/** Set the expression for the Fx function and compile it */
 void ExpressionBasedBushingForce::setFxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(3, expression);
 }
 
-/** Set the expression for the Fy function and create it's lepton program */
+/** Set the expression for the Fy function and compile it */
 void ExpressionBasedBushingForce::setFyExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(4, expression);
 }
 
-/** Set the expression for the Fz function and create it's lepton program */
+/** Set the expression for the Fz function and compile it */
 void ExpressionBasedBushingForce::setFzExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(5, expression);
+}
+
+/** Compile the expression for the stiffness component with the given index
+    (0-5 for Mx, My, Mz, Fx, Fy, Fz) and bind its deflection variables */
+void ExpressionBasedBushingForce::compileStiffnessExpression(int index,
+    const std::string& expression)
+{
+    static const std::array<std::string, 6> deflectionNames = {
+        "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z" };
+
+    Lepton::CompiledExpression& compiled = _stiffnessExprs[index];
+    compiled = Lepton::Parser::parse(expression).optimize()
+                                                .createCompiledExpression();
+
+    const std::set<std::string>& used = compiled.getVariables();
+    for (const std::string& var : used) {
+        if (std::find(deflectionNames.begin(), deflectionNames.end(), var)
+                == deflectionNames.end()) {
+            throw OpenSim::Exception("ExpressionBasedBushingForce: unknown "
+                "variable '" + var + "' in expression '" + expression + "'. Expressions "
+                "may only use theta_x, theta_y, theta_z, delta_x, delta_y "
+                "and delta_z.");
+        }
+    }
+
+    for (int j = 0; j < 6; ++j) {
+        if (used.count(deflectionNames[j]))
+            _deflectionRefs[index][j] =
+                &compiled.getVariableReference(deflectionNames[j]);
+        else
+            _deflectionRefs[index][j].reset();
+    }
 }
 
 //=============================================================================
@@ -283,21 +315,15 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    // write the deflections directly into the compiled expressions' variable
+    // slots rather than building a map of names on every evaluation
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            if (!_deflectionRefs[i][j].empty())
+                *_deflectionRefs[i][j] = dq[j];
+        }
+        fk[i] = _stiffnessExprs[i].evaluate();
+    }
 
     return -fk;
 }
@@ -27,6 +27,9 @@
 // INCLUDE
 #include <OpenSim/Simulation/Model/ForceProducer.h>
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include <lepton/CompiledExpression.h>
+
+#include <array>
 
 namespace OpenSim {
 
@@ -278,11 +281,17 @@ private:
 
     void setNull();
     void constructProperties();
+    void compileStiffnessExpression(int index, const std::string& expression);
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions for efficiently evaluating Mx, My, Mz, Fx, Fy, Fz
+    std::array<Lepton::CompiledExpression, 6> _stiffnessExprs;
+
+    // slots in each compiled expression for the theta_x, theta_y, theta_z,
+    // delta_x, delta_y and delta_z deflections (empty if the expression does
+    // not use that deflection); rebound whenever an expression is compiled
+    std::array<std::array<SimTK::ReferencePtr<double>, 6>, 6> _deflectionRefs;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
@@ -99,7 +99,20 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace),
                       expression.end() );
 
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = Lepton::Parser::parse(expression).optimize()
+                                                  .createCompiledExpression();
+    _qRef.reset();
+    _qdotRef.reset();
+    for (const string& var : _forceExpr.getVariables()) {
+        if (var == "q")
+            _qRef = &_forceExpr.getVariableReference(var);
+        else if (var == "qdot")
+            _qdotRef = &_forceExpr.getVariableReference(var);
+        else
+            throw Exception("ExpressionBasedCoordinateForce: unknown variable '"
+                + var + "' in expression of " + getName()
+                + ". Only q and qdot may be used.");
+    }
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -132,12 +145,11 @@ void ExpressionBasedCoordinateForce::implProduceForces(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    if (!_qRef.empty())
+        *_qRef = _coord->getValue(s);
+    if (!_qdotRef.empty())
+        *_qdotRef = _coord->getSpeedValue(s);
+    double forceMag = _forceExpr.evaluate();
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include <OpenSim/Simulation/Model/ForceProducer.h>
-#include <lepton/ExpressionProgram.h>
+#include <lepton/CompiledExpression.h>
 
 namespace OpenSim {
 
@@ -128,8 +128,11 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force, and its
+    // q and qdot variable slots (empty if unused by the expression)
+    Lepton::CompiledExpression _forceExpr;
+    SimTK::ReferencePtr<double> _qRef;
+    SimTK::ReferencePtr<double> _qdotRef;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
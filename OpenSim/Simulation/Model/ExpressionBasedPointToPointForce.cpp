@@ -140,7 +140,20 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = Lepton::Parser::parse(expression).optimize()
+                                                  .createCompiledExpression();
+    _dRef.reset();
+    _ddotRef.reset();
+    for (const string& var : _forceExpr.getVariables()) {
+        if (var == "d")
+            _dRef = &_forceExpr.getVariableReference(var);
+        else if (var == "ddot")
+            _ddotRef = &_forceExpr.getVariableReference(var);
+        else
+            throw Exception("ExpressionBasedPointToPointForce: unknown "
+                "variable '" + var + "' in expression of " + getName()
+                + ". Only d and ddot may be used.");
+    }
 }
 
 //=============================================================================
@@ -186,11 +199,12 @@ void ExpressionBasedPointToPointForce::implProduceForces(
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
+    if (!_dRef.empty())
+        *_dRef = d;
+    if (!_ddotRef.empty())
+        *_ddotRef = ddot;
 
-    double forceMag = _forceProg.evaluate(forceVars);
+    double forceMag = _forceExpr.evaluate();
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
@@ -25,7 +25,7 @@
 
 #include <OpenSim/Simulation/Model/ForceProducer.h>
 
-#include <lepton/ExpressionProgram.h>
+#include <lepton/CompiledExpression.h>
 
 namespace SimTK {
 class MobilizedBody;
@@ -171,8 +171,11 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force, and its
+    // d and ddot variable slots (empty if unused by the expression)
+    Lepton::CompiledExpression _forceExpr;
+    SimTK::ReferencePtr<double> _dRef;
+    SimTK::ReferencePtr<double> _ddotRef;
 
     // Temporary solution until implemented with Sockets
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
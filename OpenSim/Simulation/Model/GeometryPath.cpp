@@ -129,6 +129,24 @@ static void PopulatePathElementLookup(
     }
 }
 
+// Moves the result of a successful wrap from `src` into `dst` without copying
+// the wrap points: the point buffers are swapped, so both keep their capacity
+// for reuse by subsequent calls to `applyWrapObjects`.
+static void takeWrapResult(OpenSim::WrapResult& dst, OpenSim::WrapResult& src)
+{
+    std::swap(dst.wrap_pts, src.wrap_pts);
+    src.wrap_pts.setSize(0);
+
+    dst.startPoint = src.startPoint;
+    dst.endPoint = src.endPoint;
+    dst.wrap_path_length = src.wrap_path_length;
+    dst.r1 = src.r1;
+    dst.r2 = src.r2;
+    dst.c1 = src.c1;
+    dst.sv = src.sv;
+    dst.singleWrap = src.singleWrap;
+}
+
 // Returns a normalized direction vector from `a` to `b` in ground, or a vector containing `NaN`s
 // if `a` and `b` are at the same location.
 //
@@ -919,11 +937,16 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
     if (wrapSetSize < 1)
         return;
 
-    WrapResult best_wrap;
-    Array<int> result, order;
+    // Reuse the model-level scratch buffers so that, once their capacity
+    // has grown to fit this path, no heap allocation happens in here.
+    WrapScratch& scratch = _wrapScratch;
+    WrapResult& best_wrap = scratch.best;
+    WrapResult& wr = scratch.candidate;
+    std::vector<int>& result = scratch.result;
+    std::vector<int>& order = scratch.order;
 
-    result.setSize(wrapSetSize);
-    order.setSize(wrapSetSize);
+    result.assign(static_cast<size_t>(wrapSetSize), 0);
+    order.resize(static_cast<size_t>(wrapSetSize));
 
     // Set the initial order to be the order they are listed in the path.
     for (int i = 0; i < wrapSetSize; i++)
@@ -1023,7 +1046,8 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                         || (   path.get(pt1)->getWrapObject() 
                             != path.get(pt2)->getWrapObject()))
                     {
-                        WrapResult wr;
+                        wr.wrap_pts.setSize(0);
+                        wr.factor = SimTK::NaN;
                         wr.startPoint = pt1;
                         wr.endPoint   = pt2;
                         wr.singleWrap = (wrapSetSize==1);
@@ -1037,10 +1061,10 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                             // that intersects the object, the first one is
                             // taken as the mandatory wrap (this is considered 
                             // an ill-conditioned case).
-                            best_wrap = wr;
                             // Store the best wrap in the pathWrap for possible 
                             // use next time.
                             ws.setPreviousWrap(wr);
+                            takeWrapResult(best_wrap, wr);
                             break;
                         }  else if (result[i] == WrapObject::wrapped) {
                             // "wrapped" means the path segment was wrapped over
@@ -1051,15 +1075,15 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                                 calcPathLengthChange(s, *wo, wr, path);
                             if (path_length_change < min_length_change)
                             {
-                                best_wrap = wr;
                                 // Store the best wrap in the pathWrap for 
                                 // possible use next time
                                 ws.setPreviousWrap(wr);
+                                takeWrapResult(best_wrap, wr);
                                 min_length_change = path_length_change;
                             } else {
                                 // The wrap was not shorter than the current 
-                                // minimum, so just free the wrap points that 
-                                // were allocated.
+                                // minimum, so just discard the wrap points
+                                // (the buffer is kept for the next segment).
                                 wr.wrap_pts.setSize(0);
                             }
                         } else {
@@ -76,6 +76,18 @@ private:
     // needs an array of `AbstractPathPoint`s
     mutable SimTK::ResetOnCopy<Array<AbstractPathPoint*>> _currentPathPtrsCache;
 
+    // scratch storage used by `applyWrapObjects`. Keeping it between calls
+    // lets the wrap point buffers retain their capacity, so that computing
+    // the path of an already-seen configuration does not allocate. Like
+    // `_currentPathPtrsCache`, this is model-level (not per-state) storage.
+    struct WrapScratch {
+        WrapResult candidate;
+        WrapResult best;
+        std::vector<int> result;
+        std::vector<int> order;
+    };
+    mutable SimTK::ResetOnCopy<WrapScratch> _wrapScratch;
+
     mutable CacheVariable<double> _lengthCV;
     mutable CacheVariable<double> _speedCV;
 public:
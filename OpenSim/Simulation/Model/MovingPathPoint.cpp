@@ -213,6 +213,15 @@ void MovingPathPoint::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionN
     Super::updateFromXMLNode(aNode, versionNumber);
 }
 
+// Evaluate a single-argument location function. The argument vector is reused
+// (per thread) so that computing a path's geometry does not allocate.
+static double calcLocationValue(const OpenSim::Function& f, double x)
+{
+    thread_local SimTK::Vector arg(1);
+    arg[0] = x;
+    return f.calcValue(arg);
+}
+
 SimTK::Vec3 MovingPathPoint::getLocation(const SimTK::State& s) const
 {
     SimTK::Vec3 pInF(0);
@@ -220,28 +229,28 @@ SimTK::Vec3 MovingPathPoint::getLocation(const SimTK::State& s) const
         const double xval = SimTK::clamp(_xCoordinate->getRangeMin(),
             _xCoordinate->getValue(s),
             _xCoordinate->getRangeMax());
-        pInF[0] = get_x_location().calcValue(SimTK::Vector(1, xval));
+        pInF[0] = calcLocationValue(get_x_location(), xval);
     }
     else // assume a Constant
-        pInF[0] = get_x_location().calcValue(SimTK::Vector(1, 0.0));
+        pInF[0] = calcLocationValue(get_x_location(), 0.0);
 
     if (!_yCoordinate.empty()) {
         const double yval = SimTK::clamp(_yCoordinate->getRangeMin(),
             _yCoordinate->getValue(s),
             _yCoordinate->getRangeMax());
-        pInF[1] = get_y_location().calcValue(SimTK::Vector(1, yval));
+        pInF[1] = calcLocationValue(get_y_location(), yval);
     }
     else // type == Constant
-        pInF[1] = get_y_location().calcValue(SimTK::Vector(1, 0.0));
+        pInF[1] = calcLocationValue(get_y_location(), 0.0);
 
     if (!_zCoordinate.empty()) {
         const double zval = SimTK::clamp(_zCoordinate->getRangeMin(),
             _zCoordinate->getValue(s),
             _zCoordinate->getRangeMax());
-        pInF[2] = get_z_location().calcValue(SimTK::Vector(1, zval));
+        pInF[2] = calcLocationValue(get_z_location(), zval);
     }
     else // type == Constant
-        pInF[2] = get_z_location().calcValue(SimTK::Vector(1, 0.0));
+        pInF[2] = calcLocationValue(get_z_location(), 0.0);
 
     return pInF;
 }
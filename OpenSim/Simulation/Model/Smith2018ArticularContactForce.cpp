@@ -324,6 +324,12 @@ extendAddToSystem(MultibodySystem& system) const
     addModelingOption("flip_meshes", 1);
 }
 
+void Smith2018ArticularContactForce::resetRayCastCounts() const
+{
+    RayCastCounts& counts = _ray_cast_counts;
+    counts = RayCastCounts();
+}
+
 void Smith2018ArticularContactForce::computeMeshProximity(
     const State& state, const Smith2018ContactMesh& casting_mesh,
     const Smith2018ContactMesh& target_mesh, const std::string& cache_mesh_name) const
@@ -367,6 +373,7 @@ void Smith2018ArticularContactForce::computeMeshProximity(
     int nSameTri = 0;
     int nNeighborTri = 0;
     int nDiffTri = 0;
+    int nObbSearch = 0;
 
     //Collision Detection
     //-------------------
@@ -435,6 +442,7 @@ void Smith2018ArticularContactForce::computeMeshProximity(
         //No luck in rechecking same triangle and neighbors
         //Go through the expensive OBB hierarchy
         int contact_target_tri = -1;
+        nObbSearch++;
 
         if (target_mesh.rayIntersectMesh(origin, -direction,
             get_min_proximity(), get_max_proximity(),
@@ -453,6 +461,14 @@ void Smith2018ArticularContactForce::computeMeshProximity(
         target_tri[i] = -1;
     }
 
+    //Accumulate ray cast totals for profiling
+    RayCastCounts& counts = _ray_cast_counts;
+    counts.rays += casting_mesh.getNumFaces();
+    counts.same_triangle += nSameTri;
+    counts.neighbor_triangle += nNeighborTri;
+    counts.obb_search += nObbSearch;
+    counts.obb_hit += nDiffTri;
+
     //Store Contact Info
     if (cache_mesh_name == "casting"){
         this->setCacheVariableValue(state, 
@@ -925,6 +925,27 @@ public:
     OpenSim::Array<double> getRecordValues(const SimTK::State& s) const override;
     OpenSim::Array<std::string> getRecordLabels() const override;
 
+#ifndef SWIG
+    /** Running totals of the ray casts performed by the proximity
+    computations of this force, used for profiling. The totals are not part
+    of the State: they accumulate over every evaluation (including those made
+    on copies of the State) until resetRayCastCounts() is called. */
+    struct RayCastCounts {
+        /// Rays cast from the triangle centers of a casting mesh.
+        long long rays = 0;
+        /// Rays resolved by the triangle contacted in the previous evaluation.
+        long long same_triangle = 0;
+        /// Rays resolved by a neighbor of the previously contacted triangle.
+        long long neighbor_triangle = 0;
+        /// Rays that fell back to a search of the full OBB tree.
+        long long obb_search = 0;
+        /// Searches of the full OBB tree that found a contacting triangle.
+        long long obb_hit = 0;
+    };
+    const RayCastCounts& getRayCastCounts() const { return _ray_cast_counts; }
+    void resetRayCastCounts() const;
+#endif
+
 protected:
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
@@ -1073,6 +1094,9 @@ private:
     std::vector<std::string> _stat_names;
     std::vector<std::string> _stat_names_vec3;
     std::vector<std::string> _mesh_data_names;
+#ifndef SWIG
+    mutable SimTK::ResetOnCopy<RayCastCounts> _ray_cast_counts;
+#endif
 };
 //=============================================================================
 // END of class Smith2018ArticularContactForce
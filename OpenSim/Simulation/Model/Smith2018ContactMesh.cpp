@@ -162,7 +162,11 @@ void Smith2018ContactMesh::extendFinalizeFromProperties() {
 
     // Create Decorative Mesh
     if (!isObjectUpToDateWithProperties()) {
-        if (get_mesh_file() != _cached_mesh_file) { initializeMesh(); }
+        if (get_mesh_file() != _cached_mesh_file) {
+            initializeMesh();
+        } else {
+            updateTriangleMaterialProperties();
+        }
         //_decorative_mesh.reset(
         //  new SimTK::DecorativeMeshFile(_full_mesh_file_path.c_str()));
         _decorative_mesh.reset(new SimTK::DecorativeMesh(getPolygonalMesh()));
@@ -786,7 +790,14 @@ void Smith2018ContactMesh::initializeMesh() {
     // Triangle Material Properties
     if (get_use_variable_thickness()) {
         computeVariableThickness();
-    } else {
+    }
+    updateTriangleMaterialProperties();
+}
+
+void Smith2018ContactMesh::updateTriangleMaterialProperties() {
+    // The variable thickness is computed from the mesh_back_file when the
+    // mesh is loaded.
+    if (!get_use_variable_thickness()) {
         _tri_thickness = get_thickness();
     }
 
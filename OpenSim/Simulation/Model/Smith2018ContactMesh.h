@@ -304,6 +304,10 @@ private:
             SimTK::Array_<int>& child2Indices, int axis);
 
     void computeVariableThickness();
+    // Copy the uniform material properties to each triangle. This does not
+    // reload the mesh, so copies of a model (e.g., the members of a
+    // ForsimEnsembleTool) can change these properties cheaply.
+    void updateTriangleMaterialProperties();
 
     // Member Variables
     SimTK::PolygonalMesh _mesh;
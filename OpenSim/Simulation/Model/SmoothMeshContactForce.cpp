@@ -0,0 +1,267 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  SmoothMeshContactForce.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SmoothMeshContactForce.h"
+
+#include <cmath>
+
+using namespace OpenSim;
+
+namespace {
+// The sum of kernel weights below which the pressure fades to zero.
+constexpr double coverageWeight = 1e-3;
+// Offset of the grid cell indices, so that the packed key is nonnegative.
+constexpr long long cellOffset = 1 << 20;
+} // anonymous namespace
+
+SmoothMeshContactForce::SmoothMeshContactForce() { constructProperties(); }
+
+SmoothMeshContactForce::SmoothMeshContactForce(const std::string& name,
+        const Smith2018ContactMesh& target_mesh,
+        const Smith2018ContactMesh& casting_mesh) {
+    constructProperties();
+    setName(name);
+    connectSocket_target_mesh(target_mesh);
+    connectSocket_casting_mesh(casting_mesh);
+}
+
+void SmoothMeshContactForce::constructProperties() {
+    constructProperty_kernel_radius(0.005);
+    constructProperty_proximity_smoothing(1e-5);
+}
+
+void SmoothMeshContactForce::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    OPENSIM_THROW_IF_FRMOBJ(get_kernel_radius() <= 0, InvalidPropertyValue,
+            getProperty_kernel_radius().getName(),
+            "Expected a positive kernel radius.");
+    OPENSIM_THROW_IF_FRMOBJ(get_proximity_smoothing() <= 0,
+            InvalidPropertyValue, getProperty_proximity_smoothing().getName(),
+            "Expected a positive proximity smoothing.");
+}
+
+void SmoothMeshContactForce::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    const auto& target = getConnectee<Smith2018ContactMesh>("target_mesh");
+    const auto& centers = target.getTriangleCenters();
+    m_targetCells.clear();
+    for (int j = 0; j < target.getNumFaces(); ++j) {
+        int ix, iy, iz;
+        calcCellIndices(centers(j), ix, iy, iz);
+        m_targetCells[calcCellKey(ix, iy, iz)].push_back(j);
+    }
+
+    const int numCasting =
+            getConnectee<Smith2018ContactMesh>("casting_mesh").getNumFaces();
+    ContactInfo info;
+    info.proximity.resize(numCasting);
+    info.pressure.resize(numCasting);
+    this->m_contactInfoCV = addCacheVariable(
+            "contact_info", info, SimTK::Stage::Position);
+}
+
+long long SmoothMeshContactForce::calcCellKey(int ix, int iy, int iz) const {
+    return ((ix + cellOffset) << 42) | ((iy + cellOffset) << 21) |
+           (iz + cellOffset);
+}
+
+void SmoothMeshContactForce::calcCellIndices(
+        const SimTK::Vec3& point, int& ix, int& iy, int& iz) const {
+    const double cellSize = get_kernel_radius();
+    ix = (int)std::floor(point[0] / cellSize);
+    iy = (int)std::floor(point[1] / cellSize);
+    iz = (int)std::floor(point[2] / cellSize);
+}
+
+const SmoothMeshContactForce::ContactInfo&
+SmoothMeshContactForce::getContactInfo(const SimTK::State& state) const {
+    if (isCacheVariableValid(state, m_contactInfoCV)) {
+        return getCacheVariableValue(state, m_contactInfoCV);
+    }
+    ContactInfo& info = updCacheVariableValue(state, m_contactInfoCV);
+    calcContactInfo(state, info);
+    markCacheVariableValid(state, m_contactInfoCV);
+    return info;
+}
+
+void SmoothMeshContactForce::calcContactInfo(
+        const SimTK::State& state, ContactInfo& info) const {
+    const auto& target = getConnectee<Smith2018ContactMesh>("target_mesh");
+    const auto& casting = getConnectee<Smith2018ContactMesh>("casting_mesh");
+
+    // X_TC: from the casting_mesh frame to the target_mesh frame.
+    const SimTK::Transform X_TC = casting.getMeshFrame().findTransformBetween(
+            state, target.getMeshFrame());
+
+    const auto& targetCenters = target.getTriangleCenters();
+    const auto& targetNormals = target.getTriangleNormals();
+    const auto& castingCenters = casting.getTriangleCenters();
+    const auto& castingNormals = casting.getTriangleNormals();
+    const auto& castingAreas = casting.getTriangleAreas();
+
+    const double radius = get_kernel_radius();
+    const double eps2 = SimTK::square(get_proximity_smoothing());
+
+    info.force = SimTK::Vec3(0);
+    info.moment = SimTK::Vec3(0);
+    for (int i = 0; i < casting.getNumFaces(); ++i) {
+        const SimTK::Vec3 p = X_TC.shiftFrameStationToBase(castingCenters(i));
+
+        // Blend the signed distances and material properties of the target
+        // triangles near p.
+        double sumWeights = 0;
+        double sumDistance = 0;
+        double sumThickness = 0;
+        double sumModulus = 0;
+        double sumPoissonsRatio = 0;
+        int ix, iy, iz;
+        calcCellIndices(p, ix, iy, iz);
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    const auto cell = m_targetCells.find(
+                            calcCellKey(ix + dx, iy + dy, iz + dz));
+                    if (cell == m_targetCells.end()) continue;
+                    for (int j : cell->second) {
+                        const SimTK::Vec3 r = p - targetCenters(j);
+                        const double q = r.norm() / radius;
+                        if (q >= 1) continue;
+                        const double w =
+                                SimTK::square(SimTK::square(1 - q)) *
+                                (4 * q + 1);
+                        sumWeights += w;
+                        sumDistance += w * SimTK::dot(targetNormals(j), r);
+                        sumThickness += w * target.getTriangleThickness(j);
+                        sumModulus += w * target.getTriangleElasticModulus(j);
+                        sumPoissonsRatio +=
+                                w * target.getTrianglePoissonsRatio(j);
+                    }
+                }
+            }
+        }
+        if (sumWeights == 0) {
+            info.proximity[i] = 0;
+            info.pressure[i] = 0;
+            continue;
+        }
+
+        const double proximity = -sumDistance / sumWeights;
+        const double coverage = sumWeights / (sumWeights + coverageWeight);
+        const double smoothProximity =
+                0.5 * (proximity + std::sqrt(SimTK::square(proximity) + eps2));
+
+        // Lumped linear elastic foundation (see
+        // Smith2018ArticularContactForce).
+        const double h =
+                casting.getTriangleThickness(i) + sumThickness / sumWeights;
+        const double E = 0.5 * (casting.getTriangleElasticModulus(i) +
+                                       sumModulus / sumWeights);
+        const double v = 0.5 * (casting.getTrianglePoissonsRatio(i) +
+                                       sumPoissonsRatio / sumWeights);
+        const double K = (1 - v) * E / ((1 + v) * (1 - 2 * v));
+        const double pressure = coverage * K * smoothProximity / h;
+
+        info.proximity[i] = proximity;
+        info.pressure[i] = pressure;
+        const SimTK::Vec3 force =
+                -pressure * castingAreas[i] * castingNormals(i);
+        info.force += force;
+        info.moment += SimTK::cross(castingCenters(i), force);
+    }
+}
+
+void SmoothMeshContactForce::computeForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& /*generalizedForces*/) const {
+    const ContactInfo& info = getContactInfo(state);
+    const auto& castingFrame =
+            getConnectee<Smith2018ContactMesh>("casting_mesh").getMeshFrame();
+    const auto& targetFrame =
+            getConnectee<Smith2018ContactMesh>("target_mesh").getMeshFrame();
+
+    // The resultant is applied at the origin of the casting_mesh frame.
+    const SimTK::Rotation& R_GC =
+            castingFrame.getTransformInGround(state).R();
+    const SimTK::Vec3 force = R_GC * info.force;
+    const SimTK::Vec3 moment = R_GC * info.moment;
+    applyForceToPoint(state, castingFrame, SimTK::Vec3(0), force, bodyForces);
+    applyTorque(state, castingFrame, moment, bodyForces);
+
+    const SimTK::Vec3 originInTarget =
+            castingFrame.findStationLocationInAnotherFrame(
+                    state, SimTK::Vec3(0), targetFrame);
+    applyForceToPoint(state, targetFrame, originInTarget, -force, bodyForces);
+    applyTorque(state, targetFrame, -moment, bodyForces);
+}
+
+const SimTK::Vector& SmoothMeshContactForce::getCastingTriangleProximity(
+        const SimTK::State& state) const {
+    return getContactInfo(state).proximity;
+}
+
+const SimTK::Vector& SmoothMeshContactForce::getCastingTrianglePressure(
+        const SimTK::State& state) const {
+    return getContactInfo(state).pressure;
+}
+
+const SimTK::Vec3& SmoothMeshContactForce::getCastingTotalContactForce(
+        const SimTK::State& state) const {
+    return getContactInfo(state).force;
+}
+
+const SimTK::Vec3& SmoothMeshContactForce::getCastingTotalContactMoment(
+        const SimTK::State& state) const {
+    return getContactInfo(state).moment;
+}
+
+OpenSim::Array<std::string> SmoothMeshContactForce::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (const std::string& mesh : {"casting_mesh", "target_mesh"}) {
+        for (const std::string& quantity : {"force", "torque"}) {
+            for (const std::string& axis : {"X", "Y", "Z"}) {
+                labels.append(
+                        getName() + "." + mesh + "." + quantity + "." + axis);
+            }
+        }
+    }
+    return labels;
+}
+
+OpenSim::Array<double> SmoothMeshContactForce::getRecordValues(
+        const SimTK::State& state) const {
+    const ContactInfo& info = getContactInfo(state);
+    const SimTK::Rotation& R_GC =
+            getConnectee<Smith2018ContactMesh>("casting_mesh")
+                    .getMeshFrame()
+                    .getTransformInGround(state)
+                    .R();
+    const SimTK::Vec3 force = R_GC * info.force;
+    const SimTK::Vec3 moment = R_GC * info.moment;
+    OpenSim::Array<double> values(0.0);
+    for (const SimTK::Vec3& vec : {force, moment, SimTK::Vec3(-force),
+                 SimTK::Vec3(-moment)}) {
+        for (int i = 0; i < 3; ++i) values.append(vec[i]);
+    }
+    return values;
+}
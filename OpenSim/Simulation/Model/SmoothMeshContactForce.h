@@ -0,0 +1,194 @@
+#ifndef OPENSIM_SMOOTH_MESH_CONTACT_FORCE_H_
+#define OPENSIM_SMOOTH_MESH_CONTACT_FORCE_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  SmoothMeshContactForce.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Simulation/Model/Force.h"
+#include "Smith2018ContactMesh.h"
+
+#include <unordered_map>
+
+namespace OpenSim {
+
+/** An elastic foundation contact force between two Smith2018ContactMesh%es
+whose force is a smooth function of the poses of the meshes. This component
+is designed for use in gradient-based optimizations, such as MocoStudy with
+MocoCasADiSolver, in which Smith2018ArticularContactForce cannot be used: its
+ray casting assigns each casting triangle to a single target triangle, so its
+forces jump as the contacting target triangles change.
+
+# Proximity
+
+Instead of casting rays, the target_mesh is represented by a smooth implicit
+surface. For the center \f$ p \f$ of each triangle of the casting_mesh, each
+target triangle \f$ j \f$ (with center \f$ c_j \f$ and normal \f$ n_j \f$)
+within kernel_radius \f$ r \f$ of \f$ p \f$ contributes its signed distance
+\f$ n_j \cdot (p - c_j) \f$, weighted by the Wendland kernel
+\f$ w_j = (1 - q)^4 (4q + 1) \f$, with \f$ q = |p - c_j| / r \f$:
+\f[
+    d = -\frac{\sum_j w_j \, n_j \cdot (p - c_j)}{\sum_j w_j}
+\f]
+The kernel and its first two derivatives vanish at \f$ q = 1 \f$, so the
+proximity \f$ d \f$ is twice continuously differentiable as target triangles
+enter and leave the kernel. The kernel_radius should be a few times the edge
+length of the target triangles, and smaller than the radius of curvature of
+the target surface.
+
+# Pressure
+
+The pressure on each casting triangle follows the linear elastic foundation
+model of Smith2018ArticularContactForce with the lumped material properties
+of the casting triangle and the target triangles near it (weighted by the
+kernel):
+\f[
+    P = c \, \frac{(1-\nu)E}{(1+\nu)(1-2\nu)} \frac{\tilde{d}}{h}
+    \qquad
+    \tilde{d} = \frac{1}{2}\left(d + \sqrt{d^2 + \epsilon^2}\right)
+    \qquad
+    c = \frac{\sum_j w_j}{\sum_j w_j + w_0}
+\f]
+where \f$ E \f$ and \f$ \nu \f$ are the mean elastic modulus and Poisson's
+ratio of the two layers, \f$ h \f$ is the sum of their thicknesses, and
+\f$ \epsilon \f$ is the proximity_smoothing. Like SmoothSphereHalfSpaceForce,
+this force is small but not zero when a casting triangle is near but not
+touching the target_mesh, which keeps its derivatives informative. The
+coverage \f$ c \f$ (with \f$ w_0 = 10^{-3} \f$) fades the pressure to zero
+at the edges of the target_mesh.
+
+The force \f$ -P A n \f$ on each casting triangle (with area \f$ A \f$ and
+normal \f$ n \f$) is applied at its center to the casting_mesh, and the
+opposite force is applied at the same point to the target_mesh.
+
+# Performance and thread safety
+
+The target triangles are binned in a uniform grid with the kernel_radius as
+the cell size when the model is built, so each casting triangle is only
+compared with the target triangles in the neighboring cells. The force is
+computed from the state alone and is stored in the cache of the state, so
+copies of the model (e.g., those created by MocoCasADiSolver for its
+parallel evaluation) can be evaluated concurrently. */
+class OSIMSIMULATION_API SmoothMeshContactForce : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(SmoothMeshContactForce, Force);
+
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_PROPERTY(kernel_radius, double,
+            "Radius of the kernel that blends the target triangles into a "
+            "smooth surface. The default value is 0.005 meters.");
+    OpenSim_DECLARE_PROPERTY(proximity_smoothing, double,
+            "Width of the smooth transition of the pressure at zero "
+            "proximity. The default value is 1e-5 meters.");
+
+    //=========================================================================
+    // SOCKETS
+    //=========================================================================
+    OpenSim_DECLARE_SOCKET(target_mesh, Smith2018ContactMesh,
+            "The mesh that is represented by a smooth surface.");
+    OpenSim_DECLARE_SOCKET(casting_mesh, Smith2018ContactMesh,
+            "The mesh whose triangles are pressed by the target_mesh.");
+
+    //=========================================================================
+    // OUTPUTS
+    //=========================================================================
+    OpenSim_DECLARE_OUTPUT(casting_triangle_proximity, SimTK::Vector,
+            getCastingTriangleProximity, SimTK::Stage::Position);
+    OpenSim_DECLARE_OUTPUT(casting_triangle_pressure, SimTK::Vector,
+            getCastingTrianglePressure, SimTK::Stage::Position);
+    OpenSim_DECLARE_OUTPUT(casting_total_contact_force, SimTK::Vec3,
+            getCastingTotalContactForce, SimTK::Stage::Position);
+    OpenSim_DECLARE_OUTPUT(casting_total_contact_moment, SimTK::Vec3,
+            getCastingTotalContactMoment, SimTK::Stage::Position);
+
+    //=========================================================================
+    // METHODS
+    //=========================================================================
+    SmoothMeshContactForce();
+
+    SmoothMeshContactForce(const std::string& name,
+            const Smith2018ContactMesh& target_mesh,
+            const Smith2018ContactMesh& casting_mesh);
+
+    /// The proximity of each triangle of the casting_mesh (positive when
+    /// the triangle penetrates the target_mesh).
+    const SimTK::Vector& getCastingTriangleProximity(
+            const SimTK::State& state) const;
+    /// The pressure on each triangle of the casting_mesh.
+    const SimTK::Vector& getCastingTrianglePressure(
+            const SimTK::State& state) const;
+    /// The resultant force applied to the casting_mesh, expressed in the
+    /// frame of the casting_mesh.
+    const SimTK::Vec3& getCastingTotalContactForce(
+            const SimTK::State& state) const;
+    /// The resultant moment applied to the casting_mesh about the origin of
+    /// its frame, expressed in the frame of the casting_mesh.
+    const SimTK::Vec3& getCastingTotalContactMoment(
+            const SimTK::State& state) const;
+
+    /// Labels of the force (XYZ) and torque (XYZ) applied to the casting_mesh
+    /// frame at its origin, followed by those applied to the target_mesh frame
+    /// at the same point. Forces and torques are expressed in ground.
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+private:
+    void constructProperties();
+
+    struct ContactInfo {
+        SimTK::Vector proximity;
+        SimTK::Vector pressure;
+        SimTK::Vec3 force{0};
+        SimTK::Vec3 moment{0};
+        friend std::ostream& operator<<(
+                std::ostream& o, const ContactInfo&) {
+            o << "SmoothMeshContactForce::ContactInfo should not be "
+                 "serialized!" << std::endl;
+            return o;
+        }
+    };
+    const ContactInfo& getContactInfo(const SimTK::State& state) const;
+    void calcContactInfo(const SimTK::State& state, ContactInfo& info) const;
+
+    // Key of the grid cell that contains the point, in the target_mesh frame.
+    long long calcCellKey(int ix, int iy, int iz) const;
+    void calcCellIndices(const SimTK::Vec3& point, int& ix, int& iy,
+            int& iz) const;
+
+    // The triangles of the target_mesh in each grid cell. This is built in
+    // extendAddToSystem(), after the target_mesh loaded its mesh file.
+    mutable std::unordered_map<long long, std::vector<int>> m_targetCells;
+
+    mutable CacheVariable<ContactInfo> m_contactInfoCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_SMOOTH_MESH_CONTACT_FORCE_H_
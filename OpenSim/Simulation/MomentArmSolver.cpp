@@ -23,6 +23,7 @@
 
 #include "MomentArmSolver.h"
 #include "Model/PointForceDirection.h"
+#include "Model/GeometryPath.h"
 #include "Model/Model.h"
 
 using namespace std;
@@ -132,6 +133,51 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+SimTK::Matrix MomentArmSolver::solve(const State &state,
+        const std::vector<const Coordinate*> &coordinates,
+        const std::vector<const GeometryPath*> &paths) const
+{
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    const SimbodyMatterSubsystem& matter =
+        getModel().getMultibodySystem().getMatterSubsystem();
+    const int nu = s_ma.getNU();
+
+    // compute the coupling between coordinates due to constraints, one
+    // column of C per coordinate
+    Matrix C(nu, (int)coordinates.size());
+    for (int i = 0; i < (int)coordinates.size(); ++i) {
+        C.updCol(i) = computeCouplingVector(s_ma, *coordinates[i]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+    getModel().getMultibodySystem().realize(s_ma, Stage::Position);
+
+    // The mobility forces due to a tension of unity in each path, one column
+    // of F per path
+    Matrix F(nu, (int)paths.size());
+    Vector pathDependentMobilityForces(nu);
+    for (int j = 0; j < (int)paths.size(); ++j) {
+        _bodyForces *= 0;
+        pathDependentMobilityForces = 0;
+        paths[j]->addInEquivalentForces(s_ma, 1.0, _bodyForces,
+            pathDependentMobilityForces);
+
+        // f = ~J(q) * F (no dynamics required)
+        matter.multiplyBySystemJacobianTranspose(s_ma, _bodyForces,
+            _generalizedForces);
+        F.updCol(j) = _generalizedForces + pathDependentMobilityForces;
+    }
+
+    // Moment-arm of each path about each coordinate is the effective torque
+    // at the coordinate, including the generalized forces acting on the
+    // coordinates coupled to it via constraint.
+    return ~C*F;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
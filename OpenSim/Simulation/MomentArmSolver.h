@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <vector>
+
 namespace OpenSim {
 
 class GeometryPath;
@@ -83,6 +85,22 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Solve for the effective moment-arms of several GeometryPaths about
+        several coordinates. The constraint coupling vector is computed once
+        per coordinate and the generalized forces of a unit tension are
+        computed once per path, so the cost grows with the number of
+        coordinates plus the number of paths, rather than with their product.
+        The moment-arms are the product of the two.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @return ma                  resulting moment-arms with one row per
+                                coordinate and one column per path
+    */
+    SimTK::Matrix solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const;
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -47,6 +47,7 @@
 #include "Model/ContactSphere.h"
 #include "Model/Smith2018ContactMesh.h"
 #include "Model/Smith2018ArticularContactForce.h"
+#include "Model/SmoothMeshContactForce.h"
 #include "Model/ContactSphere.h"
 #include "Model/CoordinateLimitForce.h"
 #include "Model/CoordinateSet.h"
@@ -262,6 +263,7 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( ElasticFoundationForce::ContactParametersSet() );
     Object::registerType(Smith2018ContactMesh());
     Object::registerType(Smith2018ArticularContactForce());
+    Object::registerType(SmoothMeshContactForce());
 
     Object::registerType( Ligament() );
     Object::registerType( Blankevoort1991Ligament() );
@@ -0,0 +1,104 @@
+#ifndef OPENSIM_CONTACT_MESHES_FOR_TESTING_H_
+#define OPENSIM_CONTACT_MESHES_FOR_TESTING_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  ContactMeshesForTesting.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** This file contains a plate and block model for the tests of contact
+ * between Smith2018ContactMeshes, and exists only for use in tests. */
+
+#include <OpenSim/Simulation/osimSimulation.h>
+
+#include <fstream>
+#include <string>
+
+// Write a flat, square n x n grid of quads (two triangles each) in the
+// x-z plane to a Wavefront .obj file, with the triangle normals along +y
+// if faceUp is true and along -y otherwise.
+inline void writePlateMesh(const std::string& fileName, int n, double halfWidth,
+        bool faceUp) {
+    std::ofstream out(fileName);
+    const double step = 2 * halfWidth / n;
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= n; ++j) {
+            out << "v " << -halfWidth + i * step << " 0 "
+                << -halfWidth + j * step << "\n";
+        }
+    }
+    auto index = [n](int i, int j) { return i * (n + 1) + j + 1; };
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            const int a = index(i, j);
+            const int b = index(i + 1, j);
+            const int c = index(i + 1, j + 1);
+            const int d = index(i, j + 1);
+            if (faceUp) {
+                out << "f " << a << " " << c << " " << b << "\n";
+                out << "f " << a << " " << d << " " << c << "\n";
+            } else {
+                out << "f " << a << " " << b << " " << c << "\n";
+                out << "f " << a << " " << c << " " << d << "\n";
+            }
+        }
+    }
+}
+
+// The components added by addPlateAndBlock().
+struct PlateAndBlock {
+    OpenSim::Body* block;
+    OpenSim::Smith2018ContactMesh* plate;
+    OpenSim::Smith2018ContactMesh* blockMesh;
+};
+
+// Add a 4 x 4 cm plate ("plate") fixed to ground, with its cartilage facing
+// up, and a body ("block") with a 2 x 2 cm cartilage mesh
+// ("block_cartilage") facing down, to the model. Both meshes are in the x-z
+// plane of their frames, have 2 mm of cartilage with an elastic modulus of
+// 5 MPa, and are written to <prefix>_plate.obj and <prefix>_block.obj. The
+// caller adds the joint of the block and the contact force.
+inline PlateAndBlock addPlateAndBlock(OpenSim::Model& model,
+        const std::string& prefix, int plateResolution, double blockMass,
+        const SimTK::Vec3& blockMeshLocation = SimTK::Vec3(0)) {
+    using namespace OpenSim;
+    writePlateMesh(prefix + "_plate.obj", plateResolution, 0.02, true);
+    writePlateMesh(prefix + "_block.obj", 10, 0.01, false);
+
+    PlateAndBlock components;
+    components.block = new OpenSim::Body("block", blockMass, SimTK::Vec3(0),
+            SimTK::Inertia(0.001));
+    model.addBody(components.block);
+
+    components.plate = new Smith2018ContactMesh("plate",
+            prefix + "_plate.obj", model.getGround());
+    components.blockMesh = new Smith2018ContactMesh("block_cartilage",
+            prefix + "_block.obj", *components.block, blockMeshLocation,
+            SimTK::Vec3(0));
+    for (auto* mesh : {components.plate, components.blockMesh}) {
+        mesh->set_thickness(0.002);
+        mesh->set_elastic_modulus(5e6);
+        mesh->set_poissons_ratio(0.45);
+    }
+    model.addContactGeometry(components.plate);
+    model.addContactGeometry(components.blockMesh);
+    return components;
+}
+
+#endif // OPENSIM_CONTACT_MESHES_FOR_TESTING_H_
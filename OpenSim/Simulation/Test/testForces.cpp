@@ -37,18 +37,22 @@
 //     11. ExpressionBasedPointToPointForce
 //     12. ExpressionBasedBushingForce
 //     13. Blankevoort1991Ligament
+//     14. SmoothMeshContactForce
 //
 //     Add tests here as Forces are added to OpenSim
 //
 //==============================================================================
 #include "SimTKcommon/internal/Xml.h"
 #include <ctime> // clock(), clock_t, CLOCKS_PER_SEC
+#include <fstream>
 
 #include <OpenSim/Analyses/osimAnalyses.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <catch2/catch_all.hpp>
 
+#include "ContactMeshesForTesting.h"
+
 using namespace OpenSim;
 using namespace std;
 
@@ -1350,6 +1354,137 @@ TEST_CASE("testSmoothSphereHalfSpaceForce") {
     ASSERT(isEqual);
 }
 
+// A square plate on a vertical slider is pressed into a larger plate fixed to
+// ground. The pressure is uniform, so the contact force follows from the
+// elastic foundation model, and it must be a smooth function of the depth.
+TEST_CASE("testSmoothMeshContactForce") {
+    Model model;
+    const PlateAndBlock plateAndBlock =
+            addPlateAndBlock(model, "testSmoothMeshContactForce", 20, 1.0);
+    // Rotate the slider axis from x to y.
+    const SimTK::Vec3 orientation(0, 0, 0.5 * SimTK::Pi);
+    auto* slider = new SliderJoint("slider", model.getGround(), SimTK::Vec3(0),
+            orientation, *plateAndBlock.block, SimTK::Vec3(0), orientation);
+    model.addJoint(slider);
+    auto* contact = new SmoothMeshContactForce("contact",
+            *plateAndBlock.plate, *plateAndBlock.blockMesh);
+    model.addForce(contact);
+    const double E = plateAndBlock.plate->get_elastic_modulus();
+    const double v = plateAndBlock.plate->get_poissons_ratio();
+    const double thickness = plateAndBlock.plate->get_thickness();
+
+    SimTK::State& state = model.initSystem();
+    const Coordinate& coord = slider->getCoordinate();
+    auto calcForce = [&](double height) {
+        coord.setValue(state, height, false);
+        model.realizePosition(state);
+        return contact->getCastingTotalContactForce(state);
+    };
+
+    const double K = (1 - v) * E / ((1 + v) * (1 - 2 * v));
+    const double h = 2 * thickness;
+    const double area = 0.02 * 0.02;
+    const double depth = 2e-4;
+
+    SECTION("Uniform pressure") {
+        const SimTK::Vec3 force = calcForce(-depth);
+        CHECK(force[1] == Catch::Approx(K * depth / h * area).epsilon(1e-3));
+        CHECK(force[0] == Catch::Approx(0).margin(1e-8 * force[1]));
+        CHECK(force[2] == Catch::Approx(0).margin(1e-8 * force[1]));
+        const SimTK::Vector& proximity =
+                contact->getCastingTriangleProximity(state);
+        for (int i = 0; i < proximity.size(); ++i) {
+            CHECK(proximity[i] == Catch::Approx(depth));
+        }
+        // The force and torque on the plate balance those on the block.
+        Array<double> values = contact->getRecordValues(state);
+        REQUIRE(values.getSize() == 12);
+        for (int i = 0; i < 6; ++i) {
+            CHECK(values[i] == Catch::Approx(-values[6 + i]));
+        }
+    }
+
+    SECTION("Smooth force") {
+        // The force is small but positive at zero depth, and is zero once the
+        // block is farther than the kernel radius from the plate.
+        const double smoothing = contact->get_proximity_smoothing();
+        CHECK(calcForce(0)[1] ==
+                Catch::Approx(0.5 * K * smoothing / h * area).epsilon(1e-3));
+        CHECK(calcForce(2 * contact->get_kernel_radius())[1] == 0);
+
+        // The stiffness from finite differences does not depend on the step
+        // size.
+        for (double height : {-depth, 0.0}) {
+            auto stiffness = [&](double step) {
+                return (calcForce(height - step)[1] -
+                               calcForce(height + step)[1]) /
+                       (2 * step);
+            };
+            CHECK(stiffness(1e-7) ==
+                    Catch::Approx(stiffness(1e-8)).epsilon(1e-3));
+        }
+        CHECK(calcForce(-depth)[1] > calcForce(-0.5 * depth)[1]);
+    }
+
+    SECTION("Copy") {
+        std::unique_ptr<SmoothMeshContactForce> copy(contact->clone());
+        CHECK(*copy == *contact);
+    }
+}
+
+// The block slides sideways over the plate at a constant depth, so that the
+// centers of its triangles cross the edges of the triangles of the plate. The
+// contact area does not change, so neither does the force.
+TEST_CASE("testSmoothMeshContactForceSliding") {
+    Model model;
+    const PlateAndBlock plateAndBlock = addPlateAndBlock(
+            model, "testSmoothMeshContactForceSliding", 20, 1.0);
+    auto* planar = new PlanarJoint("planar", model.getGround(),
+            *plateAndBlock.block);
+    model.addJoint(planar);
+    auto* contact = new SmoothMeshContactForce("contact",
+            *plateAndBlock.plate, *plateAndBlock.blockMesh);
+    model.addForce(contact);
+
+    SimTK::State& state = model.initSystem();
+    const double depth = 2e-4;
+    planar->getCoordinate(PlanarJoint::Coord::TranslationY)
+            .setValue(state, -depth, false);
+    const Coordinate& tx =
+            planar->getCoordinate(PlanarJoint::Coord::TranslationX);
+    auto calcForce = [&](double x) {
+        tx.setValue(state, x, false);
+        model.realizePosition(state);
+        return contact->getCastingTotalContactForce(state);
+    };
+
+    // The triangles of both meshes are 2 mm wide; sliding 5 mm in steps that
+    // are not a fraction of 2 mm crosses each edge at a different offset.
+    const SimTK::Vec3 reference = calcForce(0);
+    REQUIRE(reference[1] > 0);
+    for (double x = -0.005; x <= 0.005; x += 0.00013) {
+        CAPTURE(x);
+        const SimTK::Vec3 force = calcForce(x);
+        CHECK(force[1] == Catch::Approx(reference[1]).epsilon(1e-3));
+        CHECK(force[0] == Catch::Approx(0).margin(1e-8 * force[1]));
+        CHECK(force[2] == Catch::Approx(0).margin(1e-8 * force[1]));
+        const SimTK::Vector& proximity =
+                contact->getCastingTriangleProximity(state);
+        for (int i = 0; i < proximity.size(); ++i) {
+            CHECK(proximity[i] == Catch::Approx(depth));
+        }
+    }
+
+    // The force is flat both where the edges of the meshes line up (0 and
+    // 2 mm) and where they are half a triangle apart (1 mm).
+    for (double x : {0.0, 0.001, 0.002}) {
+        CAPTURE(x);
+        const double dFdx =
+                (calcForce(x + 1e-7)[1] - calcForce(x - 1e-7)[1]) / 2e-7;
+        CHECK(std::abs(dFdx) < 1e-6 * reference[1] / depth);
+    }
+}
+
 TEST_CASE("testCoordinateLimitForce") {
     using namespace SimTK;
 
@@ -31,6 +31,7 @@
 #include <OpenSim/Simulation/BufferedOrientationsReference.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/LinearFunction.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <random>
 
@@ -82,6 +83,10 @@ void testUpdateMarkerWeights();
 // Verify that the track() solution is also effected by updating marker
 // weights and marker error is being reduced as its weighting increases.
 void testTrackWithUpdateMarkerWeights();
+// Verify that track() with the Levenberg-Marquardt solver finds the same
+// solution as the SimTK::Assembler, and holds locked and prescribed
+// coordinates.
+void testTrackWithLevenbergMarquardt();
 
 // Verify that solver does not confuse/mismanage markers when reference
 // has more markers than the model, order is changed or marker reference
@@ -118,6 +123,11 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testTrackWithUpdateMarkerWeights");
     }
+    try { testTrackWithLevenbergMarquardt(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackWithLevenbergMarquardt");
+    }
 
     try { testNumberOfMarkersMismatch(); }
     catch (const std::exception& e) {
@@ -576,6 +586,123 @@ void testTrackWithUpdateMarkerWeights()
     }
 }
 
+void testTrackWithLevenbergMarquardt()
+{
+    cout << "\ntestInverseKinematicsSolver::testTrackWithLevenbergMarquardt()"
+         << endl;
+    // Hang an arm from the pendulum with a GimbalJoint, whose qdot != u.
+    std::unique_ptr<Model> model{ constructPendulumWithMarkers() };
+    Body* arm = new Body("arm", 1.0, SimTK::Vec3(0),
+            SimTK::Inertia::sphere(0.05));
+    model->addBody(arm);
+    GimbalJoint* shoulder = new GimbalJoint("shoulder",
+            model->getBodySet().get("ball"), SimTK::Vec3(0), SimTK::Vec3(0),
+            *arm, SimTK::Vec3(0, 0.3, 0), SimTK::Vec3(0));
+    model->addJoint(shoulder);
+    const SimTK::Vec3 armMarkers[] = {SimTK::Vec3(0.1, 0, 0),
+            SimTK::Vec3(0, -0.2, 0), SimTK::Vec3(0, 0, 0.1)};
+    for (int k = 0; k < 3; ++k) {
+        Marker* marker = new Marker();
+        marker->setName("arm" + std::to_string(k));
+        marker->setParentFrame(*arm);
+        marker->set_location(armMarkers[k]);
+        model->addMarker(marker);
+    }
+
+    SimTK::State state = model->initSystem();
+    const CoordinateSet& coords = model->getCoordinateSet();
+    StatesTrajectory states;
+    double dt = 0.01;
+    for (int i = 0; i < 101; ++i) {
+        const double t = i * dt;
+        state.updTime() = t;
+        coords[0].setValue(state, 0.5 * sin(2 * SimTK::Pi * t), false);
+        coords[1].setValue(state, 0.3 * sin(SimTK::Pi * t), false);
+        coords[2].setValue(state, 0.2 * cos(SimTK::Pi * t), false);
+        coords[3].setValue(state, 0.1 * t);
+        states.append(state);
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> biases(6, SimTK::Vec3(0));
+    std::shared_ptr<MarkersReference> markersRef(
+            new MarkersReference(generateMarkerDataFromModelAndStates(
+                    *model, states, biases, 0.005), Set<MarkerWeight>()));
+    for (const auto& name : markersRef->getNames()) {
+        markersRef->updMarkerWeightSet().adoptAndAppend(
+                new MarkerWeight(name, name == "m0" ? 10.0 : 1.0));
+    }
+
+    // Track all frames with both solvers from the same initial state, and
+    // compare the solutions and the marker errors.
+    const auto compareSolvers = [&](Model& m, SimTK::State& sAssembler) {
+        SimTK::State sLM = sAssembler;
+        const Coordinate& lastCoord = m.getCoordinateSet()[3];
+        const double lockedValue = lastCoord.getValue(sAssembler);
+        const bool locked = lastCoord.getLocked(sAssembler);
+        const bool prescribed = lastCoord.isPrescribed(sAssembler);
+
+        SimTK::Array_<CoordinateReference> coordRefs;
+        InverseKinematicsSolver assembler(m, markersRef, coordRefs);
+        assembler.setAccuracy(1e-8);
+        assembler.assemble(sAssembler);
+        InverseKinematicsSolver solverLM(m, markersRef, coordRefs);
+        solverLM.setAccuracy(1e-8);
+        solverLM.setUseLevenbergMarquardt(true);
+        solverLM.assemble(sLM);
+
+        SimTK::Array_<double> errors, errorsLM;
+        for (unsigned i = 0; i < markersRef->getNumFrames(); ++i) {
+            sAssembler.updTime() = sLM.updTime() = i * dt;
+            assembler.track(sAssembler);
+            solverLM.track(sLM);
+
+            for (int k = 0; k < sLM.getNQ(); ++k) {
+                SimTK_ASSERT_ALWAYS(
+                        abs(sAssembler.getQ()[k] - sLM.getQ()[k]) <= 1e-5,
+                        "Levenberg-Marquardt solution differs from that of "
+                        "the SimTK::Assembler.");
+            }
+            if (locked) {
+                SimTK_ASSERT_ALWAYS(lastCoord.getValue(sLM) == lockedValue,
+                        "Levenberg-Marquardt solver changed a locked "
+                        "coordinate.");
+            }
+            if (prescribed) {
+                SimTK_ASSERT_ALWAYS(abs(lastCoord.getValue(sLM) -
+                                            0.1 * sLM.getTime()) <= 1e-12,
+                        "Levenberg-Marquardt solver did not follow the "
+                        "function of a prescribed coordinate.");
+            }
+            // The marker errors are reported for the Levenberg-Marquardt
+            // solution.
+            assembler.computeCurrentMarkerErrors(errors);
+            solverLM.computeCurrentMarkerErrors(errorsLM);
+            for (unsigned j = 0; j < errors.size(); ++j) {
+                SimTK_ASSERT_ALWAYS(abs(errors[j] - errorsLM[j]) <= 1e-5,
+                        "Levenberg-Marquardt marker error differs from that "
+                        "of the SimTK::Assembler.");
+            }
+        }
+    };
+
+    for (bool lock : {false, true}) {
+        SimTK::State s = model->initSystem();
+        coords[3].setValue(s, 0.05);
+        coords[3].setLocked(s, lock);
+        compareSolvers(*model, s);
+    }
+
+    // Prescribe the last coordinate with the function used to generate the
+    // marker data.
+    Model prescribedModel(*model);
+    prescribedModel.finalizeFromProperties();
+    Coordinate& prescribedCoord = prescribedModel.updCoordinateSet()[3];
+    prescribedCoord.setPrescribedFunction(LinearFunction(0.1, 0));
+    prescribedCoord.setDefaultIsPrescribed(true);
+    SimTK::State s = prescribedModel.initSystem();
+    compareSolvers(prescribedModel, s);
+}
+
 void testNumberOfMarkersMismatch()
 {
     cout << 
@@ -56,6 +56,10 @@ void testMomentArmDefinitionForModel(const string &filename,
 
 void testMomentArmsAcrossCompoundJoint();
 
+// The moment arms of all muscles about all coordinates computed together by
+// the MomentArmSolver must match those computed one at a time.
+void testBatchedMomentArms(const string& filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -67,6 +71,10 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testBatchedMomentArms("testMomentArmsConstraintB.osim");
+        testBatchedMomentArms("gait2354_simbody.osim");
+        cout << "Batched moment arms: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -269,6 +277,50 @@ SimTK::Vector computeGenForceScaling(const Model &osimModel, const SimTK::State
 //==========================================================================================================
 // Main test driver can be used on any model so test cases should be very easy to add
 //==========================================================================================================
+void testBatchedMomentArms(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+    const auto& muscles = model.getMuscles();
+
+    std::vector<const Coordinate*> coords;
+    for (int i = 0; i < coordSet.getSize(); ++i) {
+        coords.push_back(&coordSet[i]);
+    }
+    std::vector<const GeometryPath*> paths;
+    for (int j = 0; j < muscles.getSize(); ++j) {
+        paths.push_back(&muscles[j].getPath<GeometryPath>());
+    }
+
+    MomentArmSolver maSolver(model);
+    // Default pose, and a pose with all coordinates near the middle of their
+    // range.
+    for (int pose = 0; pose < 2; ++pose) {
+        if (pose == 1) {
+            for (const Coordinate* coord : coords) {
+                if (coord->getLocked(s)) continue;
+                coord->setValue(s, 0.6 * coord->getRangeMin() +
+                                   0.4 * coord->getRangeMax(), false);
+            }
+            model.assemble(s);
+        }
+        model.realizePosition(s);
+
+        const SimTK::Matrix ma = maSolver.solve(s, coords, paths);
+        ASSERT(ma.nrow() == (int)coords.size());
+        ASSERT(ma.ncol() == (int)paths.size());
+        for (int i = 0; i < (int)coords.size(); ++i) {
+            for (int j = 0; j < (int)paths.size(); ++j) {
+                ASSERT_EQUAL(paths[j]->computeMomentArm(s, *coords[i]),
+                        ma(i, j), 1e-10, __FILE__, __LINE__,
+                        "Batched moment arm of " + muscles[j].getName() +
+                        " about " + coords[i]->getName() + " differs.");
+            }
+        }
+    }
+}
+
 void testMomentArmDefinitionForModel(const string &filename, const string &coordName, 
                                     const string &muscleName, SimTK::Vec2 rom,
                                     double mass, string errorMessage)
@@ -45,6 +45,7 @@
 #include "Model/ContactSphere.h"
 #include "Model/Smith2018ContactMesh.h"
 #include "Model/Smith2018ArticularContactForce.h"
+#include "Model/SmoothMeshContactForce.h"
 #include "Model/CoordinateSet.h"
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
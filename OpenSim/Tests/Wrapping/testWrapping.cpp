@@ -34,6 +34,7 @@ using namespace SimTK;
 using namespace std;
 using OpenSim::TimeSeriesTable;
 using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
 
 // HELPER FUNCTIONS
 namespace {
@@ -414,6 +415,66 @@ TEST_CASE("testFunctionBasedPath") {
             WithinAbs(path.getLengtheningSpeed(state), tol));
         CHECK_THAT(genForce, WithinAbs(residuals[0], tol));
     }
+
+    SECTION("Sliding point mass, Blankevoort1991Ligament") {
+        // 1-DOF polynomial surrogate for a ligament path.
+        // length = q^3 + 2*q^2 + 3*q + 4
+        PolynomialFunction poly(createVector({1.0, 2.0, 3.0, 4.0}));
+
+        // The ligament is stretched into the linear region and lengthening,
+        // so both the spring and damping forces are active.
+        const double stiffness = 100.0;
+        const double slackLength = 4.0;
+        const double damping = 0.5;
+        const double length = q_x*q_x*q_x + 2*q_x*q_x + 3*q_x + 4;
+        const double momentArm = -3*q_x*q_x - 4*q_x - 3;
+        const double speed = -qdot_x * momentArm;
+        const double strain = length / slackLength - 1.0;
+        const double strainRate = speed / slackLength;
+        const double transitionStrain = 0.06;
+        REQUIRE(strain > transitionStrain);
+        const double force = stiffness * (strain - 0.5 * transitionStrain) +
+                             damping * strainRate;
+        const double genForce = force * momentArm;
+
+        Model model = ModelFactory::createSlidingPointMass();
+        model.setGravity(SimTK::Vec3(0.0));
+
+        FunctionBasedPath fbPath;
+        fbPath.setName("polynomial_path_1dof");
+        fbPath.setLengthFunction(poly);
+        fbPath.setCoordinatePaths({"/slider/position"});
+
+        auto* lig = new Blankevoort1991Ligament("ligament", stiffness,
+                slackLength);
+        lig->set_path(fbPath);
+        lig->set_transition_strain(transitionStrain);
+        lig->set_damping_coefficient(damping);
+        model.addComponent(lig);
+        model.finalizeConnections();
+
+        SimTK::State state = model.initSystem();
+        model.getCoordinateSet()[0].setValue(state, q_x);
+        model.getCoordinateSet()[0].setSpeedValue(state, qdot_x);
+        model.realizeAcceleration(state);
+
+        auto& matter = model.updMatterSubsystem();
+        SimTK::Vector residuals(1, 0.0);
+        matter.calcResidualForce(state,
+                createVector({0.0}),
+                SimTK::Vector_<SimTK::SpatialVec>(2,
+                    SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0))),
+                state.getUDot(),
+                SimTK::Vector(0),
+                residuals);
+
+        const double tol = 10 * state.getNU() * SimTK::Test::defTol<double>();
+        CHECK_THAT(length, WithinAbs(lig->getLength(state), tol));
+        CHECK_THAT(speed, WithinAbs(lig->getLengtheningSpeed(state), tol));
+        CHECK_THAT(strain, WithinAbs(lig->getStrain(state), tol));
+        CHECK_THAT(force, WithinRel(lig->getTotalForce(state), tol));
+        CHECK_THAT(genForce, WithinRel(residuals[0], tol));
+    }
     
     SECTION("Planar point mass, length function") {
         // 2-DOF polynomial path function.
@@ -0,0 +1,139 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testWrappingAllocations.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Checks that GeometryPath::computePath() does not touch the heap once its
+// wrapping buffers have grown to fit the configurations being evaluated, and
+// reports the average time per path evaluation for the shoulder model.
+
+#include <OpenSim/OpenSim.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+using namespace OpenSim;
+
+namespace {
+    // Counts calls to the replaceable global allocation functions while
+    // `countingEnabled` is true. On platforms where shared libraries do not
+    // resolve `operator new` through the executable (e.g., Windows DLLs),
+    // allocations made inside the OpenSim libraries are simply not counted.
+    std::atomic<bool> countingEnabled{false};
+    std::atomic<long long> numAllocations{0};
+
+    void* countedAlloc(std::size_t size) {
+        if (countingEnabled.load(std::memory_order_relaxed)) {
+            numAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (void* ptr = std::malloc(size == 0 ? 1 : size)) { return ptr; }
+        throw std::bad_alloc();
+    }
+
+    class AllocationCounter {
+    public:
+        AllocationCounter() {
+            numAllocations = 0;
+            countingEnabled = true;
+        }
+        ~AllocationCounter() { countingEnabled = false; }
+        long long stop() {
+            countingEnabled = false;
+            return numAllocations.load();
+        }
+    };
+
+    // Evaluate the length of every GeometryPath in the model for each of the
+    // given coordinate configurations. Only the path computations (not the
+    // realization of the multibody system) are counted.
+    long long evaluatePaths(const Model& model, SimTK::State& state,
+            const std::vector<SimTK::Vector>& configurations,
+            double& sumOfLengths, int& numEvaluations) {
+        std::vector<const GeometryPath*> paths;
+        for (const auto& path : model.getComponentList<GeometryPath>()) {
+            paths.push_back(&path);
+        }
+
+        long long allocations = 0;
+        sumOfLengths = 0;
+        numEvaluations = 0;
+        for (const auto& q : configurations) {
+            state.updQ() = q;
+            model.realizePosition(state);
+            AllocationCounter counter;
+            for (const auto* path : paths) {
+                sumOfLengths += path->getLength(state);
+                ++numEvaluations;
+            }
+            allocations += counter.stop();
+        }
+        return allocations;
+    }
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+TEST_CASE("GeometryPath wrapping does not allocate in steady state") {
+    Model model("TestShoulderWrapping.osim");
+    SimTK::State state = model.initSystem();
+
+    // Sample configurations around the default pose so that different wrap
+    // objects become active (or inactive) between evaluations.
+    const SimTK::Vector q0 = state.getQ();
+    SimTK::Random::Uniform random(-0.5, 0.5);
+    random.setSeed(0);
+    std::vector<SimTK::Vector> configurations;
+    for (int i = 0; i < 50; ++i) {
+        SimTK::Vector q = q0;
+        for (int j = 0; j < q.size(); ++j) { q[j] += random.getValue(); }
+        configurations.push_back(q);
+    }
+
+    // The first pass grows the wrapping buffers (and the cache variables in
+    // the state) to fit these configurations.
+    double warmupSum = 0;
+    int numEvaluations = 0;
+    evaluatePaths(model, state, configurations, warmupSum, numEvaluations);
+    REQUIRE(numEvaluations > 0);
+
+    // Revisiting the same configurations must reproduce the same lengths
+    // without any heap allocation.
+    const double start = SimTK::realTime();
+    double steadySum = 0;
+    const long long allocations = evaluatePaths(
+            model, state, configurations, steadySum, numEvaluations);
+    const double elapsed = SimTK::realTime() - start;
+
+    log_info("GeometryPath::getLength(): {} evaluations, {} us/evaluation "
+             "(including realizePosition()), {} allocations.",
+            numEvaluations, 1e6 * elapsed / numEvaluations, allocations);
+
+    CHECK(steadySum == Catch::Approx(warmupSum));
+    CHECK(allocations == 0);
+}
@@ -28,8 +28,10 @@
 #include "IKCoordinateTask.h"
 #include "IKMarkerTask.h"
 #include "IKTaskSet.h"
+#include "ParallelInverseKinematics.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -86,6 +88,8 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_num_threads(1);
+    constructProperty_use_levenberg_marquardt(false);
 }
 
 //=============================================================================
@@ -156,6 +160,10 @@ bool InverseKinematicsTool::run()
         SimTK_ASSERT2_ALWAYS(final_time >= start_time,
             "InverseKinematicsTool final time (%f) is before start time (%f).",
             final_time, start_time);
+        OPENSIM_THROW_IF_FRMOBJ(get_num_threads() < 1, Exception,
+                "Expected 'num_threads' to be at least 1, but got {}.",
+                get_num_threads());
+        const int numThreads = std::min(get_num_threads(), getMaxNumThreads());
 
         const auto& markersTable = markersReference.getMarkerTable();
         const int start_ix = int(
@@ -169,6 +177,7 @@ bool InverseKinematicsTool::run()
         InverseKinematicsSolver ikSolver(*_model, make_shared<MarkersReference>(markersReference),
             coordinateReferences, get_constraint_weight());
         ikSolver.setAccuracy(get_accuracy());
+        ikSolver.setUseLevenbergMarquardt(get_use_levenberg_marquardt());
         s.updTime() = times[start_ix];
         ikSolver.assemble(s);
         kinematicsReporter->begin(s);
@@ -189,9 +198,26 @@ bool InverseKinematicsTool::run()
 
         Stopwatch watch;
 
+        // With multiple threads, solve all frames first, then report them in
+        // order as if they had been solved here.
+        const bool parallel = numThreads > 1;
+        InverseKinematicsFrames frames;
+        if (parallel) {
+            frames = solveInverseKinematicsFrames(*_model, markersReference,
+                    coordinateReferences, get_constraint_weight(),
+                    get_accuracy(), start_ix, final_ix, numThreads,
+                    get_report_errors(), get_report_marker_locations(),
+                    get_use_levenberg_marquardt());
+        }
+
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
-            ikSolver.track(s);
+            if (parallel) {
+                s.updQ() = ~frames.q[i - start_ix];
+                _model->realizePosition(s);
+            } else {
+                ikSolver.track(s);
+            }
             // show progress line every 1000 frames so users see progress
             if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
                 log_info("Solved {} frame(s)...", i - start_ix);
@@ -201,7 +227,14 @@ bool InverseKinematicsTool::run()
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+                if (parallel) {
+                    for (int j = 0; j < nm; ++j)
+                        squaredMarkerErrors[j] =
+                                frames.squaredMarkerErrors(i - start_ix, j);
+                } else {
+                    ikSolver.computeCurrentSquaredMarkerErrors(
+                            squaredMarkerErrors);
+                }
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -224,11 +257,14 @@ bool InverseKinematicsTool::run()
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
+                if (!parallel)
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
-                        locations.set(3*j+k, markerLocations[j][k]);
+                        locations.set(3*j+k, parallel ?
+                                frames.markerLocations(i - start_ix, 3*j+k) :
+                                markerLocations[j][k]);
                 }
 
                 modelMarkerLocations->append(s.getTime(), 3*nm, &locations[0]);
@@ -71,6 +71,22 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to solve the frames. With 1 (the default), "
+            "the frames are solved in sequence, each one starting from the "
+            "solution of the previous frame. With more threads, the trial is "
+            "split into contiguous blocks of frames that are solved "
+            "concurrently on copies of the model, each block starting from "
+            "an assembly of its first frame. The number of threads is "
+            "limited by the OPENSIM_MAX_THREADS environment variable, if set.");
+
+    OpenSim_DECLARE_PROPERTY(use_levenberg_marquardt, bool,
+            "Flag indicating whether the frames after the first one of each "
+            "sequence are solved with a Levenberg-Marquardt solver with an "
+            "analytic Jacobian of the marker errors, which is faster for "
+            "large marker sets (see InverseKinematicsSolver). "
+            "The default value is false.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -100,6 +116,16 @@ public:
         return get_coordinate_file();
     };
 
+    void setNumThreads(int numThreads) { upd_num_threads() = numThreads; }
+    int getNumThreads() const { return get_num_threads(); }
+
+    void setUseLevenbergMarquardt(bool useLevenbergMarquardt) {
+        upd_use_levenberg_marquardt() = useLevenbergMarquardt;
+    }
+    bool getUseLevenbergMarquardt() const {
+        return get_use_levenberg_marquardt();
+    }
+
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
     //--------------------------------------------------------------------------
@@ -0,0 +1,182 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  ParallelInverseKinematics.cpp                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ParallelInverseKinematics.h"
+
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <exception>
+#include <future>
+
+using namespace OpenSim;
+
+namespace {
+
+// Solve frames [begin, end) of the marker table on a copy of the model, and
+// write the results to rows [begin - offset, end - offset) of the matrices.
+void solveBlock(Model model, MarkersReference markersReference,
+        SimTK::Array_<CoordinateReference> coordinateReferences,
+        double constraintWeight, double accuracy,
+        bool useLevenbergMarquardt, int maxAssemblyAttempts, int begin,
+        int end, int offset, int thread, int numThreads,
+        InverseKinematicsFrames& frames) {
+    model.setUseVisualizer(false);
+    SimTK::State& s = model.initSystem();
+
+    const auto& times =
+            markersReference.getMarkerTable().getIndependentColumn();
+    log_info("Thread {:2d}/{:2d}: solving frames {}-{} "
+             "(t = {:1.3f}-{:1.3f} s)...",
+            thread + 1, numThreads, begin, end - 1, times[begin],
+            times[end - 1]);
+
+    InverseKinematicsSolver ikSolver(model,
+            std::make_shared<MarkersReference>(markersReference),
+            coordinateReferences, constraintWeight);
+    ikSolver.setAccuracy(accuracy);
+    ikSolver.setUseLevenbergMarquardt(useLevenbergMarquardt);
+    s.updTime() = times[begin];
+    if (maxAssemblyAttempts > 0) {
+        assembleInverseKinematicsFrame(ikSolver, s, maxAssemblyAttempts);
+    } else {
+        ikSolver.assemble(s);
+    }
+
+    const int nm = ikSolver.getNumMarkersInUse();
+    SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
+    SimTK::Array_<SimTK::Vec3> markerLocations(nm, SimTK::Vec3(0));
+    const bool reportErrors = frames.squaredMarkerErrors.ncol() > 0;
+    const bool reportMarkerLocations = frames.markerLocations.ncol() > 0;
+
+    for (int i = begin; i < end; ++i) {
+        s.updTime() = times[i];
+        ikSolver.track(s);
+
+        const int row = i - offset;
+        for (int k = 0; k < s.getNQ(); ++k) {
+            frames.q(row, k) = s.getQ()[k];
+        }
+        if (reportErrors) {
+            ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+            for (int j = 0; j < nm; ++j) {
+                frames.squaredMarkerErrors(row, j) = squaredMarkerErrors[j];
+            }
+        }
+        if (reportMarkerLocations) {
+            ikSolver.computeCurrentMarkerLocations(markerLocations);
+            for (int j = 0; j < nm; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    frames.markerLocations(row, 3 * j + k) =
+                            markerLocations[j][k];
+                }
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+InverseKinematicsFrames OpenSim::solveInverseKinematicsFrames(
+        const Model& model, const MarkersReference& markersReference,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        double constraintWeight, double accuracy, int startIndex,
+        int finalIndex, int numThreads, bool reportErrors,
+        bool reportMarkerLocations, bool useLevenbergMarquardt,
+        int maxAssemblyAttempts) {
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+            "Expected the number of threads to be at least 1, but got {}.",
+            numThreads);
+    const int numFrames = finalIndex - startIndex + 1;
+    OPENSIM_THROW_IF(startIndex < 0 || numFrames < 1 ||
+                    finalIndex >= (int)markersReference.getNumFrames(),
+            Exception, "Invalid frame range {}-{}.", startIndex, finalIndex);
+    numThreads = std::min(numThreads, numFrames);
+
+    // Size the results from a solver on the model itself, which uses the
+    // same markers (in the same order) as the solvers of the threads.
+    int nq, nm;
+    {
+        Model modelCopy(model);
+        modelCopy.setUseVisualizer(false);
+        const SimTK::State& s = modelCopy.initSystem();
+        InverseKinematicsSolver ikSolver(modelCopy,
+                std::make_shared<MarkersReference>(markersReference),
+                coordinateReferences, constraintWeight);
+        nq = s.getNQ();
+        nm = ikSolver.getNumMarkersInUse();
+    }
+
+    InverseKinematicsFrames frames;
+    frames.q.resize(numFrames, nq);
+    frames.squaredMarkerErrors.resize(numFrames, reportErrors ? nm : 0);
+    frames.markerLocations.resize(
+            numFrames, reportMarkerLocations ? 3 * nm : 0);
+
+    // Each thread writes to its own rows of the results.
+    std::vector<std::future<void>> futures;
+    const int stride = numFrames / numThreads;
+    for (int thread = 0; thread < numThreads; ++thread) {
+        const int begin = startIndex + thread * stride;
+        const int end = (thread == numThreads - 1) ? finalIndex + 1
+                                                   : begin + stride;
+        futures.push_back(std::async(std::launch::async, solveBlock, model,
+                markersReference, coordinateReferences, constraintWeight,
+                accuracy, useLevenbergMarquardt, maxAssemblyAttempts, begin,
+                end, startIndex, thread, numThreads, std::ref(frames)));
+    }
+
+    // Wait for all threads to finish before rethrowing the first failure.
+    std::exception_ptr failure;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!failure) { failure = std::current_exception(); }
+        }
+    }
+    if (failure) { std::rethrow_exception(failure); }
+
+    return frames;
+}
+
+bool OpenSim::assembleInverseKinematicsFrame(
+        InverseKinematicsSolver& ikSolver, SimTK::State& s, int maxAttempts) {
+    for (int i = 0; i < maxAttempts; ++i) {
+        try {
+            ikSolver.assemble(s);
+            return true;
+        }
+        catch (std::exception const&) {
+            try {
+                ikSolver.track(s);
+                return true;
+            }
+            catch (std::exception const&) {
+                log_error("Assembly failed... "
+                    "retrying with new initial conditions.");
+            }
+        }
+    }
+    return false;
+}
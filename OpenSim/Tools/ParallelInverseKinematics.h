@@ -0,0 +1,102 @@
+#ifndef OPENSIM_PARALLEL_INVERSE_KINEMATICS_H_
+#define OPENSIM_PARALLEL_INVERSE_KINEMATICS_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  ParallelInverseKinematics.h                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2024 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+
+#include <OpenSim/Simulation/CoordinateReference.h>
+#include <OpenSim/Simulation/MarkersReference.h>
+
+namespace OpenSim {
+
+class InverseKinematicsSolver;
+class Model;
+
+/**
+ * Inverse kinematics solution of a range of consecutive marker frames, as
+ * computed by solveInverseKinematicsFrames(). Row i of each matrix belongs
+ * to frame startIndex + i of the marker table.
+ */
+struct InverseKinematicsFrames {
+    /** Generalized coordinates (the state's q) of each frame. */
+    SimTK::Matrix q;
+    /** Squared error of each marker in use (see
+    InverseKinematicsSolver::computeCurrentSquaredMarkerErrors()); empty
+    unless requested. */
+    SimTK::Matrix squaredMarkerErrors;
+    /** Location in Ground of each marker in use (x, y and z columns for each
+    marker); empty unless requested. */
+    SimTK::Matrix markerLocations;
+};
+
+/**
+ * Solve inverse kinematics for frames startIndex to finalIndex (inclusive) of
+ * the marker table in markersReference, using numThreads threads.
+ *
+ * The frames are split into numThreads contiguous blocks of about the same
+ * length. Each block is solved by its own thread on its own copy of the model
+ * (which must have been finalized) and its own InverseKinematicsSolver. The
+ * first frame of a block is assembled from the model's default state, and the
+ * following frames are tracked from the previous one, as
+ * InverseKinematicsTool does for the whole trial. The solution therefore
+ * matches the sequential one to within the accuracy of the solver, except
+ * where the problem has several local minima that the cold start of a block
+ * could select.
+ *
+ * If useLevenbergMarquardt is true, the frames after the first frame of each
+ * block are tracked with the Levenberg-Marquardt solver of
+ * InverseKinematicsSolver (see
+ * InverseKinematicsSolver::setUseLevenbergMarquardt()).
+ *
+ * The markers in use, and their order, are the same as those of an
+ * InverseKinematicsSolver constructed on the model with the same references.
+ *
+ * If maxAssemblyAttempts is positive, the first frame of each block is
+ * assembled with assembleInverseKinematicsFrame() instead of a single call
+ * to InverseKinematicsSolver::assemble(), so that a block starts as the
+ * sequential solution of a tool that retries its assembly would.
+ *
+ * @throws Exception If the assembly or tracking of any frame fails.
+ */
+OSIMTOOLS_API InverseKinematicsFrames solveInverseKinematicsFrames(
+        const Model& model, const MarkersReference& markersReference,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        double constraintWeight, double accuracy, int startIndex,
+        int finalIndex, int numThreads, bool reportErrors = false,
+        bool reportMarkerLocations = false,
+        bool useLevenbergMarquardt = false, int maxAssemblyAttempts = 0);
+
+/**
+ * Assemble the state s to the references of ikSolver at the time of s. If the
+ * assembly fails, the frame is tracked from the state left by the failed
+ * assembly instead, and both are retried, up to maxAttempts times in total.
+ * Each failed attempt is logged as an error.
+ *
+ * @returns true if an assembly or tracking succeeded.
+ */
+OSIMTOOLS_API bool assembleInverseKinematicsFrame(
+        InverseKinematicsSolver& ikSolver, SimTK::State& s, int maxAttempts);
+
+} // namespace OpenSim
+
+#endif // OPENSIM_PARALLEL_INVERSE_KINEMATICS_H_
@@ -30,6 +30,7 @@
 #include "AnalyzeTool.h"
 
 #include "InverseKinematicsTool.h"
+#include "ParallelInverseKinematics.h"
 #include "InverseDynamicsTool.h"
 #include "GenericModelMaker.h"
 #include "TrackingTask.h"